@@ -14,14 +14,21 @@
 
 #include "CombineStlFiles.h"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
+#include <memory>
+#include <tuple>
 
 #include <QtCore/QDir>
+#include <QtCore/QFile>
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/InputPathFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -29,9 +36,65 @@
 #include "SIMPLib/Filtering/FilterFactory.hpp"
 #include "SIMPLib/Filtering/FilterManager.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/ParallelHelpers.hpp"
+
+namespace
+{
+constexpr qint64 k_StlHeaderSize = 80;
+constexpr qint64 k_StlCountSize = 4;
+constexpr qint64 k_StlRecordSize = 50;
+
+/**
+ * @brief One input STL file. Binary files are memory mapped and their triangle records are parsed in
+ * place; any other file is read through the ReadStlFile filter and its geometry kept until the
+ * triangles have been copied out.
+ */
+struct StlSource
+{
+  std::unique_ptr<QFile> file;
+  const uchar* records = nullptr;
+  TriangleGeom::Pointer geom;
+  DoubleArrayType::Pointer normals;
+  MeshIndexType numTris = 0;
+};
+
+/**
+ * @brief A vertex to be welded: the owning file, the coordinate bit patterns and the vertex index.
+ * Vertices are only welded to vertices of the same file, matching what ReadStlFile does per file.
+ */
+struct WeldEntry
+{
+  uint32_t source;
+  std::array<uint32_t, 3> key;
+  MeshIndexType vertex;
+
+  bool operator<(const WeldEntry& other) const
+  {
+    return std::tie(source, key, vertex) < std::tie(other.source, other.key, other.vertex);
+  }
+
+  bool sameLocation(const WeldEntry& other) const
+  {
+    return source == other.source && key == other.key;
+  }
+};
+
+// -----------------------------------------------------------------------------
+inline uint32_t packCoordinate(float value)
+{
+  if(value == 0.0f)
+  {
+    value = 0.0f;
+  }
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -73,6 +136,7 @@ void CombineStlFiles::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Face Attribute Matrix", FaceAttributeMatrixName, TriangleDataContainerName, FilterParameter::Category::CreatedArray, CombineStlFiles));
   parameters.push_back(
       SIMPL_NEW_DA_WITH_LINKED_AM_FP("Face Normals", FaceNormalsArrayName, TriangleDataContainerName, FaceAttributeMatrixName, FilterParameter::Category::CreatedArray, CombineStlFiles));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Weld Duplicate Vertices", WeldVertices, FilterParameter::Category::Parameter, CombineStlFiles));
   setFilterParameters(parameters);
 }
 
@@ -84,15 +148,6 @@ void CombineStlFiles::dataCheck()
   clearErrorCode();
   clearWarningCode();
 
-  FilterManager* fm = FilterManager::Instance();
-  IFilterFactory::Pointer factory = fm->getFactoryFromClassName("ReadStlFile");
-  if(!factory)
-  {
-    QString ss = QObject::tr("Combine STL Files requires the Read STL File filter to be loaded");
-    setErrorCondition(-1, ss);
-    return;
-  }
-
   QFileInfo fi(getStlFilesPath());
 
   if(getStlFilesPath().isEmpty())
@@ -164,19 +219,70 @@ void CombineStlFiles::execute()
     return;
   }
 
+  // Map every binary STL file and record its triangle count; anything that is not a well formed
+  // binary STL is handed to the ReadStlFile filter
+  std::vector<StlSource> sources(m_FileList.size());
   DataContainerArray::Pointer dca = DataContainerArray::New();
+  AbstractFilter::Pointer reader;
 
-  FilterManager* fm = FilterManager::Instance();
-  IFilterFactory::Pointer factory = fm->getFactoryFromClassName("ReadStlFile");
-  AbstractFilter::Pointer reader = factory->create();
-  reader->setDataContainerArray(dca);
-
-  for(auto&& file : m_FileList)
+  for(int32_t i = 0; i < m_FileList.size(); i++)
   {
+    const QFileInfo& fileInfo = m_FileList[i];
+    StlSource& source = sources[i];
+    source.file = std::make_unique<QFile>(fileInfo.canonicalFilePath());
+    if(!source.file->open(QIODevice::ReadOnly))
+    {
+      QString ss = QObject::tr("Error opening STL file: %1").arg(fileInfo.fileName());
+      setErrorCondition(-389, ss);
+      return;
+    }
+
+    qint64 fileSize = source.file->size();
+    uint32_t numTris = 0;
+    bool isBinary = false;
+    if(fileSize >= k_StlHeaderSize + k_StlCountSize && source.file->seek(k_StlHeaderSize) &&
+       source.file->read(reinterpret_cast<char*>(&numTris), k_StlCountSize) == k_StlCountSize)
+    {
+      isBinary = (fileSize == k_StlHeaderSize + k_StlCountSize + k_StlRecordSize * static_cast<qint64>(numTris));
+    }
+
+    if(isBinary)
+    {
+      source.numTris = numTris;
+      if(numTris > 0)
+      {
+        uchar* mapped = source.file->map(0, fileSize);
+        if(nullptr == mapped)
+        {
+          QString ss = QObject::tr("Error memory mapping STL file: %1").arg(fileInfo.fileName());
+          setErrorCondition(-390, ss);
+          return;
+        }
+        source.records = mapped + k_StlHeaderSize + k_StlCountSize;
+      }
+      continue;
+    }
+
+    source.file.reset();
+    if(!reader)
+    {
+      FilterManager* fm = FilterManager::Instance();
+      IFilterFactory::Pointer factory = fm->getFactoryFromClassName("ReadStlFile");
+      if(!factory)
+      {
+        QString ss = QObject::tr("Combine STL Files requires the Read STL File filter to be loaded to read ASCII STL file: %1").arg(fileInfo.fileName());
+        setErrorCondition(-1, ss);
+        return;
+      }
+      reader = factory->create();
+      reader->setDataContainerArray(dca);
+    }
+
+    QString dcName = QString::number(i);
     QVariant var;
-    var.setValue(file.canonicalFilePath());
+    var.setValue(fileInfo.canonicalFilePath());
     reader->setProperty("StlFilePath", var);
-    var.setValue(file.baseName());
+    var.setValue(dcName);
     reader->setProperty("SurfaceMeshDataContainerName", var);
     var.setValue(SIMPL::Defaults::FaceAttributeMatrixName);
     reader->setProperty("FaceAttributeMatrixName", var);
@@ -185,32 +291,24 @@ void CombineStlFiles::execute()
     reader->execute();
     if(reader->getErrorCode() < 0)
     {
-      QString ss = QObject::tr("Error reading STL file: %1").arg(file.fileName());
+      QString ss = QObject::tr("Error reading STL file: %1").arg(fileInfo.fileName());
       setErrorCondition(reader->getErrorCode(), ss);
       return;
     }
-  }
-
-  std::list<TriangleGeom::Pointer> stlGeoms;
-  std::list<DoubleArrayType::Pointer> faceNormals;
-  auto containers = dca->getDataContainers();
-  DataArrayPath path;
 
-  for(auto&& container : containers)
-  {
-    stlGeoms.push_back(container->getGeometryAs<TriangleGeom>());
-    path.update(container->getName(), SIMPL::Defaults::FaceAttributeMatrixName, "");
-    faceNormals.push_back(container->getAttributeMatrix(path)->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshFaceNormals));
+    DataContainer::Pointer dc = dca->getDataContainer(dcName);
+    source.geom = dc->getGeometryAs<TriangleGeom>();
+    source.normals = dc->getAttributeMatrix(SIMPL::Defaults::FaceAttributeMatrixName)->getAttributeArrayAs<DoubleArrayType>(SIMPL::FaceData::SurfaceMeshFaceNormals);
+    source.numTris = source.geom->getNumberOfTris();
   }
 
-  int64_t totalTriangles = 0;
-  int64_t totalVertices = 0;
-
-  for(auto&& geom : stlGeoms)
+  std::vector<MeshIndexType> triOffsets(sources.size() + 1, 0);
+  for(size_t i = 0; i < sources.size(); i++)
   {
-    totalTriangles += geom->getNumberOfTris();
-    totalVertices += geom->getNumberOfVertices();
+    triOffsets[i + 1] = triOffsets[i] + sources[i].numTris;
   }
+  MeshIndexType totalTriangles = triOffsets.back();
+  MeshIndexType totalVertices = 3 * totalTriangles;
 
   TriangleGeom::Pointer combined = getDataContainerArray()->getDataContainer(m_TriangleDataContainerName)->getGeometryAs<TriangleGeom>();
   AttributeMatrix::Pointer faceAttrmat = getDataContainerArray()->getAttributeMatrix(DataArrayPath(m_TriangleDataContainerName, m_FaceAttributeMatrixName, ""));
@@ -218,36 +316,118 @@ void CombineStlFiles::execute()
   combined->resizeTriList(totalTriangles);
   combined->resizeVertexList(totalVertices);
   faceAttrmat->resizeAttributeArrays(tDims);
-  MeshIndexType triOffset = 0;
-  MeshIndexType vertOffset = 0;
-  MeshIndexType triCounter = 0;
   MeshIndexType* tris = combined->getTriPointer(0);
   float* verts = combined->getVertexPointer(0);
+  m_FaceNormals = faceAttrmat->getAttributeArrayAs<DoubleArrayType>(m_FaceNormalsArrayName)->getPointer(0);
 
-  for(auto&& geom : stlGeoms)
-  {
-    MeshIndexType* curTris = geom->getTriPointer(0);
-    for(MeshIndexType t = 0; t < geom->getNumberOfTris(); t++)
+  notifyStatusMessage(QObject::tr("Reading %1 Triangles from %2 Files...").arg(totalTriangles).arg(sources.size()));
+
+  // Parse all triangles as one flat range so that work is split across files and within large
+  // files alike; every triangle gets its own three vertices until they are welded
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, totalTriangles);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    size_t sourceIdx = std::upper_bound(triOffsets.begin(), triOffsets.end(), range.min()) - triOffsets.begin() - 1;
+    for(MeshIndexType t = range.min(); t < range.max(); t++)
     {
-      curTris[3 * t + 0] += triCounter;
-      curTris[3 * t + 1] += triCounter;
-      curTris[3 * t + 2] += triCounter;
+      while(t >= triOffsets[sourceIdx + 1])
+      {
+        sourceIdx++;
+      }
+      const StlSource& source = sources[sourceIdx];
+      MeshIndexType localTri = t - triOffsets[sourceIdx];
+
+      if(nullptr != source.records)
+      {
+        float record[12] = {0.0f};
+        std::memcpy(record, source.records + k_StlRecordSize * localTri, sizeof(record));
+        for(size_t d = 0; d < 3; d++)
+        {
+          m_FaceNormals[3 * t + d] = static_cast<double>(record[d]);
+        }
+        std::copy_n(record + 3, 9, verts + 9 * t);
+      }
+      else
+      {
+        const MeshIndexType* srcTri = source.geom->getTriPointer(localTri);
+        for(size_t j = 0; j < 3; j++)
+        {
+          std::copy_n(source.geom->getVertexPointer(srcTri[j]), 3, verts + 9 * t + 3 * j);
+        }
+        std::copy_n(source.normals->getPointer(3 * localTri), 3, m_FaceNormals + 3 * t);
+      }
+
+      for(size_t j = 0; j < 3; j++)
+      {
+        tris[3 * t + j] = 3 * t + j;
+      }
     }
-    triCounter += geom->getNumberOfVertices();
-    float* curVerts = geom->getVertexPointer(0);
-    std::memcpy(tris + triOffset, curTris, geom->getNumberOfTris() * 3 * sizeof(MeshIndexType));
-    std::memcpy(verts + vertOffset, curVerts, geom->getNumberOfVertices() * 3 * sizeof(float));
-    triOffset += geom->getNumberOfTris() * 3;
-    vertOffset += geom->getNumberOfVertices() * 3;
-  }
+  });
 
-  size_t faceNormalsOffset = 0;
-  m_FaceNormals = faceAttrmat->getAttributeArrayAs<DoubleArrayType>(m_FaceNormalsArrayName)->getPointer(0);
+  sources.clear();
+  dca.reset();
 
-  for(auto&& dataArray : faceNormals)
+  if(getCancel())
   {
-    std::memcpy(m_FaceNormals + faceNormalsOffset, dataArray->getPointer(0), dataArray->getSize() * sizeof(double));
-    faceNormalsOffset += dataArray->getSize();
+    return;
+  }
+
+  if(m_WeldVertices && totalVertices > 0)
+  {
+    notifyStatusMessage("Welding Duplicate Vertices...");
+
+    std::vector<WeldEntry> entries(totalVertices);
+    dataAlg.setRange(0, totalTriangles);
+    dataAlg.execute([&](const SIMPLRange& range) {
+      uint32_t sourceIdx = static_cast<uint32_t>(std::upper_bound(triOffsets.begin(), triOffsets.end(), range.min()) - triOffsets.begin() - 1);
+      for(MeshIndexType t = range.min(); t < range.max(); t++)
+      {
+        while(t >= triOffsets[sourceIdx + 1])
+        {
+          sourceIdx++;
+        }
+        for(MeshIndexType v = 3 * t; v < 3 * t + 3; v++)
+        {
+          entries[v] = {sourceIdx, {packCoordinate(verts[3 * v + 0]), packCoordinate(verts[3 * v + 1]), packCoordinate(verts[3 * v + 2])}, v};
+        }
+      }
+    });
+    ParallelHelpers::sort(entries.begin(), entries.end());
+
+    // Each run of equal (file, coordinate) keys becomes one vertex
+    std::vector<MeshIndexType> weldIds(totalVertices, 0);
+    dataAlg.setRange(0, totalVertices);
+    dataAlg.execute([&](const SIMPLRange& range) {
+      for(MeshIndexType k = range.min(); k < range.max(); k++)
+      {
+        weldIds[k] = (k == 0 || !entries[k].sameLocation(entries[k - 1])) ? 1 : 0;
+      }
+    });
+    MeshIndexType numWelded = ParallelHelpers::exclusiveScan(weldIds);
+
+    std::vector<float> weldedVerts(3 * numWelded);
+    dataAlg.execute([&](const SIMPLRange& range) {
+      for(MeshIndexType k = range.min(); k < range.max(); k++)
+      {
+        bool head = (k == 0 || !entries[k].sameLocation(entries[k - 1]));
+        MeshIndexType weldId = head ? weldIds[k] : weldIds[k] - 1;
+        MeshIndexType vertex = entries[k].vertex;
+        if(head)
+        {
+          std::copy_n(verts + 3 * vertex, 3, weldedVerts.data() + 3 * weldId);
+        }
+        tris[vertex] = weldId;
+      }
+    });
+
+    entries.clear();
+    entries.shrink_to_fit();
+    weldIds.clear();
+    weldIds.shrink_to_fit();
+
+    combined->resizeVertexList(numWelded);
+    verts = combined->getVertexPointer(0);
+    std::memcpy(verts, weldedVerts.data(), weldedVerts.size() * sizeof(float));
   }
 
   notifyStatusMessage("Complete");
@@ -401,3 +581,15 @@ QString CombineStlFiles::getFaceNormalsArrayName() const
 {
   return m_FaceNormalsArrayName;
 }
+
+// -----------------------------------------------------------------------------
+void CombineStlFiles::setWeldVertices(bool value)
+{
+  m_WeldVertices = value;
+}
+
+// -----------------------------------------------------------------------------
+bool CombineStlFiles::getWeldVertices() const
+{
+  return m_WeldVertices;
+}
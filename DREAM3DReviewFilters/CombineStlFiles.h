@@ -95,6 +95,17 @@ public:
   QString getFaceNormalsArrayName() const;
   Q_PROPERTY(QString FaceNormalsArrayName READ getFaceNormalsArrayName WRITE setFaceNormalsArrayName)
 
+  /**
+   * @brief Setter property for WeldVertices
+   */
+  void setWeldVertices(bool value);
+  /**
+   * @brief Getter property for WeldVertices
+   * @return Value of WeldVertices
+   */
+  bool getWeldVertices() const;
+  Q_PROPERTY(bool WeldVertices READ getWeldVertices WRITE setWeldVertices)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -171,6 +182,7 @@ private:
   QString m_TriangleDataContainerName = {};
   QString m_FaceAttributeMatrixName = {};
   QString m_FaceNormalsArrayName = {};
+  bool m_WeldVertices = true;
 
   QFileInfoList m_FileList;
 
@@ -1,9 +1,11 @@
 #include "DelaunayTriangulation.h"
 
-#include <array>
-#include <unordered_map>
+#include <algorithm>
+#include <atomic>
+#include <numeric>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -18,101 +20,21 @@
 #include "SIMPLib/Geometry/IGeometryGrid.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Geometry/VertexGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewFilters/util/Delaunay2D.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
-namespace
-{
-template <class T>
-inline void hashCombine(size_t& seed, const T& obj)
-{
-  std::hash<T> hasher;
-  seed ^= hasher(obj) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-}
-
-using Vertex = std::array<float, 3>;
-
-struct VertexHasher
-{
-  size_t operator()(const Vertex& vert) const
-  {
-    size_t hash = std::hash<float>()(vert[0]);
-    hashCombine(hash, vert[1]);
-    hashCombine(hash, vert[2]);
-    return hash;
-  }
-};
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#endif
 
-using VertexMap = std::unordered_map<Vertex, int64_t, VertexHasher>;
-
-void mergeTriangleGeometries(std::vector<TriangleGeom::Pointer>& triangles)
+namespace
 {
-  int64_t numVerts = 0;
-  int64_t numTris = 0;
-  for(auto&& triangle : triangles)
-  {
-    numVerts += triangle->getNumberOfVertices();
-    numTris += triangle->getNumberOfTris();
-  }
-
-  VertexMap vertexMap;
-  std::vector<Vertex> mergedVerts;
-  mergedVerts.reserve(numVerts);
-  int64_t vertCounter = 0;
-  for(auto&& triangle : triangles)
-  {
-    float* vertPtr = triangle->getVertexPointer(0);
-    int64_t localNumVerts = triangle->getNumberOfVertices();
-    for(int64_t i = 0; i < localNumVerts; i++)
-    {
-      Vertex vert = {vertPtr[3 * i + 0], vertPtr[3 * i + 1], vertPtr[3 * i + 2]};
-      auto iter = vertexMap.find(vert);
-      if(iter == vertexMap.end())
-      {
-        mergedVerts.push_back(vert);
-        vertexMap[vert] = vertCounter;
-        vertCounter++;
-      }
-    }
-  }
-
-  SharedVertexList::Pointer mergedVertices = TriangleGeom::CreateSharedVertexList(mergedVerts.size());
-  float* mergedVertsPtr = mergedVertices->getPointer(0);
-  for(size_t i = 0; i < mergedVertices->getNumberOfTuples(); i++)
-  {
-    mergedVertsPtr[3 * i + 0] = mergedVerts[i][0];
-    mergedVertsPtr[3 * i + 1] = mergedVerts[i][1];
-    mergedVertsPtr[3 * i + 2] = mergedVerts[i][2];
-  }
-
-  mergedVerts.clear();
-  mergedVerts.shrink_to_fit();
-
-  TriangleGeom::Pointer mergedTriangle = TriangleGeom::CreateGeometry(numTris, mergedVertices, SIMPL::Geometry::TriangleGeometry);
-  size_t* mergedTrisPtr = mergedTriangle->getTriPointer(0);
-  size_t triCounter = 0;
-  for(auto&& triangle : triangles)
-  {
-    size_t localNumTris = triangle->getNumberOfTris();
-    float vertCoords[9];
-    for(size_t i = 0; i < localNumTris; i++)
-    {
-      triangle->getVertCoordsAtTri(i, vertCoords, vertCoords + 3, vertCoords + 6);
-      for(size_t j = 0; j < 3; j++)
-      {
-        Vertex vert = {vertCoords[3 * j + 0], vertCoords[3 * j + 1], vertCoords[3 * j + 2]};
-        mergedTrisPtr[3 * triCounter + j] = vertexMap[vert];
-      }
-      triCounter++;
-    }
-  }
-
-  triangles.resize(1);
-  triangles[0] = mergedTriangle;
-}
-}; // namespace
+constexpr size_t k_MinTriangulationVertices = 3;
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -296,9 +218,12 @@ void DelaunayTriangulation::execute()
   }
 
   float* vertPtr = vertices->getPointer(0);
-  std::vector<TriMesh::VertexCoordList> vertexLists;
   int32_t numFeatures = std::numeric_limits<int32_t>::min();
 
+  // Group the vertex ids by feature with a counting sort; without features every vertex is in group 0
+  std::vector<size_t> groupOffsets;
+  std::vector<int64_t> groupVertexIds;
+
   if(m_TriangulateByFeature)
   {
     for(size_t i = 0; i < m_FeatureIdsPtr.lock()->getNumberOfTuples(); i++)
@@ -316,52 +241,136 @@ void DelaunayTriangulation::execute()
       return;
     }
 
-    vertexLists.resize(numFeatures + 1);
-    for(size_t i = 0; i < m_FeatureIdsPtr.lock()->getNumberOfTuples(); i++)
+    groupOffsets.assign(numFeatures + 2, 0);
+    for(int64_t i = 0; i < numVerts; i++)
     {
-      vertexLists[m_FeatureIds[i]].push_back({vertPtr[3 * i + 0], vertPtr[3 * i + 1], vertPtr[3 * i + 2]});
+      if(m_FeatureIds[i] >= 0)
+      {
+        groupOffsets[m_FeatureIds[i] + 1]++;
+      }
+    }
+    std::partial_sum(groupOffsets.begin(), groupOffsets.end(), groupOffsets.begin());
+    groupVertexIds.resize(groupOffsets.back());
+    std::vector<size_t> fill(groupOffsets.begin(), groupOffsets.end() - 1);
+    for(int64_t i = 0; i < numVerts; i++)
+    {
+      if(m_FeatureIds[i] >= 0)
+      {
+        groupVertexIds[fill[m_FeatureIds[i]]++] = i;
+      }
     }
   }
   else
   {
-    vertexLists.resize(1);
-    for(size_t i = 0; i < vertices->getNumberOfTuples(); i++)
+    groupOffsets = {0, static_cast<size_t>(numVerts)};
+    groupVertexIds.resize(numVerts);
+    std::iota(groupVertexIds.begin(), groupVertexIds.end(), 0);
+  }
+
+  const size_t numGroups = groupOffsets.size() - 1;
+  std::vector<size_t> order;
+  for(size_t g = 0; g < numGroups; g++)
+  {
+    if(groupOffsets[g + 1] - groupOffsets[g] >= k_MinTriangulationVertices)
     {
-      vertexLists[0].push_back({vertPtr[3 * i + 0], vertPtr[3 * i + 1], vertPtr[3 * i + 2]});
+      order.push_back(g);
     }
   }
+  // Largest groups first, so no large triangulation starts last and leaves the other threads idle
+  std::stable_sort(order.begin(), order.end(), [&groupOffsets](size_t a, size_t b) { return groupOffsets[a + 1] - groupOffsets[a] > groupOffsets[b + 1] - groupOffsets[b]; });
 
-  size_t counter = 1;
-  std::vector<TriangleGeom::Pointer> triangles(vertexLists.size());
+  QString title = QObject::tr("Performing Delaunay Triangulation");
+  if(m_TriangulateByFeature)
+  {
+    notifyStatusMessage(title + QObject::tr(" || %1 Features").arg(order.size()));
+  }
+
+  // Triangulations of distinct features are independent; each worker repeatedly takes the largest
+  // remaining feature. Only a single triangulation reports its own progress.
+  std::vector<TriangleGeom::Pointer> triangles(numGroups);
+  std::atomic<size_t> nextGroup(0);
+  auto triangulateGroups = [&]() {
+    for(size_t k = nextGroup++; k < order.size() && !getCancel(); k = nextGroup++)
+    {
+      size_t g = order[k];
+      TriMesh::VertexCoordList vertexList(groupOffsets[g + 1] - groupOffsets[g]);
+      for(size_t v = 0; v < vertexList.size(); v++)
+      {
+        int64_t vertId = groupVertexIds[groupOffsets[g] + v];
+        vertexList.setCoordinates(v, vertPtr[3 * vertId + 0], vertPtr[3 * vertId + 1], vertPtr[3 * vertId + 2]);
+      }
+      Delaunay2D::Pointer delaunay = Delaunay2D::New(std::move(vertexList), m_Offset, m_Tolerance, 0.0, order.size() == 1 ? this : nullptr);
+      delaunay->setMessagePrefix(getHumanLabel());
+      delaunay->setMessageTitle(title);
+      triangles[g] = delaunay->triangulate();
+    }
+  };
 
-  for(auto&& vertexList : vertexLists)
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(order.size() > 1)
   {
-    Delaunay2D::Pointer delaunay = Delaunay2D::New(vertexList, m_Offset, m_Tolerance, 0.0, this);
-    delaunay->setMessagePrefix(getHumanLabel());
-    QString ss = QObject::tr("Performing Delaunay Triangulation");
-    if(m_TriangulateByFeature)
+    tbb::task_group taskGroup;
+    int32_t numWorkers = std::min<int32_t>(tbb::this_task_arena::max_concurrency(), static_cast<int32_t>(order.size()));
+    for(int32_t w = 0; w < numWorkers; w++)
     {
-      QString featureProgress = QObject::tr(" || Feature %1 of %2").arg(counter).arg(numFeatures);
-      ss += featureProgress;
+      taskGroup.run(triangulateGroups);
     }
-    delaunay->setMessageTitle(ss);
-    triangles[counter - 1] = delaunay->triangulate();
-    counter++;
+    taskGroup.wait();
   }
+  else
+  {
+    triangulateGroups();
+  }
+#else
+  triangulateGroups();
+#endif
 
-  DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(m_TriangleDataContainerName);
+  if(getCancel())
+  {
+    return;
+  }
 
-  if(m_TriangulateByFeature)
+  // Merge: the output keeps the input vertices in their original order, and the triangles of each
+  // group are written at a prefix-sum offset with their local vertex ids mapped back to input ids
+  std::vector<size_t> triOffsets(numGroups + 1, 0);
+  for(size_t g = 0; g < numGroups; g++)
   {
-    mergeTriangleGeometries(triangles);
+    triOffsets[g + 1] = triOffsets[g] + (triangles[g] ? triangles[g]->getNumberOfTris() : 0);
   }
 
-  dc->setGeometry(triangles[0]);
-  AttributeMatrix::Pointer attrMat = getDataContainerArray()->getDataContainer(m_TriangleDataContainerName)->getAttributeMatrix(m_VertexAttributeMatrixName);
-  std::vector<size_t> tDims(1, triangles[0]->getNumberOfVertices());
+  SharedVertexList::Pointer mergedVertices = TriangleGeom::CreateSharedVertexList(numVerts);
+  std::copy(vertPtr, vertPtr + 3 * numVerts, mergedVertices->getPointer(0));
+  TriangleGeom::Pointer mergedTriangle = TriangleGeom::CreateGeometry(triOffsets.back(), mergedVertices, SIMPL::Geometry::TriangleGeometry);
+  MeshIndexType* mergedTrisPtr = mergedTriangle->getTriPointer(0);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numGroups);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t g = range.min(); g < range.max(); g++)
+    {
+      if(!triangles[g])
+      {
+        continue;
+      }
+      const MeshIndexType* localTris = triangles[g]->getTriPointer(0);
+      const int64_t* localToGlobal = groupVertexIds.data() + groupOffsets[g];
+      const size_t numLocalTris = triangles[g]->getNumberOfTris();
+      MeshIndexType* destination = mergedTrisPtr + 3 * triOffsets[g];
+      for(size_t i = 0; i < 3 * numLocalTris; i++)
+      {
+        destination[i] = static_cast<MeshIndexType>(localToGlobal[localTris[i]]);
+      }
+      triangles[g].reset();
+    }
+  });
+
+  DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(m_TriangleDataContainerName);
+  dc->setGeometry(mergedTriangle);
+  AttributeMatrix::Pointer attrMat = dc->getAttributeMatrix(m_VertexAttributeMatrixName);
+  std::vector<size_t> tDims(1, mergedTriangle->getNumberOfVertices());
   attrMat->resizeAttributeArrays(tDims);
-  attrMat = getDataContainerArray()->getDataContainer(m_TriangleDataContainerName)->getAttributeMatrix(m_FaceAttributeMatrixName);
-  tDims[0] = triangles[0]->getNumberOfTris();
+  attrMat = dc->getAttributeMatrix(m_FaceAttributeMatrixName);
+  tDims[0] = mergedTriangle->getNumberOfTris();
   attrMat->resizeAttributeArrays(tDims);
 }
 
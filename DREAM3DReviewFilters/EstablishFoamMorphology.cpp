@@ -13,7 +13,9 @@
 
 #include "EstablishFoamMorphology.h"
 
+#include <array>
 #include <fstream>
+#include <vector>
 
 #include <QtCore/QDir>
 #include <QtCore/QFile>
@@ -50,6 +52,7 @@
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/EuclideanDistanceMap.hpp"
 
 // SIMPLib.h MUST be included before this or the guard will block the include but not its uses below.
 // This is consistent with previous behavior, only earlier parallelization split the includes between
@@ -64,222 +67,6 @@
 // clang-format on
 #endif
 
-/**
- * @brief The FindEuclideanMap2 class implements a threaded algorithm that computes the Euclidean distance map
- * for each point in the supplied volume
- */
-class FindEuclideanMap2
-{
-  DataContainer::Pointer m;
-  int32_t* m_FeatureIds;
-  int32_t* m_NearestNeighbors;
-  float* m_GBEuclideanDistances;
-  float* m_TJEuclideanDistances;
-  float* m_QPEuclideanDistances;
-  int32_t mapType;
-
-public:
-  FindEuclideanMap2(const DataContainer::Pointer& datacontainer, int32_t* fIds, int32_t* nearNeighs, float* gbDists, float* tjDists, float* qpDists, int32_t type)
-  : m(datacontainer)
-  , m_FeatureIds(fIds)
-  , m_NearestNeighbors(nearNeighs)
-  , m_GBEuclideanDistances(gbDists)
-  , m_TJEuclideanDistances(tjDists)
-  , m_QPEuclideanDistances(qpDists)
-  , mapType(type)
-  {
-  }
-
-  ~FindEuclideanMap2() = default;
-
-  void operator()() const
-  {
-    size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
-    double euclideanDistance = 0.0f;
-    size_t count = 1;
-    size_t changed = 1;
-    size_t neighpoint = 0;
-    int64_t nearestneighbor;
-    std::array<int64_t, 6> neighbors = {0, 0, 0, 0, 0, 0};
-    int64_t xpoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getXPoints());
-    int64_t ypoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getYPoints());
-    int64_t zpoints = static_cast<int64_t>(m->getGeometryAs<ImageGeom>()->getZPoints());
-
-    ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
-    FloatVec3Type spacing = imageGeom->getSpacing();
-
-    double resx = static_cast<double>(spacing[0]);
-    double resy = static_cast<double>(spacing[1]);
-    double resz = static_cast<double>(spacing[2]);
-
-    neighbors[0] = -xpoints * ypoints;
-    neighbors[1] = -xpoints;
-    neighbors[2] = -1;
-    neighbors[3] = 1;
-    neighbors[4] = xpoints;
-    neighbors[5] = xpoints * ypoints;
-
-    // Use a std::vector to get an auto cleaned up array thus not needing the 'delete' keyword later on.
-    std::vector<int64_t> voxNN(totalPoints, 0);
-    int64_t* voxel_NearestNeighbor = &(voxNN.front());
-    std::vector<double> voxEDist(totalPoints, 0.0);
-    double* voxel_EuclideanDistance = &(voxEDist.front());
-
-    euclideanDistance = 0;
-    for(size_t a = 0; a < totalPoints; ++a)
-    {
-      if(m_NearestNeighbors[a * 3 + mapType] >= 0)
-      {
-        voxel_NearestNeighbor[a] = a;
-      } // if voxel is boundary voxel, then want to use itself as nearest boundary voxel
-      else
-      {
-        voxel_NearestNeighbor[a] = -1;
-      }
-      if(mapType == 0)
-      {
-        voxel_EuclideanDistance[a] = static_cast<double>(m_GBEuclideanDistances[a]);
-      }
-      else if(mapType == 1)
-      {
-        voxel_EuclideanDistance[a] = static_cast<double>(m_TJEuclideanDistances[a]);
-      }
-      else if(mapType == 2)
-      {
-        voxel_EuclideanDistance[a] = static_cast<double>(m_QPEuclideanDistances[a]);
-      }
-    }
-    count = 1;
-    changed = 1;
-    int64_t i = 0;
-    int64_t zBlock = xpoints * ypoints;
-    int64_t zStride = 0;
-    int64_t yStride = 0;
-    std::array<char, 6> mask = {0, 0, 0, 0, 0, 0};
-    while(count > 0 && changed > 0)
-    {
-      count = 0;
-      changed = 0;
-      euclideanDistance++;
-
-      for(int64_t z = 0; z < zpoints; ++z)
-      {
-        zStride = z * zBlock;
-        mask[0] = mask[5] = 1;
-        if(z == 0)
-        {
-          mask[0] = 0;
-        }
-        if(z == zpoints - 1)
-        {
-          mask[5] = 0;
-        }
-
-        for(int64_t y = 0; y < ypoints; ++y)
-        {
-          yStride = y * xpoints;
-          mask[1] = mask[4] = 1;
-          if(y == 0)
-          {
-            mask[1] = 0;
-          }
-          if(y == ypoints - 1)
-          {
-            mask[4] = 0;
-          }
-
-          for(int64_t x = 0; x < xpoints; ++x)
-          {
-            mask[2] = mask[3] = 1;
-            if(x == 0)
-            {
-              mask[2] = 0;
-            }
-            if(x == xpoints - 1)
-            {
-              mask[3] = 0;
-            }
-
-            i = zStride + yStride + x;
-            if(voxel_NearestNeighbor[i] == -1 && m_FeatureIds[i] > 0)
-            {
-              count++;
-              for(int32_t j = 0; j < 6; j++)
-              {
-                neighpoint = i + neighbors[j];
-                if(mask[j] == 1)
-                {
-                  if(voxel_EuclideanDistance[neighpoint] != -1.0)
-                  {
-                    voxel_NearestNeighbor[i] = voxel_NearestNeighbor[neighpoint];
-                  }
-                }
-              }
-            }
-          }
-        }
-      }
-      for(size_t j = 0; j < totalPoints; ++j)
-      {
-        if(voxel_NearestNeighbor[j] != -1 && voxel_EuclideanDistance[j] == -1.0 && m_FeatureIds[j] > 0)
-        {
-          changed++;
-          voxel_EuclideanDistance[j] = euclideanDistance;
-        }
-      }
-    }
-    double x1 = 0.0;
-    double x2 = 0.0;
-    double y1 = 0.0;
-    double y2 = 0.0;
-    double z1 = 0.0;
-    double z2 = 0.0;
-    double dist = 0.0;
-    double oneOverzBlock = 1.0 / double(zBlock);
-    double oneOverxpoints = 1.0 / double(xpoints);
-    for(int64_t m = 0; m < zpoints; m++)
-    {
-      zStride = m * zBlock;
-      for(int64_t n = 0; n < ypoints; n++)
-      {
-        yStride = n * xpoints;
-        for(int64_t p = 0; p < xpoints; p++)
-        {
-          x1 = double(p) * resx;
-          y1 = double(n) * resy;
-          z1 = double(m) * resz;
-          nearestneighbor = voxel_NearestNeighbor[zStride + yStride + p];
-          if(nearestneighbor >= 0)
-          {
-            x2 = resx * double(nearestneighbor % xpoints);                           // find_xcoord(nearestneighbor);
-            y2 = resy * double(int64_t(nearestneighbor * oneOverxpoints) % ypoints); // find_ycoord(nearestneighbor);
-            z2 = resz * floor(nearestneighbor * oneOverzBlock);                      // find_zcoord(nearestneighbor);
-            dist = ((x1 - x2) * (x1 - x2)) + ((y1 - y2) * (y1 - y2)) + ((z1 - z2) * (z1 - z2));
-            dist = sqrt(dist);
-            voxel_EuclideanDistance[zStride + yStride + p] = dist;
-          }
-        }
-      }
-    }
-    for(size_t a = 0; a < totalPoints; ++a)
-    {
-      m_NearestNeighbors[a * 3 + mapType] = voxel_NearestNeighbor[a];
-      if(mapType == 0)
-      {
-        m_GBEuclideanDistances[a] = static_cast<float>(voxel_EuclideanDistance[a]);
-      }
-      else if(mapType == 1)
-      {
-        m_TJEuclideanDistances[a] = static_cast<float>(voxel_EuclideanDistance[a]);
-      }
-      else if(mapType == 2)
-      {
-        m_QPEuclideanDistances[a] = static_cast<float>(voxel_EuclideanDistance[a]);
-      }
-    }
-  }
-};
-
 /**
  * @brief The FoamAssignVoxelsGapsImpl class implements a threaded algorithm that assigns all the voxels
  * in the volume to a unique Feature.
@@ -478,8 +265,6 @@ void EstablishFoamMorphology::initialize()
   m_PlaneList.clear();
   m_EllipFuncList.clear();
 
-  m_PointsToAdd.clear();
-  m_PointsToRemove.clear();
   m_Seed = QDateTime::currentMSecsSinceEpoch();
   m_FirstFoamFeature = 1;
   m_SizeX = m_SizeY = m_SizeZ = m_TotalVol = 0.0f;
@@ -819,14 +604,6 @@ void EstablishFoamMorphology::dataCheck()
     m_QPEuclideanDistances = m_QPEuclideanDistancesPtr.lock()->getPointer(0);
   } /* Now assign the raw pointer to data from the DataArray<T> object */
 
-  cDims[0] = 3;
-  tempPath.update(getOutputCellAttributeMatrixPath().getDataContainerName(), getOutputCellAttributeMatrixPath().getAttributeMatrixName(), m_NearestNeighborsArrayName);
-  m_NearestNeighborsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>>(this, tempPath, 0, cDims);
-  if(nullptr != m_NearestNeighborsPtr.lock())
-  {
-    m_NearestNeighbors = m_NearestNeighborsPtr.lock()->getPointer(0);
-  } /* Now assign the raw pointer to data from the DataArray<T> object */
-
   // Feature Data
   tempPath.update(getOutputCellAttributeMatrixPath().getDataContainerName(), getOutputCellFeatureAttributeMatrixName(), m_FeaturePhasesArrayName);
   m_FeaturePhasesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>>(this, tempPath, 0, cDims);
@@ -924,13 +701,6 @@ void EstablishFoamMorphology::preflight()
     setInPreflight(false);
     return;
   }
-  AttributeMatrix::Pointer cellAttrMat = dc->getAttributeMatrix(getOutputCellAttributeMatrixPath().getAttributeMatrixName());
-  if(cellAttrMat == nullptr)
-  {
-    setInPreflight(false);
-    return;
-  }
-  cellAttrMat->removeAttributeArray(m_NearestNeighborsArrayName);
   featureAttrMat->removeAttributeArray(m_AxisEulerAnglesArrayName);
   featureAttrMat->removeAttributeArray(m_AxisLengthsArrayName);
   featureAttrMat->removeAttributeArray(m_CentroidsArrayName);
@@ -1050,9 +820,7 @@ void EstablishFoamMorphology::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
-  AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(getOutputCellAttributeMatrixPath().getAttributeMatrixName());
   AttributeMatrix::Pointer featureAttrMat = m->getAttributeMatrix(getOutputCellFeatureAttributeMatrixName());
-  cellAttrMat->removeAttributeArray(m_NearestNeighborsArrayName);
   featureAttrMat->removeAttributeArray(m_AxisEulerAnglesArrayName);
   featureAttrMat->removeAttributeArray(m_AxisLengthsArrayName);
   featureAttrMat->removeAttributeArray(m_CentroidsArrayName);
@@ -1167,9 +935,9 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
   Int32ArrayType::Pointer exclusionOwnersPtr = Int32ArrayType::CreateArray(m_TotalPackingPoints, cDim, "_INTERNAL_USE_ONLY_PackPrecipitateFeatures::exclusions_owners", true);
   exclusionOwnersPtr->initializeWithValue(0);
 
-  // This is the set that we are going to keep updated with the points that are not in an exclusion zone
-  std::map<size_t, size_t> availablePoints;
-  std::map<size_t, size_t> availablePointsInv;
+  // The first m_AvailablePointsCount entries hold the points that are not in an exclusion zone. The set is rebuilt
+  // before each packing pass and is not updated while features are moved
+  std::vector<size_t> availablePointsInv(m_TotalPackingPoints, 0);
 
   // Get a pointer to the Feature Owners that was just initialized in the initialize_packinggrid() method
   int32_t* featureOwners = featureOwnersPtr->getPointer(0);
@@ -1182,14 +950,10 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
   {
     if(exclusionOwners[i] == 0)
     {
-      availablePoints[i] = m_AvailablePointsCount;
       availablePointsInv[m_AvailablePointsCount] = i;
       m_AvailablePointsCount++;
     }
   }
-  // and clear the pointsToRemove and pointsToAdd vectors from the initial packing
-  m_PointsToRemove.clear();
-  m_PointsToAdd.clear();
 
   // initialize the sim and goal size distributions for the precipitate phases
   m_FeatureSizeDist.resize(m_PrecipitatePhases.size());
@@ -1459,16 +1223,11 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
   {
     if(exclusionOwners[i] == 0)
     {
-      availablePoints[i] = m_AvailablePointsCount;
       availablePointsInv[m_AvailablePointsCount] = i;
       m_AvailablePointsCount++;
     }
   }
 
-  // and clear the pointsToRemove and pointsToAdd vectors from the initial packing
-  m_PointsToRemove.clear();
-  m_PointsToAdd.clear();
-
   millis = QDateTime::currentMSecsSinceEpoch();
   startMillis = millis;
   bool good = false;
@@ -1502,7 +1261,7 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
 
     if(writeErrorFile && iteration % 25 == 0)
     {
-      outFile << iteration << " " << m_FillingError << "  " << availablePoints.size() << "  " << m_AvailablePointsCount << " " << totalFeatures << " " << acceptedmoves << "\n";
+      outFile << iteration << " " << m_FillingError << "  " << m_AvailablePointsCount << " " << totalFeatures << " " << acceptedmoves << "\n";
     }
 
     // JUMP - this option moves one feature to a random spot in the volume
@@ -1536,7 +1295,7 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
       }
       m_Seed++;
 
-      if(!availablePoints.empty())
+      if(m_AvailablePointsCount > 0)
       {
         key = static_cast<size_t>(rg.genrand_res53() * (m_AvailablePointsCount - 1));
         featureOwnersIdx = availablePointsInv[key];
@@ -1566,8 +1325,6 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
         m_FillingError = check_fillingerror(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
         move_feature(randomfeature, oldxc, oldyc, oldzc);
         m_FillingError = check_fillingerror(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-        m_PointsToRemove.clear();
-        m_PointsToAdd.clear();
       }
     }
 
@@ -1641,8 +1398,6 @@ void EstablishFoamMorphology::place_features(const Int32ArrayType::Pointer& feat
         m_FillingError = check_fillingerror(-1000, static_cast<int>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
         move_feature(randomfeature, oldxc, oldyc, oldzc);
         m_FillingError = check_fillingerror(static_cast<int>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-        m_PointsToRemove.clear();
-        m_PointsToAdd.clear();
       }
     }
   }
@@ -2278,10 +2033,6 @@ float EstablishFoamMorphology::check_fillingerror(int32_t gadd, int32_t gremove,
         int32_t currentFeatureOwner = featureOwners[featureOwnersIdx];
         if(efl[i] > 0.1f)
         {
-          if(exclusionOwners[featureOwnersIdx] == 0)
-          {
-            m_PointsToRemove.push_back(featureOwnersIdx);
-          }
           exclusionOwners[featureOwnersIdx]++;
         }
         m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
@@ -2300,10 +2051,6 @@ float EstablishFoamMorphology::check_fillingerror(int32_t gadd, int32_t gremove,
           }
           if(efl[i] > 0.1f)
           {
-            if(exclusionOwners[featureOwnersIdx] == 0)
-            {
-              m_PointsToRemove.push_back(featureOwnersIdx);
-            }
             exclusionOwners[featureOwnersIdx]++;
           }
           m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
@@ -2361,10 +2108,6 @@ float EstablishFoamMorphology::check_fillingerror(int32_t gadd, int32_t gremove,
         if(efl[i] > 0.1f)
         {
           exclusionOwners[featureOwnersIdx]--;
-          if(exclusionOwners[featureOwnersIdx] == 0)
-          {
-            m_PointsToAdd.push_back(featureOwnersIdx);
-          }
         }
         m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
         //        fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
@@ -2379,10 +2122,6 @@ float EstablishFoamMorphology::check_fillingerror(int32_t gadd, int32_t gremove,
           if(efl[i] > 0.1f)
           {
             exclusionOwners[featureOwnersIdx]--;
-            if(exclusionOwners[featureOwnersIdx] == 0)
-            {
-              m_PointsToAdd.push_back(featureOwnersIdx);
-            }
           }
           m_FillingError = static_cast<float>(m_FillingError + ((k1 * currentFeatureOwner + k2)));
           //          fillingerror = fillingerror + (multiplier * (k1 * currentFeatureOwner  + k2));
@@ -2395,41 +2134,6 @@ float EstablishFoamMorphology::check_fillingerror(int32_t gadd, int32_t gremove,
   return m_FillingError;
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void EstablishFoamMorphology::update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv)
-{
-  size_t removeSize = m_PointsToRemove.size();
-  size_t addSize = m_PointsToAdd.size();
-  size_t featureOwnersIdx = 0;
-  size_t key = 0;
-  size_t val = 0;
-  for(size_t i = 0; i < removeSize; i++)
-  {
-    featureOwnersIdx = m_PointsToRemove[i];
-    key = availablePoints[featureOwnersIdx];
-    //  availablePoints.erase(featureOwnersIdx);
-    val = availablePointsInv[m_AvailablePointsCount - 1];
-    //  availablePointsInv.erase(availablePointsCount-1);
-    if(key < m_AvailablePointsCount - 1)
-    {
-      availablePointsInv[key] = val;
-      availablePoints[val] = key;
-    }
-    m_AvailablePointsCount--;
-  }
-  for(size_t i = 0; i < addSize; i++)
-  {
-    featureOwnersIdx = m_PointsToAdd[i];
-    availablePoints[featureOwnersIdx] = m_AvailablePointsCount;
-    availablePointsInv[m_AvailablePointsCount] = featureOwnersIdx;
-    m_AvailablePointsCount++;
-  }
-  m_PointsToRemove.clear();
-  m_PointsToAdd.clear();
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -3249,10 +2953,6 @@ void EstablishFoamMorphology::find_euclidean_dist_map()
   }
 
   find_euclideandistmap();
-
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
-  AttributeMatrix::Pointer attrMat = m->getAttributeMatrix(getOutputCellAttributeMatrixPath().getAttributeMatrixName());
-  attrMat->removeAttributeArray(m_NearestNeighborsArrayName);
 }
 
 // -----------------------------------------------------------------------------
@@ -3279,7 +2979,8 @@ void EstablishFoamMorphology::find_euclideandistmap()
   int32_t feature = 0;
   std::vector<int32_t> coordination;
 
-  SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
+  ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
+  SizeVec3Type udims = image->getDimensions();
 
   std::array<int64_t, 3> dims = {
       static_cast<int64_t>(udims[0]),
@@ -3352,21 +3053,18 @@ void EstablishFoamMorphology::find_euclideandistmap()
           }
         }
       }
-      if(coordination.empty())
-      {
-        m_NearestNeighbors[a * 3 + 0] = -1, m_NearestNeighbors[a * 3 + 1] = -1, m_NearestNeighbors[a * 3 + 2] = -1;
-      }
+      // Boundary voxels seed the map of every coordination they reach
       if(coordination.size() >= 1)
       {
-        m_GBEuclideanDistances[a] = 0.0f, m_NearestNeighbors[a * 3 + 0] = coordination[0], m_NearestNeighbors[a * 3 + 1] = -1, m_NearestNeighbors[a * 3 + 2] = -1;
+        m_GBEuclideanDistances[a] = 0.0f;
       }
       if(coordination.size() >= 2)
       {
-        m_TJEuclideanDistances[a] = 0.0f, m_NearestNeighbors[a * 3 + 0] = coordination[0], m_NearestNeighbors[a * 3 + 1] = coordination[0], m_NearestNeighbors[a * 3 + 2] = -1;
+        m_TJEuclideanDistances[a] = 0.0f;
       }
       if(coordination.size() > 2)
       {
-        m_QPEuclideanDistances[a] = 0.0f, m_NearestNeighbors[a * 3 + 0] = coordination[0], m_NearestNeighbors[a * 3 + 1] = coordination[0], m_NearestNeighbors[a * 3 + 2] = coordination[0];
+        m_QPEuclideanDistances[a] = 0.0f;
       }
       coordination.resize(0);
     }
@@ -3378,23 +3076,18 @@ void EstablishFoamMorphology::find_euclideandistmap()
   if(doParallel)
   {
     tbb::task_group* g = new tbb::task_group;
-    g->run(FindEuclideanMap2(m, m_FeatureIds, m_NearestNeighbors, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, 0));
-    g->run(FindEuclideanMap2(m, m_FeatureIds, m_NearestNeighbors, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, 1));
-    g->run(FindEuclideanMap2(m, m_FeatureIds, m_NearestNeighbors, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, 2));
+    g->run(EuclideanDistanceMap(image, m_FeatureIds, m_GBEuclideanDistances));
+    g->run(EuclideanDistanceMap(image, m_FeatureIds, m_TJEuclideanDistances));
+    g->run(EuclideanDistanceMap(image, m_FeatureIds, m_QPEuclideanDistances));
     g->wait();
     delete g;
   }
   else
 #endif
   {
-    for(int32_t i = 0; i < 3; i++)
-    {
-      if((i == 0) || (i == 1) || (i == 2))
-      {
-        FindEuclideanMap2 f(m, m_FeatureIds, m_NearestNeighbors, m_GBEuclideanDistances, m_TJEuclideanDistances, m_QPEuclideanDistances, i);
-        f();
-      }
-    }
+    EuclideanDistanceMap(image, m_FeatureIds, m_GBEuclideanDistances)();
+    EuclideanDistanceMap(image, m_FeatureIds, m_TJEuclideanDistances)();
+    EuclideanDistanceMap(image, m_FeatureIds, m_QPEuclideanDistances)();
   }
 }
 
@@ -513,13 +513,6 @@ protected:
    */
   float check_fillingerror(int32_t gadd, int32_t gremove, const Int32ArrayType::Pointer& featureOwnersPtr, const Int32ArrayType::Pointer& exclusionOwnersPtr);
 
-  /**
-   * @brief update_availablepoints Updates the maps used to associate packing points with an "available" state
-   * @param availablePoints Map between Feature owners and number of available points
-   * @param availablePointsInv Inverse associations for the availablePoints map
-   */
-  void update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv);
-
   /**
    * @brief assign_voxels Assigns Feature Id values to voxels within the packing grid
    */
@@ -618,8 +611,6 @@ private:
   float* m_GBEuclideanDistances = nullptr;
   std::weak_ptr<DataArray<float>> m_TJEuclideanDistancesPtr;
   float* m_TJEuclideanDistances = nullptr;
-  std::weak_ptr<DataArray<int32_t>> m_NearestNeighborsPtr;
-  int32_t* m_NearestNeighbors = nullptr;
   std::weak_ptr<DataArray<int32_t>> m_FeaturePhasesPtr;
   int32_t* m_FeaturePhases = nullptr;
   std::weak_ptr<DataArray<int32_t>> m_NeighborhoodsPtr;
@@ -647,7 +638,6 @@ private:
   // These arrays are temporary and are removed from the Feature Attribute Matrix after completion
   QString m_FeaturePhasesArrayName = SIMPL::FeatureData::Phases;
   QString m_NeighborhoodsArrayName = SIMPL::FeatureData::Neighborhoods;
-  QString m_NearestNeighborsArrayName = SIMPL::CellData::NearestNeighbors;
   QString m_CentroidsArrayName = SIMPL::FeatureData::Centroids;
   QString m_VolumesArrayName = SIMPL::FeatureData::Volumes;
   QString m_AxisLengthsArrayName = SIMPL::FeatureData::AxisLengths;
@@ -680,9 +670,6 @@ private:
   std::vector<std::vector<int64_t>> m_PlaneList;
   std::vector<std::vector<float>> m_EllipFuncList;
 
-  std::vector<size_t> m_PointsToAdd;
-  std::vector<size_t> m_PointsToRemove;
-
   uint64_t m_Seed;
 
   int32_t m_FirstFoamFeature;
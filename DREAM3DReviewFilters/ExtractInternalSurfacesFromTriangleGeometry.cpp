@@ -34,13 +34,14 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ExtractInternalSurfacesFromTriangleGeometry.h"
 
-#include <array>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
-#include <unordered_map>
 
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/Common/TemplateHelpers.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
@@ -50,9 +51,11 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/ParallelHelpers.hpp"
 
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -194,21 +197,11 @@ void ExtractInternalSurfacesFromTriangleGeometry::dataCheck()
   }
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-template <class T>
-inline void hashCombine(size_t& seed, const T& obj)
-{
-  std::hash<T> hasher;
-  seed ^= hasher(obj) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 template <typename T>
-void copyData(IDataArray::Pointer inDataPtr, IDataArray::Pointer outDataPtr, std::unordered_map<int64_t, int64_t>& elementMap)
+void copyData(IDataArray::Pointer inDataPtr, IDataArray::Pointer outDataPtr, const std::vector<MeshIndexType>& sourceIds)
 {
   typename DataArray<T>::Pointer inputDataPtr = std::dynamic_pointer_cast<DataArray<T>>(inDataPtr);
   T* inputData = static_cast<T*>(inputDataPtr->getPointer(0));
@@ -217,18 +210,15 @@ void copyData(IDataArray::Pointer inDataPtr, IDataArray::Pointer outDataPtr, std
 
   size_t nTuples = outDataPtr->getNumberOfTuples();
   size_t nComps = inDataPtr->getNumberOfComponents();
-  size_t tmpIndex = 0;
-  size_t ptrIndex = 0;
 
-  for(size_t i = 0; i < nTuples; i++)
-  {
-    for(size_t d = 0; d < nComps; d++)
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, nTuples);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      tmpIndex = nComps * i + d;
-      ptrIndex = nComps * elementMap[i] + d;
-      outputData[tmpIndex] = inputData[ptrIndex];
+      std::copy_n(inputData + nComps * sourceIds[i], nComps, outputData + nComps * i);
     }
-  }
+  });
 }
 
 // -----------------------------------------------------------------------------
@@ -249,124 +239,88 @@ void ExtractInternalSurfacesFromTriangleGeometry::execute()
   MeshIndexType numVerts = tris->getNumberOfVertices();
   MeshIndexType numTris = tris->getNumberOfTris();
 
-  typedef std::array<float, 3> Vertex;
+  auto isInternalNode = [this](MeshIndexType vert) { return m_NodeTypes[vert] == 2 || m_NodeTypes[vert] == 3 || m_NodeTypes[vert] == 4; };
 
-  struct ArrayHasher
-  {
-    size_t operator()(const Vertex& vert) const
+  // Flag the internal triangles and the vertices they use; the flags are turned into dense
+  // old -> new index arrays by a prefix scan
+  std::vector<MeshIndexType> newTriIds(numTris, 0);
+  std::vector<std::atomic<uint8_t>> vertUsed(numVerts);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numVerts);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      size_t hash = std::hash<float>()(vert[0]);
-      hashCombine(hash, vert[1]);
-      hashCombine(hash, vert[2]);
-      return hash;
+      vertUsed[i].store(0, std::memory_order_relaxed);
     }
-  };
+  });
 
-  typedef std::array<int64_t, 3> Triangle;
-  typedef std::unordered_map<Vertex, int64_t, ArrayHasher> VertexMap;
-  VertexMap vertexMap;
-  std::unordered_map<int64_t, int64_t> internalVertexMap;
-  std::unordered_map<int64_t, int64_t> internalTriMap;
-  std::vector<Vertex> tmpVerts;
-  tmpVerts.reserve(numVerts);
-  std::vector<Triangle> tmpTris;
-  tmpTris.reserve(numTris);
-  std::vector<int8_t> tmpNodeTypes;
-  tmpNodeTypes.reserve(numVerts);
-  int64_t vertCounter = 0;
-  int64_t triCounter = 0;
-  int64_t tmpVert0 = 0;
-  int64_t tmpVert1 = 0;
-  int64_t tmpVert2 = 0;
-
-  int64_t progIncrement = numTris / 100;
-  int64_t prog = 1;
-  int64_t progressInt = 0;
-  int64_t counter = 0;
-
-  for(MeshIndexType i = 0; i < numTris; i++)
-  {
-    if(getCancel())
-    {
-      return;
-    }
-    if((m_NodeTypes[triangles[3 * i + 0]] == 2 || m_NodeTypes[triangles[3 * i + 0]] == 3 || m_NodeTypes[triangles[3 * i + 0]] == 4) &&
-       (m_NodeTypes[triangles[3 * i + 1]] == 2 || m_NodeTypes[triangles[3 * i + 1]] == 3 || m_NodeTypes[triangles[3 * i + 1]] == 4) &&
-       (m_NodeTypes[triangles[3 * i + 2]] == 2 || m_NodeTypes[triangles[3 * i + 2]] == 3 || m_NodeTypes[triangles[3 * i + 2]] == 4))
+  dataAlg.setRange(0, numTris);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      Vertex tmpCoords1 = {{vertices[3 * triangles[3 * i + 0] + 0], vertices[3 * triangles[3 * i + 0] + 1], vertices[3 * triangles[3 * i + 0] + 2]}};
-      Vertex tmpCoords2 = {{vertices[3 * triangles[3 * i + 1] + 0], vertices[3 * triangles[3 * i + 1] + 1], vertices[3 * triangles[3 * i + 1] + 2]}};
-      Vertex tmpCoords3 = {{vertices[3 * triangles[3 * i + 2] + 0], vertices[3 * triangles[3 * i + 2] + 1], vertices[3 * triangles[3 * i + 2] + 2]}};
-
-      auto iter = vertexMap.find(tmpCoords1);
-      if(iter == vertexMap.end())
+      if(getCancel())
       {
-        tmpVerts.push_back(tmpCoords1);
-        tmpNodeTypes.push_back(m_NodeTypes[triangles[3 * i + 0]]);
-        vertexMap[tmpCoords1] = vertCounter;
-        tmpVert0 = vertCounter;
-        internalVertexMap[tmpVert0] = triangles[3 * i + 0];
-        vertCounter++;
+        return;
       }
-      else
+      if(isInternalNode(triangles[3 * i + 0]) && isInternalNode(triangles[3 * i + 1]) && isInternalNode(triangles[3 * i + 2]))
       {
-        tmpVert0 = vertexMap[tmpCoords1];
+        newTriIds[i] = 1;
+        for(size_t j = 0; j < 3; j++)
+        {
+          vertUsed[triangles[3 * i + j]].store(1, std::memory_order_relaxed);
+        }
       }
+    }
+  });
 
-      iter = vertexMap.find(tmpCoords2);
-      if(iter == vertexMap.end())
-      {
-        tmpVerts.push_back(tmpCoords2);
-        tmpNodeTypes.push_back(m_NodeTypes[triangles[3 * i + 1]]);
-        vertexMap[tmpCoords2] = vertCounter;
-        tmpVert1 = vertCounter;
-        internalVertexMap[tmpVert1] = triangles[3 * i + 1];
-        vertCounter++;
-      }
-      else
-      {
-        tmpVert1 = vertexMap[tmpCoords2];
-      }
+  if(getCancel())
+  {
+    return;
+  }
 
-      iter = vertexMap.find(tmpCoords3);
-      if(iter == vertexMap.end())
-      {
-        tmpVerts.push_back(tmpCoords3);
-        tmpNodeTypes.push_back(m_NodeTypes[triangles[3 * i + 2]]);
-        vertexMap[tmpCoords3] = vertCounter;
-        tmpVert2 = vertCounter;
-        internalVertexMap[tmpVert2] = triangles[3 * i + 2];
-        vertCounter++;
-      }
-      else
+  std::vector<MeshIndexType> newVertIds(numVerts, 0);
+  dataAlg.setRange(0, numVerts);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      newVertIds[i] = vertUsed[i].load(std::memory_order_relaxed);
+    }
+  });
+
+  MeshIndexType numInternalTris = ParallelHelpers::exclusiveScan(newTriIds);
+  MeshIndexType numInternalVerts = ParallelHelpers::exclusiveScan(newVertIds);
+
+  // Invert the maps so every output element knows which input element it gathers from
+  std::vector<MeshIndexType> sourceVertIds(numInternalVerts, 0);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      if(vertUsed[i].load(std::memory_order_relaxed) != 0)
       {
-        tmpVert2 = vertexMap[tmpCoords3];
+        sourceVertIds[newVertIds[i]] = i;
       }
-
-      Triangle tmpTri = {{tmpVert0, tmpVert1, tmpVert2}};
-      tmpTris.push_back(tmpTri);
-      internalTriMap[triCounter] = i;
-      triCounter++;
     }
+  });
 
-    if(counter > prog)
+  std::vector<MeshIndexType> sourceTriIds(numInternalTris, 0);
+  dataAlg.setRange(0, numTris);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      progressInt = static_cast<int64_t>((static_cast<float>(counter) / numTris) * 100.0f);
-      QString ss = QObject::tr("Checking Triangle %1 of %2 || %3% Completed").arg(counter).arg(numTris).arg(progressInt);
-      notifyStatusMessage(ss);
-      prog = prog + progIncrement;
+      bool last = (i + 1 == numTris);
+      MeshIndexType next = last ? numInternalTris : newTriIds[i + 1];
+      if(next != newTriIds[i])
+      {
+        sourceTriIds[newTriIds[i]] = i;
+      }
     }
-    counter++;
-  }
+  });
 
   QString ss = QObject::tr("Finished Checking Triangles || Updating Array Information...");
   notifyStatusMessage(ss);
 
-  tmpVerts.shrink_to_fit();
-  tmpTris.shrink_to_fit();
-
-  std::vector<size_t> vertDims(1, tmpVerts.size());
-  std::vector<size_t> triDims(1, tmpTris.size());
+  std::vector<size_t> vertDims(1, numInternalVerts);
+  std::vector<size_t> triDims(1, numInternalTris);
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_TriangleDataContainerName);
   DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(m_InternalTrianglesName);
 
@@ -376,28 +330,11 @@ void ExtractInternalSurfacesFromTriangleGeometry::execute()
     if(getErrorCode() >= 0)
     {
       AttributeMatrix::Type tempAttrMatType = tmpAttrMat->getType();
-      if(tempAttrMatType == AttributeMatrix::Type::Vertex)
-      {
-        tmpAttrMat->resizeAttributeArrays(vertDims);
-        QList<QString> srcDataArrays = tmpAttrMat->getAttributeArrayNames();
-        AttributeMatrix::Pointer srcAttrMat = m->getAttributeMatrix(tmpAttrMat->getName());
-        assert(srcAttrMat);
-
-        for(auto&& data_array : srcDataArrays)
-        {
-          IDataArray::Pointer src = srcAttrMat->getAttributeArray(data_array);
-          IDataArray::Pointer dest = tmpAttrMat->getAttributeArray(data_array);
-
-          assert(src);
-          assert(dest);
-          assert(src->getNumberOfComponents() == dest->getNumberOfComponents());
-
-          EXECUTE_FUNCTION_TEMPLATE(this, copyData, src, src, dest, internalVertexMap)
-        }
-      }
-      else if(tempAttrMatType == AttributeMatrix::Type::Face)
+      if(tempAttrMatType == AttributeMatrix::Type::Vertex || tempAttrMatType == AttributeMatrix::Type::Face)
       {
-        tmpAttrMat->resizeAttributeArrays(triDims);
+        bool isVertex = (tempAttrMatType == AttributeMatrix::Type::Vertex);
+        tmpAttrMat->resizeAttributeArrays(isVertex ? vertDims : triDims);
+        const std::vector<MeshIndexType>& sourceIds = isVertex ? sourceVertIds : sourceTriIds;
         QList<QString> srcDataArrays = tmpAttrMat->getAttributeArrayNames();
         AttributeMatrix::Pointer srcAttrMat = m->getAttributeMatrix(tmpAttrMat->getName());
         assert(srcAttrMat);
@@ -411,33 +348,36 @@ void ExtractInternalSurfacesFromTriangleGeometry::execute()
           assert(dest);
           assert(src->getNumberOfComponents() == dest->getNumberOfComponents());
 
-          EXECUTE_FUNCTION_TEMPLATE(this, copyData, src, src, dest, internalTriMap)
+          EXECUTE_FUNCTION_TEMPLATE(this, copyData, src, src, dest, sourceIds)
         }
       }
     }
   }
 
   TriangleGeom::Pointer internalTris = getDataContainerArray()->getDataContainer(m_InternalTrianglesName)->getGeometryAs<TriangleGeom>();
-  internalTris->resizeVertexList(tmpVerts.size());
-  internalTris->resizeTriList(tmpTris.size());
+  internalTris->resizeVertexList(numInternalVerts);
+  internalTris->resizeTriList(numInternalTris);
   float* internalVertices = internalTris->getVertexPointer(0);
   MeshIndexType* internalTriangles = internalTris->getTriPointer(0);
-  MeshIndexType numInternalTris = internalTris->getNumberOfTris();
-  MeshIndexType numInternalVerts = internalTris->getNumberOfVertices();
 
-  for(MeshIndexType i = 0; i < numInternalVerts; i++)
-  {
-    internalVertices[3 * i + 0] = tmpVerts[i][0];
-    internalVertices[3 * i + 1] = tmpVerts[i][1];
-    internalVertices[3 * i + 2] = tmpVerts[i][2];
-  }
+  dataAlg.setRange(0, numInternalVerts);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      std::copy_n(vertices + 3 * sourceVertIds[i], 3, internalVertices + 3 * i);
+    }
+  });
 
-  for(MeshIndexType i = 0; i < numInternalTris; i++)
-  {
-    internalTriangles[3 * i + 0] = tmpTris[i][0];
-    internalTriangles[3 * i + 1] = tmpTris[i][1];
-    internalTriangles[3 * i + 2] = tmpTris[i][2];
-  }
+  dataAlg.setRange(0, numInternalTris);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      for(size_t j = 0; j < 3; j++)
+      {
+        internalTriangles[3 * i + j] = newVertIds[triangles[3 * sourceTriIds[i] + j]];
+      }
+    }
+  });
 }
 
 // -----------------------------------------------------------------------------
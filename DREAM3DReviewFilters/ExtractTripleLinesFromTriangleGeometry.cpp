@@ -14,14 +14,19 @@
 
 #include "ExtractTripleLinesFromTriangleGeometry.h"
 
+#include <algorithm>
 #include <array>
-#include <random>
-#include <unordered_map>
-#include <unordered_set>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <tuple>
 
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -30,48 +35,168 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/EdgeGeom.h"
-#include "SIMPLib/Geometry/GeometryHelpers.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
-#include "SIMPLib/Geometry/VertexGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/ParallelHelpers.hpp"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/UnionFind.hpp"
 
 namespace
 {
-template <class T>
-inline void hashCombine(size_t& seed, const T& obj)
+constexpr MeshIndexType k_NumCorners = 8;
+constexpr size_t k_SplineDegree = 4;
+constexpr uint64_t k_InvalidEdgeKey = std::numeric_limits<uint64_t>::max();
+
+/**
+ * @brief Returns the bit pattern of a coordinate for use in a weld key. Negative zero is folded onto
+ * positive zero so that the two weld together, as they compare equal as floats.
+ */
+inline uint32_t packCoordinate(float value)
 {
-  std::hash<T> hasher;
-  seed ^= hasher(obj) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  if(value == 0.0f)
+  {
+    value = 0.0f;
+  }
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
 }
 
-using Vertex = std::array<float, 3>;
-using Edge = std::array<MeshIndexType, 2>;
+// -----------------------------------------------------------------------------
+inline float unpackCoordinate(uint32_t bits)
+{
+  float value = 0.0f;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
 
-struct VertexHasher
+/**
+ * @brief A vertex to be welded. Corners take orders [0, 8) and mesh vertex i takes order i + 8, so
+ * after sorting the first entry of each run of equal keys is the vertex that owns the weld.
+ */
+struct WeldEntry
 {
-  size_t operator()(const Vertex& vert) const
+  std::array<uint32_t, 3> key;
+  MeshIndexType order;
+
+  bool operator<(const WeldEntry& other) const
   {
-    size_t hash = std::hash<float>()(vert[0]);
-    hashCombine(hash, vert[1]);
-    hashCombine(hash, vert[2]);
-    return hash;
+    return std::tie(key, order) < std::tie(other.key, other.order);
   }
 };
 
-struct EdgeHasher
+// -----------------------------------------------------------------------------
+inline bool isTripleLineNode(int8_t nodeType)
 {
-  size_t operator()(const Edge& edge) const
+  return nodeType == 3 || nodeType == 4 || nodeType == 13 || nodeType == 14;
+}
+
+// -----------------------------------------------------------------------------
+bool checkBoxEdge(const float minExtents[3], const float maxExtents[3], const float* coords)
+{
+  const bool onMin[3] = {coords[0] == minExtents[0], coords[1] == minExtents[1], coords[2] == minExtents[2]};
+  const bool onMax[3] = {coords[0] == maxExtents[0], coords[1] == maxExtents[1], coords[2] == maxExtents[2]};
+  const bool onFace[3] = {onMin[0] || onMax[0], onMin[1] || onMax[1], onMin[2] || onMax[2]};
+  return (onFace[0] && onFace[1]) || (onFace[0] && onFace[2]) || (onFace[1] && onFace[2]);
+}
+
+// -----------------------------------------------------------------------------
+void findExtents(const float* verts, MeshIndexType numVerts, float minExtents[3], float maxExtents[3])
+{
+  for(size_t d = 0; d < 3; d++)
   {
-    size_t hash = std::hash<MeshIndexType>()(edge[0]);
-    hashCombine(hash, edge[1]);
-    return hash;
+    minExtents[d] = std::numeric_limits<float>::max();
+    maxExtents[d] = std::numeric_limits<float>::lowest();
   }
-};
 
-using VertexMap = std::unordered_map<Vertex, MeshIndexType, VertexHasher>;
-using EdgeMap = std::unordered_map<Edge, MeshIndexType, EdgeHasher>;
+  std::mutex mutex;
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numVerts);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    float localMin[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    float localMax[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        localMin[d] = std::min(localMin[d], verts[3 * i + d]);
+        localMax[d] = std::max(localMax[d], verts[3 * i + d]);
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    for(size_t d = 0; d < 3; d++)
+    {
+      minExtents[d] = std::min(minExtents[d], localMin[d]);
+      maxExtents[d] = std::max(maxExtents[d], localMax[d]);
+    }
+  });
+}
+
+/**
+ * @brief The BsplineEvaluator class evaluates a clamped, uniform-knot B-spline through de Boor's
+ * algorithm. Knot and work buffers are kept between calls so a thread can smooth many triple lines
+ * without allocating per line.
+ */
+class BsplineEvaluator
+{
+public:
+  /**
+   * @brief evaluate Samples the curve defined by the xyz control points at each parameter in [0, 1]
+   * @param controlPoints
+   * @param params
+   * @param result Receives 3 * params.size() coordinates
+   */
+  void evaluate(const std::vector<float>& controlPoints, const std::vector<float>& params, std::vector<float>& result)
+  {
+    const size_t numPoints = controlPoints.size() / 3;
+    const size_t degree = std::min(k_SplineDegree, numPoints - 1);
+    const size_t numSpans = numPoints - degree;
+
+    m_Knots.assign(numPoints + degree + 1, 0.0f);
+    for(size_t i = 1; i < numSpans; i++)
+    {
+      m_Knots[degree + i] = static_cast<float>(i) / static_cast<float>(numSpans);
+    }
+    std::fill(m_Knots.begin() + numPoints, m_Knots.end(), 1.0f);
+
+    result.resize(3 * params.size());
+    m_Work.resize(3 * (degree + 1));
+    for(size_t p = 0; p < params.size(); p++)
+    {
+      const float t = params[p];
+      size_t s = degree;
+      while(s < numPoints - 1 && t >= m_Knots[s + 1])
+      {
+        s++;
+      }
+
+      for(size_t j = 0; j <= degree; j++)
+      {
+        std::copy_n(controlPoints.data() + 3 * (j + s - degree), 3, m_Work.data() + 3 * j);
+      }
+      for(size_t r = 1; r <= degree; r++)
+      {
+        for(size_t j = degree; j >= r; j--)
+        {
+          const float lo = m_Knots[j + s - degree];
+          const float hi = m_Knots[j + 1 + s - r];
+          const float alpha = (hi > lo) ? (t - lo) / (hi - lo) : 0.0f;
+          for(size_t d = 0; d < 3; d++)
+          {
+            m_Work[3 * j + d] = (1.0f - alpha) * m_Work[3 * (j - 1) + d] + alpha * m_Work[3 * j + d];
+          }
+        }
+      }
+      std::copy_n(m_Work.data() + 3 * degree, 3, result.data() + 3 * p);
+    }
+  }
+
+private:
+  std::vector<float> m_Knots;
+  std::vector<float> m_Work;
+};
 } // namespace
 
 // -----------------------------------------------------------------------------
@@ -102,7 +227,7 @@ void ExtractTripleLinesFromTriangleGeometry::initialize()
 void ExtractTripleLinesFromTriangleGeometry::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
-  parameters.push_back(SIMPL_NEW_BOOL_FP("Compactify Triple Lines", SmoothTripleLines, FilterParameter::Category::Parameter, ExtractTripleLinesFromTriangleGeometry));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Smooth Triple Lines", SmoothTripleLines, FilterParameter::Category::Parameter, ExtractTripleLinesFromTriangleGeometry));
   DataArraySelectionFilterParameter::RequirementType dasReq = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int8, 1, AttributeMatrix::Type::Vertex, IGeometry::Type::Triangle);
   parameters.push_back(SeparatorFilterParameter::Create("Vertex Data", FilterParameter::Category::RequiredArray));
   parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Node Types", NodeTypesArrayPath, FilterParameter::Category::RequiredArray, ExtractTripleLinesFromTriangleGeometry, dasReq));
@@ -165,65 +290,6 @@ void ExtractTripleLinesFromTriangleGeometry::dataCheck()
   m_TripleLineNodeTypesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<Int8ArrayType>(this, path, 0, cDims);
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-bool checkBoxEdge(float minExtents[3], float maxExtents[3], float* coords)
-{
-  if(coords[0] == minExtents[0] && coords[1] == minExtents[1])
-  {
-    return true;
-  }
-  if(coords[0] == minExtents[0] && coords[1] == maxExtents[1])
-  {
-    return true;
-  }
-  if(coords[0] == minExtents[0] && coords[2] == minExtents[2])
-  {
-    return true;
-  }
-  if(coords[0] == minExtents[0] && coords[2] == maxExtents[2])
-  {
-    return true;
-  }
-
-  if(coords[0] == maxExtents[0] && coords[1] == minExtents[1])
-  {
-    return true;
-  }
-  if(coords[0] == maxExtents[0] && coords[1] == maxExtents[1])
-  {
-    return true;
-  }
-  if(coords[0] == maxExtents[0] && coords[2] == minExtents[2])
-  {
-    return true;
-  }
-  if(coords[0] == maxExtents[0] && coords[2] == maxExtents[2])
-  {
-    return true;
-  }
-
-  if(coords[1] == minExtents[1] && coords[2] == minExtents[2])
-  {
-    return true;
-  }
-  if(coords[1] == minExtents[1] && coords[2] == maxExtents[2])
-  {
-    return true;
-  }
-  if(coords[1] == maxExtents[1] && coords[2] == minExtents[2])
-  {
-    return true;
-  }
-  if(coords[1] == maxExtents[1] && coords[2] == maxExtents[2])
-  {
-    return true;
-  }
-
-  return false;
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -241,589 +307,329 @@ void ExtractTripleLinesFromTriangleGeometry::extractTripleLines()
   SharedEdgeList::Pointer edges = triangle->getEdges();
   MeshIndexType numEdges = triangle->getNumberOfEdges();
   MeshIndexType* edgePtr = edges->getPointer(0);
-  ElementDynamicList::Pointer edgesContainingVert = ElementDynamicList::New();
-  GeometryHelpers::Connectivity::FindElementsContainingVert<uint16_t, MeshIndexType>(edges, edgesContainingVert, numVerts);
-
-  VertexMap vertexMap;
-  EdgeMap edgeMap;
-  std::vector<Vertex> tmpVerts;
-  std::vector<Edge> tmpEdges;
-  std::vector<int8_t> tmpNodeTypes;
-  tmpVerts.reserve(numVerts);
-  tmpEdges.reserve(numEdges);
-  tmpNodeTypes.reserve(numVerts);
-  MeshIndexType vertCounter = 0;
-  MeshIndexType edgeCounter = 0;
-  float minExtents[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
-  float maxExtents[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
-
-  for(MeshIndexType i = 0; i < numVerts; i++)
-  {
-    if(triVerts[3 * i + 0] < minExtents[0])
-    {
-      minExtents[0] = triVerts[3 * i + 0];
-    }
-    if(triVerts[3 * i + 0] > maxExtents[0])
-    {
-      maxExtents[0] = triVerts[3 * i + 0];
-    }
-    if(triVerts[3 * i + 1] < minExtents[1])
-    {
-      minExtents[1] = triVerts[3 * i + 1];
-    }
-    if(triVerts[3 * i + 1] > maxExtents[1])
+
+  float minExtents[3] = {0.0f, 0.0f, 0.0f};
+  float maxExtents[3] = {0.0f, 0.0f, 0.0f};
+  findExtents(triVerts, numVerts, minExtents, maxExtents);
+
+  notifyStatusMessage("Welding Triple Line Vertices...");
+
+  // A vertex is part of the triple line network if it is a triple line or quad point node, or a
+  // surface node lying on an edge of the bounding box
+  // TODO: generalize assumption that the surface of the mesh is an axis-aligned box
+  std::vector<uint8_t> inNetwork(numVerts, 0);
+  std::vector<MeshIndexType> networkIds(numVerts, 0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numVerts);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      maxExtents[1] = triVerts[3 * i + 1];
+      bool keep = isTripleLineNode(m_NodeTypes[i]) || (m_NodeTypes[i] == 12 && checkBoxEdge(minExtents, maxExtents, triVerts + (3 * i)));
+      inNetwork[i] = keep ? 1 : 0;
+      networkIds[i] = keep ? 1 : 0;
     }
-    if(triVerts[3 * i + 2] < minExtents[2])
+  });
+  MeshIndexType numNetworkVerts = ParallelHelpers::exclusiveScan(networkIds);
+
+  std::vector<WeldEntry> entries(k_NumCorners + numNetworkVerts);
+  for(MeshIndexType c = 0; c < k_NumCorners; c++)
+  {
+    float corner[3] = {(c & 1) ? maxExtents[0] : minExtents[0], (c & 2) ? maxExtents[1] : minExtents[1], (c & 4) ? maxExtents[2] : minExtents[2]};
+    entries[c] = {{packCoordinate(corner[0]), packCoordinate(corner[1]), packCoordinate(corner[2])}, c};
+  }
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      minExtents[2] = triVerts[3 * i + 2];
+      if(inNetwork[i] != 0)
+      {
+        entries[k_NumCorners + networkIds[i]] = {{packCoordinate(triVerts[3 * i + 0]), packCoordinate(triVerts[3 * i + 1]), packCoordinate(triVerts[3 * i + 2])}, k_NumCorners + i};
+      }
     }
-    if(triVerts[3 * i + 2] > maxExtents[2])
+  });
+  ParallelHelpers::sort(entries.begin(), entries.end());
+
+  // Each run of equal keys becomes one welded vertex; corners sort ahead of mesh vertices with the
+  // same coordinates, so a mesh vertex sitting on a corner is welded onto that corner
+  auto isRunHead = [&entries](size_t k) { return k == 0 || entries[k].key != entries[k - 1].key; };
+  MeshIndexType numEntries = entries.size();
+  std::vector<MeshIndexType> weldIds(numEntries, 0);
+  dataAlg.setRange(0, numEntries);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t k = range.min(); k < range.max(); k++)
     {
-      maxExtents[2] = triVerts[3 * i + 2];
+      weldIds[k] = isRunHead(k) ? 1 : 0;
     }
-  }
+  });
+  MeshIndexType numTripleLineVerts = ParallelHelpers::exclusiveScan(weldIds);
 
-  // TODO: generalize assumption that the surface of the mesh is an axis-aligned box
-  std::vector<Vertex> corners;
-  Vertex corner0 = {minExtents[0], minExtents[1], minExtents[2]};
-  corners.push_back(corner0);
-  Vertex corner1 = {maxExtents[0], minExtents[1], minExtents[2]};
-  corners.push_back(corner1);
-  Vertex corner2 = {maxExtents[0], maxExtents[1], minExtents[2]};
-  corners.push_back(corner2);
-  Vertex corner3 = {minExtents[0], maxExtents[1], minExtents[2]};
-  corners.push_back(corner3);
-  Vertex corner4 = {minExtents[0], minExtents[1], maxExtents[2]};
-  corners.push_back(corner4);
-  Vertex corner5 = {maxExtents[0], minExtents[1], maxExtents[2]};
-  corners.push_back(corner5);
-  Vertex corner6 = {maxExtents[0], maxExtents[1], maxExtents[2]};
-  corners.push_back(corner6);
-  Vertex corner7 = {minExtents[0], maxExtents[1], maxExtents[2]};
-  corners.push_back(corner7);
-
-  for(auto vert : corners)
+  if(numTripleLineVerts > std::numeric_limits<uint32_t>::max())
   {
-    tmpVerts.push_back(vert);
-    tmpNodeTypes.push_back(12);
-    vertexMap[vert] = vertCounter;
-    vertCounter++;
+    QString ss = QObject::tr("The triple line network has %1 vertices, which exceeds the supported maximum of %2").arg(numTripleLineVerts).arg(std::numeric_limits<uint32_t>::max());
+    setErrorCondition(-98500, ss);
+    return;
   }
 
-  MeshIndexType progIncrement = numVerts / 100;
-  MeshIndexType prog = 1;
-  MeshIndexType progressInt = 0;
+  EdgeGeom::Pointer tripleLineEdge = getDataContainerArray()->getDataContainer(m_EdgeGeometry)->getGeometryAs<EdgeGeom>();
+  tripleLineEdge->resizeVertexList(numTripleLineVerts);
+  float* tripleLineVerts = tripleLineEdge->getVertexPointer(0);
 
-  for(MeshIndexType i = 0; i < numVerts; i++)
-  {
-    if(m_NodeTypes[i] == 12)
+  AttributeMatrix::Pointer attrMat = getDataContainerArray()->getDataContainer(m_EdgeGeometry)->getAttributeMatrix(m_VertexAttributeMatrixName);
+  std::vector<size_t> tDims(1, numTripleLineVerts);
+  attrMat->resizeAttributeArrays(tDims);
+  m_TripleLineNodeTypes = m_TripleLineNodeTypesPtr.lock()->getPointer(0);
+
+  // Map every network vertex of the triangle geometry to its welded vertex and write out the welded
+  // coordinates and node types
+  std::vector<MeshIndexType> networkWeldIds(numNetworkVerts, 0);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t k = range.min(); k < range.max(); k++)
     {
-      if(checkBoxEdge(minExtents, maxExtents, triVerts + (3 * i)))
+      bool head = isRunHead(k);
+      MeshIndexType weldId = head ? weldIds[k] : weldIds[k] - 1;
+      MeshIndexType order = entries[k].order;
+      if(order >= k_NumCorners)
       {
-        uint16_t numEdgesToVert = edgesContainingVert->getNumberOfElements(i);
-        MeshIndexType* edgesAtVert = edgesContainingVert->getElementListPointer(i);
-
-        Vertex tmpCoords0 = {triVerts[3 * i + 0], triVerts[3 * i + 1], triVerts[3 * i + 2]};
-        auto iter = vertexMap.find(tmpCoords0);
-        if(iter == vertexMap.end())
-        {
-          tmpVerts.push_back(tmpCoords0);
-          tmpNodeTypes.push_back(m_NodeTypes[i]);
-          vertexMap[tmpCoords0] = vertCounter;
-          vertCounter++;
-        }
-
-        for(uint16_t j = 0; j < numEdgesToVert; j++)
+        networkWeldIds[networkIds[order - k_NumCorners]] = weldId;
+      }
+      if(head)
+      {
+        for(size_t d = 0; d < 3; d++)
         {
-          std::vector<std::pair<Vertex, uint8_t>> vertsToCheck;
-          if(m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 0]] == 3 || m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 0]] == 4 || m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 0]] == 13 ||
-             m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 0]] == 14 ||
-             (m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 0]] == 12 && checkBoxEdge(minExtents, maxExtents, triVerts + (3 * edgePtr[2 * edgesAtVert[j] + 0]))))
-          {
-            Vertex vert = {triVerts[3 * edgePtr[2 * edgesAtVert[j] + 0] + 0], triVerts[3 * edgePtr[2 * edgesAtVert[j] + 0] + 1], triVerts[3 * edgePtr[2 * edgesAtVert[j] + 0] + 2]};
-            vertsToCheck.push_back({vert, 0});
-          }
-          if(m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 1]] == 3 || m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 1]] == 4 || m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 1]] == 13 ||
-             m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 1]] == 14 ||
-             (m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 1]] == 12 && checkBoxEdge(minExtents, maxExtents, triVerts + (3 * edgePtr[2 * edgesAtVert[j] + 1]))))
-          {
-            Vertex vert = {triVerts[3 * edgePtr[2 * edgesAtVert[j] + 1] + 0], triVerts[3 * edgePtr[2 * edgesAtVert[j] + 1] + 1], triVerts[3 * edgePtr[2 * edgesAtVert[j] + 1] + 2]};
-            vertsToCheck.push_back({vert, 1});
-          }
-          for(auto vert : vertsToCheck)
-          {
-            auto viter = vertexMap.find(vert.first);
-            if(viter == vertexMap.end())
-            {
-              tmpVerts.push_back(vert.first);
-              tmpNodeTypes.push_back(m_NodeTypes[edgePtr[2 * edgesAtVert[j] + vert.second]]);
-              vertexMap[vert.first] = vertCounter;
-              vertCounter++;
-            }
-
-            MeshIndexType startVert = vertexMap[tmpCoords0];
-            MeshIndexType endVert = vertexMap[vert.first];
-            if(startVert != endVert)
-            {
-              if(startVert > endVert)
-              {
-                std::swap(startVert, endVert);
-              }
-              Edge tmpEdge = {startVert, endVert};
-              auto eiter = edgeMap.find(tmpEdge);
-              if(eiter == edgeMap.end())
-              {
-                tmpEdges.push_back(tmpEdge);
-                edgeMap[tmpEdge] = edgeCounter;
-                edgeCounter++;
-              }
-            }
-          }
+          tripleLineVerts[3 * weldId + d] = unpackCoordinate(entries[k].key[d]);
         }
+        m_TripleLineNodeTypes[weldId] = (order < k_NumCorners) ? 12 : m_NodeTypes[order - k_NumCorners];
       }
     }
-
-    if(m_NodeTypes[i] == 3 || m_NodeTypes[i] == 4 || m_NodeTypes[i] == 13 || m_NodeTypes[i] == 14)
+  });
+
+  entries.clear();
+  entries.shrink_to_fit();
+  weldIds.clear();
+  weldIds.shrink_to_fit();
+
+  notifyStatusMessage("Building Edge Geometry...");
+
+  // An edge of the triangle geometry is kept if both of its vertices are in the network; edges are
+  // packed into a single 64 bit key (low vertex id in the upper half) so that duplicates created by
+  // welding can be removed with a sort and unique
+  std::vector<uint64_t> edgeKeys(numEdges, k_InvalidEdgeKey);
+  dataAlg.setRange(0, numEdges);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t e = range.min(); e < range.max(); e++)
     {
-      uint16_t numEdgesToVert = edgesContainingVert->getNumberOfElements(i);
-      MeshIndexType* edgesAtVert = edgesContainingVert->getElementListPointer(i);
-
-      Vertex tmpCoords0 = {triVerts[3 * i + 0], triVerts[3 * i + 1], triVerts[3 * i + 2]};
-      auto iter = vertexMap.find(tmpCoords0);
-      if(iter == vertexMap.end())
+      MeshIndexType v0 = edgePtr[2 * e + 0];
+      MeshIndexType v1 = edgePtr[2 * e + 1];
+      if(inNetwork[v0] == 0 || inNetwork[v1] == 0)
       {
-        tmpVerts.push_back(tmpCoords0);
-        tmpNodeTypes.push_back(m_NodeTypes[i]);
-        vertexMap[tmpCoords0] = vertCounter;
-        vertCounter++;
+        continue;
       }
-
-      for(uint16_t j = 0; j < numEdgesToVert; j++)
+      uint64_t w0 = networkWeldIds[networkIds[v0]];
+      uint64_t w1 = networkWeldIds[networkIds[v1]];
+      if(w0 == w1)
       {
-        std::vector<std::pair<Vertex, uint8_t>> vertsToCheck;
-        if(m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 0]] == 3 || m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 0]] == 4 || m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 0]] == 13 ||
-           m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 0]] == 14)
-        {
-          Vertex vert = {triVerts[3 * edgePtr[2 * edgesAtVert[j] + 0] + 0], triVerts[3 * edgePtr[2 * edgesAtVert[j] + 0] + 1], triVerts[3 * edgePtr[2 * edgesAtVert[j] + 0] + 2]};
-          vertsToCheck.push_back({vert, 0});
-        }
-        if(m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 1]] == 3 || m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 1]] == 4 || m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 1]] == 13 ||
-           m_NodeTypes[edgePtr[2 * edgesAtVert[j] + 1]] == 14)
-        {
-          Vertex vert = {triVerts[3 * edgePtr[2 * edgesAtVert[j] + 1] + 0], triVerts[3 * edgePtr[2 * edgesAtVert[j] + 1] + 1], triVerts[3 * edgePtr[2 * edgesAtVert[j] + 1] + 2]};
-          vertsToCheck.push_back({vert, 1});
-        }
-        for(auto vert : vertsToCheck)
-        {
-          auto viter = vertexMap.find(vert.first);
-          if(viter == vertexMap.end())
-          {
-            tmpVerts.push_back(vert.first);
-            tmpNodeTypes.push_back(m_NodeTypes[edgePtr[2 * edgesAtVert[j] + vert.second]]);
-            vertexMap[vert.first] = vertCounter;
-            vertCounter++;
-          }
-
-          MeshIndexType startVert = vertexMap[tmpCoords0];
-          MeshIndexType endVert = vertexMap[vert.first];
-          if(startVert != endVert)
-          {
-            if(startVert > endVert)
-            {
-              std::swap(startVert, endVert);
-            }
-            Edge tmpEdge = {startVert, endVert};
-            auto eiter = edgeMap.find(tmpEdge);
-            if(eiter == edgeMap.end())
-            {
-              tmpEdges.push_back(tmpEdge);
-              edgeMap[tmpEdge] = edgeCounter;
-              edgeCounter++;
-            }
-          }
-        }
+        continue;
       }
+      edgeKeys[e] = (std::min(w0, w1) << 32) | std::max(w0, w1);
     }
+  });
+  ParallelHelpers::sort(edgeKeys.begin(), edgeKeys.end());
+  edgeKeys.erase(std::lower_bound(edgeKeys.begin(), edgeKeys.end(), k_InvalidEdgeKey), edgeKeys.end());
+  edgeKeys.erase(std::unique(edgeKeys.begin(), edgeKeys.end()), edgeKeys.end());
 
-    if(i > prog)
+  MeshIndexType numTripleLineEdges = edgeKeys.size();
+  tripleLineEdge->resizeEdgeList(numTripleLineEdges);
+  MeshIndexType* tripleLineEdges = tripleLineEdge->getEdgePointer(0);
+  dataAlg.setRange(0, numTripleLineEdges);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t e = range.min(); e < range.max(); e++)
     {
-      progressInt = static_cast<MeshIndexType>((static_cast<float>(i) / numVerts) * 100.0f);
-      QString ss = QObject::tr("Extracting Triple Lines || %1% Completed").arg(progressInt);
-      notifyStatusMessage(ss);
-      prog = prog + progIncrement;
+      tripleLineEdges[2 * e + 0] = static_cast<MeshIndexType>(edgeKeys[e] >> 32);
+      tripleLineEdges[2 * e + 1] = static_cast<MeshIndexType>(edgeKeys[e] & 0xFFFFFFFFULL);
     }
-  }
+  });
 
-  EdgeGeom::Pointer tripleLineEdge = getDataContainerArray()->getDataContainer(m_EdgeGeometry)->getGeometryAs<EdgeGeom>();
-  tripleLineEdge->resizeEdgeList(tmpEdges.size());
-  tripleLineEdge->resizeVertexList(tmpVerts.size());
-  float* tripleLineVerts = tripleLineEdge->getVertexPointer(0);
-  MeshIndexType* tripleLineEdges = tripleLineEdge->getEdgePointer(0);
-  MeshIndexType numTripleLineVerts = tripleLineEdge->getNumberOfVertices();
-  MeshIndexType numTripleLineEdges = tripleLineEdge->getNumberOfEdges();
-
-  QString ss = QObject::tr("Building Edge Geoemetry...");
-  notifyStatusMessage(ss);
-
-  for(MeshIndexType i = 0; i < numTripleLineVerts; i++)
-  {
-    tripleLineVerts[3 * i + 0] = tmpVerts[i][0];
-    tripleLineVerts[3 * i + 1] = tmpVerts[i][1];
-    tripleLineVerts[3 * i + 2] = tmpVerts[i][2];
-  }
-
-  for(MeshIndexType i = 0; i < numTripleLineEdges; i++)
-  {
-    tripleLineEdges[2 * i + 0] = tmpEdges[i][0];
-    tripleLineEdges[2 * i + 1] = tmpEdges[i][1];
-  }
-
-  AttributeMatrix::Pointer attrMat = getDataContainerArray()->getDataContainer(m_EdgeGeometry)->getAttributeMatrix(m_VertexAttributeMatrixName);
-  std::vector<size_t> tDims(1, numTripleLineVerts);
-  attrMat->resizeAttributeArrays(tDims);
   attrMat = getDataContainerArray()->getDataContainer(m_EdgeGeometry)->getAttributeMatrix(m_EdgeAttributeMatrixName);
   tDims[0] = numTripleLineEdges;
   attrMat->resizeAttributeArrays(tDims);
-
-  m_TripleLineNodeTypes = m_TripleLineNodeTypesPtr.lock()->getPointer(0);
-  std::memcpy(m_TripleLineNodeTypes, tmpNodeTypes.data(), sizeof(int8_t) * numTripleLineVerts);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void burnVertices(std::vector<MeshIndexType> vertsToBurn, MeshIndexType seedVert, std::unordered_set<MeshIndexType>& burnedVerts, MeshIndexType& vertCounter, MeshIndexType& edgeCounter,
-                  float* vertPtr, MeshIndexType* edgePtr, int8_t* nodeTypes, ElementDynamicList::Pointer edgesContainingVert, VertexMap& vertexMap, EdgeMap& edgeMap, std::vector<Vertex>& tmpVerts,
-                  std::vector<Edge>& tmpEdges, std::vector<int8_t>& tmpNodeTypes, AbstractFilter* filter)
+void ExtractTripleLinesFromTriangleGeometry::smoothTripleLines()
 {
-  if(vertsToBurn.empty())
-  {
-    return;
-  }
+  EdgeGeom::Pointer tripleLineEdge = getDataContainerArray()->getDataContainer(m_EdgeGeometry)->getGeometryAs<EdgeGeom>();
+  float* vertPtr = tripleLineEdge->getVertexPointer(0);
+  MeshIndexType* edgePtr = tripleLineEdge->getEdgePointer(0);
+  MeshIndexType numVerts = tripleLineEdge->getNumberOfVertices();
+  MeshIndexType numEdges = tripleLineEdge->getNumberOfEdges();
+  m_TripleLineNodeTypes = m_TripleLineNodeTypesPtr.lock()->getPointer(0);
+  const MeshIndexType invalid = std::numeric_limits<MeshIndexType>::max();
 
-  std::vector<MeshIndexType> chain;
-  MeshIndexType startVert = 0;
-  MeshIndexType endVert = 0;
-  for(auto vert : vertsToBurn)
-  {
-    burnedVerts.insert(vert);
+  notifyStatusMessage("Labeling Triple Lines...");
 
-    Vertex headVert = {vertPtr[3 * vert + 0], vertPtr[3 * vert + 1], vertPtr[3 * vert + 2]};
-    auto hiter = vertexMap.find(headVert);
-    if(hiter == vertexMap.end())
+  // Record the degree of each vertex and, for vertices of degree two, both neighbors
+  std::vector<std::atomic<uint32_t>> degrees(numVerts);
+  std::vector<MeshIndexType> neighbors(2 * numVerts, invalid);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numVerts);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t v = range.min(); v < range.max(); v++)
     {
-      tmpVerts.push_back(headVert);
-      tmpNodeTypes.push_back(nodeTypes[vert]);
-      vertexMap[headVert] = vertCounter;
-      vertCounter++;
+      degrees[v].store(0, std::memory_order_relaxed);
     }
-
-    uint16_t numEdgesToVert = edgesContainingVert->getNumberOfElements(vert);
-    MeshIndexType* edgesAtVert = edgesContainingVert->getElementListPointer(vert);
-    for(uint16_t i = 0; i < numEdgesToVert; i++)
+  });
+  dataAlg.setRange(0, numEdges);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t e = range.min(); e < range.max(); e++)
     {
-      startVert = vert;
-      endVert = (edgePtr[2 * edgesAtVert[i] + 0] != startVert) ? edgePtr[2 * edgesAtVert[i] + 0] : edgePtr[2 * edgesAtVert[i] + 1];
-      if((nodeTypes[endVert] == 4 || nodeTypes[endVert] == 14) && burnedVerts.count(endVert) == 0)
+      for(size_t j = 0; j < 2; j++)
       {
-        Vertex tailVert = {vertPtr[3 * endVert + 0], vertPtr[3 * endVert + 1], vertPtr[3 * endVert + 2]};
-        auto titer = vertexMap.find(tailVert);
-        if(titer == vertexMap.end())
+        MeshIndexType v = edgePtr[2 * e + j];
+        uint32_t slot = degrees[v].fetch_add(1, std::memory_order_relaxed);
+        if(slot < 2)
         {
-          tmpVerts.push_back(tailVert);
-          tmpNodeTypes.push_back(nodeTypes[endVert]);
-          vertexMap[tailVert] = vertCounter;
-          vertCounter++;
+          neighbors[2 * v + slot] = edgePtr[2 * e + (1 - j)];
         }
+      }
+    }
+  });
 
-        MeshIndexType head = vertexMap[headVert];
-        MeshIndexType tail = vertexMap[tailVert];
-        if(head > tail)
-        {
-          std::swap(head, tail);
-        }
+  // Interior vertices of a triple line have exactly two neighbors and are triple line nodes; quad
+  // points, box edge nodes and branch points stay fixed and terminate the lines. Adjacent interior
+  // vertices always belong to the same line, whatever their node types, so that no vertex is moved
+  // by one line while another reads it as an end point
+  auto isInterior = [&](MeshIndexType v) { return degrees[v].load(std::memory_order_relaxed) == 2 && (m_TripleLineNodeTypes[v] == 3 || m_TripleLineNodeTypes[v] == 13); };
 
-        Edge tmpEdge = {head, tail};
-        auto eiter = edgeMap.find(tmpEdge);
-        if(eiter == edgeMap.end())
-        {
-          tmpEdges.push_back(tmpEdge);
-          edgeMap[tmpEdge] = edgeCounter;
-          edgeCounter++;
-        }
-        return;
+  UnionFind<MeshIndexType> unionFind(numVerts);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t e = range.min(); e < range.max(); e++)
+    {
+      MeshIndexType v0 = edgePtr[2 * e + 0];
+      MeshIndexType v1 = edgePtr[2 * e + 1];
+      if(isInterior(v0) && isInterior(v1))
+      {
+        unionFind.unite(v0, v1);
       }
     }
+  });
 
-    for(uint16_t i = 0; i < numEdgesToVert; i++)
+  std::vector<MeshIndexType> labels(numVerts, invalid);
+  dataAlg.setRange(0, numVerts);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t v = range.min(); v < range.max(); v++)
     {
-      startVert = vert;
-      endVert = (edgePtr[2 * edgesAtVert[i] + 0] != startVert) ? edgePtr[2 * edgesAtVert[i] + 0] : edgePtr[2 * edgesAtVert[i] + 1];
-      if(startVert != endVert)
+      if(isInterior(v))
       {
-        if(burnedVerts.count(endVert) > 0)
-        {
-          continue;
-        }
-
-        Vertex tailVert = {vertPtr[3 * endVert + 0], vertPtr[3 * endVert + 1], vertPtr[3 * endVert + 2]};
-        auto titer = vertexMap.find(tailVert);
-        if(titer == vertexMap.end())
-        {
-          tmpVerts.push_back(tailVert);
-          tmpNodeTypes.push_back(nodeTypes[endVert]);
-          vertexMap[tailVert] = vertCounter;
-          vertCounter++;
-        }
-
-        MeshIndexType head = vertexMap[headVert];
-        MeshIndexType tail = vertexMap[tailVert];
-        if(head > tail)
-        {
-          std::swap(head, tail);
-        }
-
-        Edge tmpEdge = {head, tail};
-        auto eiter = edgeMap.find(tmpEdge);
-        if(eiter == edgeMap.end())
-        {
-          tmpEdges.push_back(tmpEdge);
-          edgeMap[tmpEdge] = edgeCounter;
-          edgeCounter++;
-        }
-
-        if(!(nodeTypes[endVert] == 4 || nodeTypes[endVert] == 14))
-        {
-          chain.push_back(endVert);
-        }
+        labels[v] = unionFind.find(v);
       }
     }
-  }
-
-  QString ss = QObject::tr("Burned %1 Vertices").arg(burnedVerts.size());
-  filter->notifyStatusMessage(ss);
-
-  burnVertices(chain, seedVert, burnedVerts, vertCounter, edgeCounter, vertPtr, edgePtr, nodeTypes, edgesContainingVert, vertexMap, edgeMap, tmpVerts, tmpEdges, tmpNodeTypes, filter);
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void ExtractTripleLinesFromTriangleGeometry::smoothTripleLines()
-{
-  EdgeGeom::Pointer tripleLineEdge = getDataContainerArray()->getDataContainer(m_EdgeGeometry)->getGeometryAs<EdgeGeom>();
-  tripleLineEdge->findElementsContainingVert();
-  float* vertPtr = tripleLineEdge->getVertexPointer(0);
-  MeshIndexType* edgePtr = tripleLineEdge->getEdgePointer(0);
-  ElementDynamicList::Pointer edgesContainingVert = tripleLineEdge->getElementsContainingVert();
-  MeshIndexType numVerts = tripleLineEdge->getNumberOfVertices();
+  });
 
-  VertexMap vertexMap;
-  EdgeMap edgeMap;
-  std::vector<Vertex> tmpVerts;
-  std::vector<Edge> tmpEdges;
-  std::vector<int8_t> tmpNodeTypes;
-  std::vector<int32_t> tmpTripleLineIds;
-  MeshIndexType vertCounter = 0;
-  MeshIndexType edgeCounter = 0;
-  // int32_t tripleLineCounter = 1;
-  MeshIndexType seedVert = -1;
-
-  // for(int64_t i = 0; i < numVerts; i++)
-  //{
-  //  if(m_TripleLineNodeTypes[i] == 4 || m_TripleLineNodeTypes[i] == 14)
-  //  {
-  //    bool valid = true;
-  //    uint16_t numEdgesToVert = edgesContainingVert->getNumberOfElements(i);
-  //    int64_t* edgesAtVert = edgesContainingVert->getElementListPointer(i);
-  //    for(uint16_t j = 0; j < numEdgesToVert; j++)
-  //    {
-  //      if(((m_TripleLineNodeTypes[edgePtr[2 * edgesAtVert[j] + 0]] == 4 || m_TripleLineNodeTypes[edgePtr[2 * edgesAtVert[j] + 0]] == 14) && edgePtr[2 * edgesAtVert[j] + 0] != i) ||
-  //         ((m_TripleLineNodeTypes[edgePtr[2 * edgesAtVert[j] + 1]] == 4 || m_TripleLineNodeTypes[edgePtr[2 * edgesAtVert[j] + 1]] == 14) && edgePtr[2 * edgesAtVert[j] + 1] != i))
-  //      {
-  //        valid = false;
-  //        break;
-  //      }
-  //    }
-  //    if(valid)
-  //    {
-  //      seedVert = i;
-  //      break;
-  //    }
-  //  }
-  //}
-
-  // if(seedVert < 0)
-  //{
-  //  setErrorCondition(-1, "Unable to find isolated seed quad point");
-  //  return;
-  //}
-
-  float minExtents[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
-  float maxExtents[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
-  for(MeshIndexType i = 0; i < numVerts; i++)
+  std::vector<MeshIndexType> roots;
+  for(MeshIndexType v = 0; v < numVerts; v++)
   {
-    if(vertPtr[3 * i + 0] < minExtents[0])
-    {
-      minExtents[0] = vertPtr[3 * i + 0];
-    }
-    if(vertPtr[3 * i + 0] > maxExtents[0])
-    {
-      vertPtr[0] = vertPtr[3 * i + 0];
-    }
-    if(vertPtr[3 * i + 1] < minExtents[1])
-    {
-      minExtents[1] = vertPtr[3 * i + 1];
-    }
-    if(vertPtr[3 * i + 1] > maxExtents[1])
-    {
-      maxExtents[1] = vertPtr[3 * i + 1];
-    }
-    if(vertPtr[3 * i + 2] < minExtents[2])
-    {
-      minExtents[2] = vertPtr[3 * i + 2];
-    }
-    if(vertPtr[3 * i + 2] > maxExtents[2])
+    if(labels[v] == v)
     {
-      maxExtents[2] = vertPtr[3 * i + 2];
+      roots.push_back(v);
     }
   }
 
-  Vertex vert = {minExtents[0], minExtents[1], minExtents[2]};
-  tmpVerts.push_back(vert);
-  tmpNodeTypes.push_back(m_TripleLineNodeTypes[seedVert]);
-  vertexMap[vert] = vertCounter;
-  vertCounter++;
+  notifyStatusMessage(QObject::tr("Smoothing %1 Triple Lines...").arg(roots.size()));
 
-  uint16_t numEdgesToVert = edgesContainingVert->getNumberOfElements(seedVert);
-  MeshIndexType* edgesAtVert = edgesContainingVert->getElementListPointer(seedVert);
-  std::unordered_set<MeshIndexType> burnedVerts;
+  // Triple lines share no interior vertices, so each one is smoothed independently; the end points
+  // are only read, never written
+  dataAlg.setRange(0, roots.size());
+  dataAlg.execute([&](const SIMPLRange& range) {
+    BsplineEvaluator evaluator;
+    std::vector<MeshIndexType> path;
+    std::vector<float> controlPoints;
+    std::vector<float> params;
+    std::vector<float> smoothed;
 
-  for(uint16_t i = 0; i < numEdgesToVert; i++)
-  {
-    burnedVerts.insert(edgePtr[2 * edgesAtVert[i] + 0]);
-    burnedVerts.insert(edgePtr[2 * edgesAtVert[i] + 1]);
-  }
-
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::uniform_int_distribution<> dis(0, numEdgesToVert - 1);
-  uint16_t idx = dis(gen);
-  MeshIndexType begin = (edgePtr[2 * edgesAtVert[idx] + 0] != seedVert) ? edgePtr[2 * edgesAtVert[idx] + 0] : edgePtr[2 * edgesAtVert[idx] + 1];
-
-  Edge tmpEdge = {0, 1};
-  tmpEdges.push_back(tmpEdge);
-  edgeMap[tmpEdge] = edgeCounter;
-  edgeCounter++;
+    auto nextAlong = [&neighbors](MeshIndexType cur, MeshIndexType from) { return (neighbors[2 * cur + 0] != from) ? neighbors[2 * cur + 0] : neighbors[2 * cur + 1]; };
 
-  std::vector<MeshIndexType> vertsToBurn = {begin};
-
-  burnVertices(vertsToBurn, seedVert, burnedVerts, vertCounter, edgeCounter, vertPtr, edgePtr, m_TripleLineNodeTypes, edgesContainingVert, vertexMap, edgeMap, tmpVerts, tmpEdges, tmpNodeTypes, this);
-
-  std::vector<std::vector<float>> controlPoints(tmpVerts.size(), std::vector<float>(3, 0.0f));
-  for(MeshIndexType i = 0; i < controlPoints.size(); i++)
-  {
-    controlPoints[i][0] = tmpVerts[i][0];
-    controlPoints[i][1] = tmpVerts[i][1];
-    controlPoints[i][2] = tmpVerts[i][2];
-  }
-
-  std::vector<float> smoothPoints = computeBsplineInterpolation(controlPoints, 0, 1);
-  VertexGeom::Pointer vertex = VertexGeom::CreateGeometry(smoothPoints.size() / 3, SIMPL::Geometry::VertexGeometry);
-  MeshIndexType smoothNumVerts = vertex->getNumberOfVertices();
-  float* smoothPtr = vertex->getVertexPointer(0);
-  std::memcpy(smoothPtr, smoothPoints.data(), sizeof(float) * smoothNumVerts * 3);
-  DataContainer::Pointer dc = DataContainer::New("TEST_SMOOTHING");
-  dc->setGeometry(vertex);
-  getDataContainerArray()->addOrReplaceDataContainer(dc);
-
-  tripleLineEdge->resizeVertexList(tmpVerts.size());
-  tripleLineEdge->resizeEdgeList(tmpEdges.size());
-  vertPtr = tripleLineEdge->getVertexPointer(0);
-  edgePtr = tripleLineEdge->getEdgePointer(0);
-  for(MeshIndexType i = 0; i < tmpVerts.size(); i++)
-  {
-    vertPtr[3 * i + 0] = tmpVerts[i][0];
-    vertPtr[3 * i + 1] = tmpVerts[i][1];
-    vertPtr[3 * i + 2] = tmpVerts[i][2];
-  }
-  for(MeshIndexType i = 0; i < tmpEdges.size(); i++)
-  {
-    edgePtr[2 * i + 0] = tmpEdges[i][0];
-    edgePtr[2 * i + 1] = tmpEdges[i][1];
-  }
-
-  AttributeMatrix::Pointer attrMat = getDataContainerArray()->getDataContainer(m_EdgeGeometry)->getAttributeMatrix(m_VertexAttributeMatrixName);
-  std::vector<size_t> tDims(1, tripleLineEdge->getNumberOfVertices());
-  attrMat->resizeAttributeArrays(tDims);
-  attrMat = getDataContainerArray()->getDataContainer(m_EdgeGeometry)->getAttributeMatrix(m_EdgeAttributeMatrixName);
-  tDims[0] = tripleLineEdge->getNumberOfEdges();
-  attrMat->resizeAttributeArrays(tDims);
-
-  m_TripleLineNodeTypes = m_TripleLineNodeTypesPtr.lock()->getPointer(0);
-  std::memcpy(m_TripleLineNodeTypes, tmpNodeTypes.data(), sizeof(int8_t) * tripleLineEdge->getNumberOfVertices());
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-std::vector<float> ExtractTripleLinesFromTriangleGeometry::computeBsplineInterpolation(std::vector<std::vector<float>> points, float minVal, float maxVal)
-{
-  std::vector<float> result;
-  size_t counter = 1;
-  for(float value = minVal; value <= maxVal; value += 0.01f)
-  {
-    size_t degree = 4;
-    auto numKnots = points.size() + degree + 1;
-    std::vector<float> knots(numKnots);
-    std::vector<float> weights(points.size(), 1.0f);
-    std::iota(std::begin(knots), std::end(knots), 0);
-    float domainLow = static_cast<float>(degree);
-    float domainHigh = static_cast<float>(knots.size() - 1 - degree);
-    float low = knots[static_cast<size_t>(domainLow)];
-    float high = knots[static_cast<size_t>(domainHigh)];
-    float t = value * (high - low) + low;
-    size_t s;
-    for(s = domainLow; s < domainHigh; s++)
+    for(size_t r = range.min(); r < range.max(); r++)
     {
-      if(t >= knots[s] && t <= knots[s + 1])
+      if(getCancel())
       {
-        break;
+        return;
       }
-    }
-
-    std::vector<std::vector<float>> v(points);
-    for(auto&& point : v)
-    {
-      point.push_back(1.0f);
-    }
 
-    float alpha;
-    for(size_t l = 1; l <= degree; l++)
-    {
-      for(size_t i = s; i > (s - degree - 1 + 1); i--)
+      // Walk from the root to one end of the line; closed loops have no fixed end and are skipped
+      MeshIndexType root = roots[r];
+      MeshIndexType from = neighbors[2 * root + 1];
+      MeshIndexType cur = root;
+      MeshIndexType end = invalid;
+      while(true)
       {
-        alpha = (t - knots[i]) / (knots[i + degree + 1 - 1] - knots[i]);
-        for(size_t j = 0; j < (3 + 1); j++)
+        MeshIndexType next = nextAlong(cur, from);
+        if(labels[next] != root)
+        {
+          end = next;
+          break;
+        }
+        if(next == root)
         {
-          v[i][j] = (1 - alpha) * v[i - 1][j] + alpha * v[i][j];
+          break;
         }
+        from = cur;
+        cur = next;
+      }
+      if(end == invalid)
+      {
+        continue;
       }
-    }
 
-    for(size_t i = 0; i < 3; i++)
-    {
-      result.push_back(v[s][i] / v[s][3]);
-    }
+      path.clear();
+      path.push_back(end);
+      from = end;
+      while(true)
+      {
+        path.push_back(cur);
+        MeshIndexType next = nextAlong(cur, from);
+        if(labels[next] != root)
+        {
+          path.push_back(next);
+          break;
+        }
+        from = cur;
+        cur = next;
+      }
 
-    QString ss = QObject::tr("Smoothing Triple Line || Iteration %1").arg(counter);
-    notifyStatusMessage(ss);
-    counter++;
-  }
+      // Chord length parameterization of the line
+      size_t numPoints = path.size();
+      controlPoints.resize(3 * numPoints);
+      params.resize(numPoints);
+      float length = 0.0f;
+      for(size_t i = 0; i < numPoints; i++)
+      {
+        std::copy_n(vertPtr + 3 * path[i], 3, controlPoints.data() + 3 * i);
+        if(i > 0)
+        {
+          float dx = controlPoints[3 * i + 0] - controlPoints[3 * (i - 1) + 0];
+          float dy = controlPoints[3 * i + 1] - controlPoints[3 * (i - 1) + 1];
+          float dz = controlPoints[3 * i + 2] - controlPoints[3 * (i - 1) + 2];
+          length += std::sqrt(dx * dx + dy * dy + dz * dz);
+        }
+        params[i] = length;
+      }
+      if(length <= 0.0f)
+      {
+        continue;
+      }
+      for(auto& param : params)
+      {
+        param /= length;
+      }
 
-  return result;
+      evaluator.evaluate(controlPoints, params, smoothed);
+      for(size_t i = 1; i < numPoints - 1; i++)
+      {
+        std::copy_n(smoothed.data() + 3 * i, 3, vertPtr + 3 * path[i]);
+      }
+    }
+  });
 }
 
 // -----------------------------------------------------------------------------
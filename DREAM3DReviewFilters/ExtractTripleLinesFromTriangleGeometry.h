@@ -178,8 +178,6 @@ protected:
 
   void smoothTripleLines();
 
-  std::vector<float> computeBsplineInterpolation(std::vector<std::vector<float>> points, float minVal, float maxVal);
-
   /**
    * @brief dataCheck Checks for the appropriate parameter values and availability of arrays
    */
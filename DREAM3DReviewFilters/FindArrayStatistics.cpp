@@ -34,15 +34,18 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindArrayStatistics.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <functional>
 #include <numeric>
-#include <unordered_map>
+#include <type_traits>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/Common/TemplateHelpers.h"
 #include "SIMPLib/DataArrays/NeighborList.hpp"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
@@ -58,19 +61,17 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
+#include "DREAM3DReview/DREAM3DReviewFilters/util/ParallelHelpers.hpp"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/QuantileSketch.hpp"
+
 #define STATISTICS_FILTER_CLASS_NAME FindArrayStatistics
 #include "util/StatisticsHelpers.hpp"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#endif
-
 // -----------------------------------------------------------------------------
 FindArrayStatistics::FindArrayStatistics() = default;
 
@@ -120,6 +121,11 @@ void FindArrayStatistics::setupFilterParameters()
   linkedProps << "SummationArrayName";
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Find Summation", FindSummation, FilterParameter::Category::Parameter, FindArrayStatistics, linkedProps));
   linkedProps.clear();
+  linkedProps << "Percentiles"
+              << "PercentilesArrayName";
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Find Percentiles", FindPercentiles, FilterParameter::Category::Parameter, FindArrayStatistics, linkedProps));
+  parameters.push_back(SIMPL_NEW_STRING_FP("Percentiles", Percentiles, FilterParameter::Category::Parameter, FindArrayStatistics));
+  linkedProps.clear();
 
   parameters.push_back(SeparatorFilterParameter::Create("Algorithm Options", FilterParameter::Category::Parameter));
   linkedProps << "MaskArrayPath";
@@ -130,6 +136,10 @@ void FindArrayStatistics::setupFilterParameters()
   linkedProps.clear();
   linkedProps << "StandardizedArrayName";
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Standardize Data", StandardizeData, FilterParameter::Category::Parameter, FindArrayStatistics, linkedProps));
+  linkedProps.clear();
+  linkedProps << "QuantileSketchSize";
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Streaming Statistics", UseStreamingStatistics, FilterParameter::Category::Parameter, FindArrayStatistics, linkedProps));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Quantile Sketch Size", QuantileSketchSize, FilterParameter::Category::Parameter, FindArrayStatistics));
 
   DataArraySelectionFilterParameter::RequirementType dasReq = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::Defaults::AnyPrimitive, 1, AttributeMatrix::Type::Any, IGeometry::Type::Any);
   parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Attribute Array to Compute Statistics", SelectedArrayPath, FilterParameter::Category::RequiredArray, FindArrayStatistics, dasReq));
@@ -155,6 +165,8 @@ void FindArrayStatistics::setupFilterParameters()
                                                       FindArrayStatistics));
   parameters.push_back(
       SIMPL_NEW_DA_WITH_LINKED_AM_FP("Summation", SummationArrayName, DestinationAttributeMatrix, DestinationAttributeMatrix, FilterParameter::Category::CreatedArray, FindArrayStatistics));
+  parameters.push_back(
+      SIMPL_NEW_DA_WITH_LINKED_AM_FP("Percentiles", PercentilesArrayName, DestinationAttributeMatrix, DestinationAttributeMatrix, FilterParameter::Category::CreatedArray, FindArrayStatistics));
   parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Standardized Data", StandardizedArrayName, SelectedArrayPath, SelectedArrayPath, FilterParameter::Category::CreatedArray, FindArrayStatistics));
 
   setFilterParameters(parameters);
@@ -175,7 +187,7 @@ void FindArrayStatistics::dataCheck()
   clearErrorCode();
   clearWarningCode();
 
-  if(!getFindHistogram() && !getFindMin() && !getFindMax() && !getFindMean() && !getFindMedian() && !getFindStdDeviation() && !getFindSummation() && !getFindLength())
+  if(!getFindHistogram() && !getFindMin() && !getFindMax() && !getFindMean() && !getFindMedian() && !getFindStdDeviation() && !getFindSummation() && !getFindLength() && !getFindPercentiles())
   {
     QString ss = QObject::tr("No statistics have been selected, so this filter will perform no operations");
     setWarningCondition(-701, ss);
@@ -259,6 +271,56 @@ void FindArrayStatistics::dataCheck()
     }
   }
 
+  if(m_FindPercentiles)
+  {
+    m_PercentileValues.clear();
+    QStringList tokens = getPercentiles().split(',');
+    for(const QString& token : tokens)
+    {
+      if(token.trimmed().isEmpty())
+      {
+        continue;
+      }
+      bool ok = false;
+      float percentile = token.trimmed().toFloat(&ok);
+      if(!ok || percentile < 0.0f || percentile > 100.0f)
+      {
+        QString ss = QObject::tr("The percentiles must be a comma separated list of numbers between 0 and 100, but \"%1\" is not").arg(token.trimmed());
+        setErrorCondition(-11004, ss);
+        return;
+      }
+      m_PercentileValues.push_back(percentile);
+    }
+    if(m_PercentileValues.empty())
+    {
+      QString ss = QObject::tr("At least one percentile must be given to find percentiles");
+      setErrorCondition(-11004, ss);
+      return;
+    }
+    std::vector<size_t> cDims_List = {m_PercentileValues.size()};
+    DataArrayPath path(getDestinationAttributeMatrix().getDataContainerName(), getDestinationAttributeMatrix().getAttributeMatrixName(), getPercentilesArrayName());
+    m_PercentilesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, path, 0, cDims_List, "", DataArrayID38);
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+  }
+
+  if(getUseStreamingStatistics())
+  {
+    if(getQuantileSketchSize() < 8)
+    {
+      QString ss = QObject::tr("The quantile sketch size must be at least 8, but is %1").arg(getQuantileSketchSize());
+      setErrorCondition(-11005, ss);
+      return;
+    }
+    if(getComputeByIndex())
+    {
+      QString ss = QObject::tr("Streaming statistics only apply to statistics of the whole array; the statistics per Feature/Ensemble will be exact");
+      setWarningCondition(-11006, ss);
+    }
+  }
+
   if(getUseMask())
   {
     m_MaskPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<bool>>(this, getMaskArrayPath(), cDims);
@@ -297,59 +359,370 @@ void FindArrayStatistics::dataCheck()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-template <template <typename, typename...> class C, typename T, typename... Ts>
-std::vector<float> findHistogram(C<T, Ts...>& source, float histmin, float histmax, bool histfullrange, int32_t numBins)
+namespace
+{
+// Upper bound on the per-block feature counters of the counting sort
+constexpr size_t k_MaxCounters = 1 << 23;
+// Upper bound on the number of blocks of the counting sort
+constexpr size_t k_MaxBlocks = 64;
+// Smallest number of tuples worth a block of their own
+constexpr size_t k_MinBlockSize = 1 << 16;
+
+/**
+ * @brief Bool values are stored as bytes while grouped, so the blocks of the counting sort can write them concurrently
+ */
+template <typename T>
+using StorageType = typename std::conditional<std::is_same<T, bool>::value, uint8_t, T>::type;
+
+using StatisticsHelpers::SumType;
+
+/**
+ * @brief histogramBin Returns the bin of the value for numBins bins of width increment starting at min, or -1 if the
+ * value lies outside of [min, max]; the maximum itself falls into the last bin
+ */
+inline int32_t histogramBin(float value, float min, float max, float increment, int32_t numBins)
 {
-  if(source.empty())
+  float position = (value - min) / increment;
+  if(position >= 0.0f && position < static_cast<float>(numBins))
   {
-    return std::vector<float>(numBins, 0);
+    return static_cast<int32_t>(position);
   }
+  if(value == max)
+  {
+    return numBins - 1;
+  }
+  return -1;
+}
 
-  float min = 0.0f;
-  float max = 0.0f;
+/**
+ * @brief The HistogramBinning struct maps values to numBins bins spanning [min, max]. A range too small to split
+ * collapses to a single bin holding every value.
+ */
+struct HistogramBinning
+{
+  HistogramBinning(float minValue, float maxValue, int32_t bins)
+  : min(minValue)
+  , max(maxValue)
+  , increment((maxValue - minValue) / bins)
+  , numBins(std::abs(increment) < 1E-10 ? 1 : bins)
+  {
+  }
 
-  if(histfullrange)
+  int32_t bin(float value) const
   {
-    min = static_cast<float>(StatisticsHelpers::findMin(source));
-    max = static_cast<float>(StatisticsHelpers::findMax(source));
+    return numBins == 1 ? 0 : histogramBin(value, min, max, increment, numBins);
   }
-  else
+
+  float min;
+  float max;
+  float increment;
+  int32_t numBins;
+};
+
+/**
+ * @brief findHistogram Bins the values in [begin, end) into numBins bins spanning [min, max]
+ */
+template <typename Iterator>
+std::vector<float> findHistogram(Iterator begin, Iterator end, float min, float max, int32_t numBins)
+{
+  if(begin == end)
   {
-    min = histmin;
-    max = histmax;
+    return std::vector<float>(numBins, 0);
   }
 
-  float increment = (max - min) / (numBins);
-  if(std::abs(increment) < 1E-10)
+  HistogramBinning binning(min, max, numBins);
+  std::vector<float> Histogram(binning.numBins, 0);
+  for(Iterator iter = begin; iter != end; ++iter)
   {
-    numBins = 1;
+    int32_t bin = binning.bin(static_cast<float>(*iter));
+    if(bin >= 0)
+    {
+      Histogram[bin]++;
+    }
   }
 
-  std::vector<float> Histogram(numBins, 0);
+  return Histogram;
+}
 
-  if(numBins == 1) // if one bin, just set the first element to total number of points
+/**
+ * @brief storeMomentStatistics Stores the length, min, max, mean, standard deviation and summation at the given tuple of
+ * the non null output arrays; m2 is the sum of the squared deviations from the mean
+ */
+template <typename T>
+void storeMomentStatistics(size_t tuple, const std::vector<IDataArray::Pointer>& arrays, size_t count, StorageType<T> minValue, StorageType<T> maxValue, SumType<T> sum, double m2)
+{
+  float mean = 0.0f;
+  float stdDeviation = 0.0f;
+  if(count > 0)
   {
-    Histogram[0] = static_cast<float>(source.size());
+    if(std::is_same<T, bool>::value)
+    {
+      // Bool arrays report 1 for both the mean and the standard deviation when at least half of the values are true, else 0
+      bool majority = static_cast<size_t>(sum) >= count - static_cast<size_t>(sum);
+      mean = majority ? 1.0f : 0.0f;
+      stdDeviation = mean;
+    }
+    else
+    {
+      mean = static_cast<float>(static_cast<double>(sum) / static_cast<double>(count));
+      stdDeviation = static_cast<float>(std::sqrt(std::max(m2, 0.0) / static_cast<double>(count)));
+    }
   }
-  else
+
+  if(arrays[0])
+  {
+    int64_t val = static_cast<int64_t>(count);
+    arrays[0]->initializeTuple(tuple, &val);
+  }
+  if(arrays[1])
+  {
+    T val = static_cast<T>(minValue);
+    arrays[1]->initializeTuple(tuple, &val);
+  }
+  if(arrays[2])
+  {
+    T val = static_cast<T>(maxValue);
+    arrays[2]->initializeTuple(tuple, &val);
+  }
+  if(arrays[3])
+  {
+    arrays[3]->initializeTuple(tuple, &mean);
+  }
+  if(arrays[5])
+  {
+    arrays[5]->initializeTuple(tuple, &stdDeviation);
+  }
+  if(arrays[6])
   {
-    for(const auto s : source)
+    float val = static_cast<float>(sum);
+    arrays[6]->initializeTuple(tuple, &val);
+  }
+}
+
+/**
+ * @brief findRangeStatistics Computes the selected statistics of the values in [begin, end) and stores them at the given
+ * tuple of the non null output arrays (length, min, max, mean, median, standard deviation, summation, histogram,
+ * percentiles). Everything but the order statistics comes from the single pass of StatisticsHelpers::computeRangeStatistics;
+ * the median and percentiles then partially reorder the range in place with std::nth_element instead of sorting a copy.
+ */
+template <typename T>
+void findRangeStatistics(StorageType<T>* begin, StorageType<T>* end, size_t tuple, const std::vector<IDataArray::Pointer>& arrays, const std::vector<float>& percentiles, float histmin,
+                         float histmax, bool histfullrange, int32_t numBins)
+{
+  // The histogram does not depend on the order of the values, so it is fine to bin them after the median reordered them
+  StatisticsHelpers::RangeStatistics<StorageType<T>, SumType<T>> stats = StatisticsHelpers::computeRangeStatistics<T>(begin, end, arrays[4] ? begin : nullptr);
+  storeMomentStatistics<T>(tuple, arrays, stats.count, stats.minValue, stats.maxValue, stats.sum, stats.m2);
+
+  if(arrays[7])
+  {
+    float min = histfullrange ? static_cast<float>(stats.minValue) : histmin;
+    float max = histfullrange ? static_cast<float>(stats.maxValue) : histmax;
+    std::vector<float> vals = findHistogram(begin, end, min, max, numBins);
+    std::shared_ptr<DataArray<float>> histArray = std::dynamic_pointer_cast<DataArray<float>>(arrays[7]);
+    histArray->setTuple(tuple, vals);
+  }
+  if(arrays[4])
+  {
+    float val = static_cast<float>(stats.median);
+    arrays[4]->initializeTuple(tuple, &val);
+  }
+  if(arrays[8])
+  {
+    std::vector<float> vals(percentiles.size());
+    for(size_t i = 0; i < percentiles.size(); i++)
     {
-      float value = static_cast<float>(s);
-      size_t bin = static_cast<size_t>((value - min) / increment); // find bin for this input array value
-      if((bin >= 0) && (bin < numBins))                            // make certain bin is in range
+      vals[i] = static_cast<float>(StatisticsHelpers::findQuantile(begin, end, percentiles[i] / 100.0));
+    }
+    std::shared_ptr<DataArray<float>> percentilesArray = std::dynamic_pointer_cast<DataArray<float>>(arrays[8]);
+    percentilesArray->setTuple(tuple, vals);
+  }
+}
+
+/**
+ * @brief The StreamingSummary struct holds the statistics of a block of values that can be combined without revisiting
+ * the values: exact count, extrema, sum and central moments (merged as by Chan et al.), counts of the histogram bins
+ * and a quantile sketch.
+ */
+template <typename T>
+struct StreamingSummary
+{
+  explicit StreamingSummary(size_t sketchSize)
+  : sketch(sketchSize)
+  {
+  }
+
+  void merge(const StreamingSummary& other)
+  {
+    if(other.count == 0)
+    {
+      return;
+    }
+    if(count == 0)
+    {
+      minValue = other.minValue;
+      maxValue = other.maxValue;
+    }
+    minValue = std::min(minValue, other.minValue);
+    maxValue = std::max(maxValue, other.maxValue);
+    sum += other.sum;
+    size_t total = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * static_cast<double>(other.count) / static_cast<double>(total);
+    m2 += other.m2 + delta * delta * static_cast<double>(count) * static_cast<double>(other.count) / static_cast<double>(total);
+    count = total;
+    for(size_t bin = 0; bin < other.histogram.size(); bin++)
+    {
+      histogram[bin] += other.histogram[bin];
+    }
+    sketch.merge(other.sketch);
+  }
+
+  size_t count = 0;
+  StorageType<T> minValue = {};
+  StorageType<T> maxValue = {};
+  SumType<T> sum = 0;
+  double mean = 0.0;
+  double m2 = 0.0;
+  std::vector<uint64_t> histogram;
+  QuantileSketch sketch;
+};
+
+/**
+ * @brief findStreamingStatistics Computes the whole array statistics in one parallel pass over the (masked) values
+ * without copying them. Length, min, max, mean, standard deviation and summation are exact; the median and percentiles
+ * are read from a QuantileSketch of sketchSize, so their rank error is about 1.7 / sketchSize of the number of values.
+ * A histogram over the full range of the values needs a second pass once the range is known.
+ */
+template <typename T>
+void findStreamingStatistics(const T* dataPtr, bool useMask, const bool* mask, size_t numTuples, const std::vector<IDataArray::Pointer>& arrays, const std::vector<float>& percentiles, float histmin,
+                             float histmax, bool histfullrange, int32_t numBins, int32_t sketchSize)
+{
+  const bool findQuantiles = arrays[4] || arrays[8];
+  const bool binInFirstPass = arrays[7] && !histfullrange;
+  HistogramBinning binning(histmin, histmax, numBins);
+
+  // A fixed number of blocks merged in order keeps the sketch, and so the result, independent of the thread count
+  size_t numBlocks = std::max(static_cast<size_t>(1), std::min(k_MaxBlocks, numTuples / k_MinBlockSize));
+  std::vector<StreamingSummary<T>> blocks(numBlocks, StreamingSummary<T>(static_cast<size_t>(sketchSize)));
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numBlocks);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t block = range.min(); block < range.max(); block++)
+    {
+      StreamingSummary<T>& summary = blocks[block];
+      if(binInFirstPass)
       {
-        Histogram[bin]++; // increment histogram element corresponding to this input array value
+        summary.histogram.assign(binning.numBins, 0);
       }
-      else if(value == max)
+      double shift = 0.0;
+      double shiftedSum = 0.0;
+      double shiftedSquares = 0.0;
+      for(size_t i = block * numTuples / numBlocks; i < (block + 1) * numTuples / numBlocks; i++)
       {
-        Histogram[numBins - 1]++;
+        if(useMask && !mask[i])
+        {
+          continue;
+        }
+        StorageType<T> value = static_cast<StorageType<T>>(dataPtr[i]);
+        if(summary.count == 0)
+        {
+          summary.minValue = value;
+          summary.maxValue = value;
+          shift = static_cast<double>(value);
+        }
+        summary.count++;
+        summary.minValue = std::min(summary.minValue, value);
+        summary.maxValue = std::max(summary.maxValue, value);
+        summary.sum += static_cast<SumType<T>>(value);
+        double delta = static_cast<double>(value) - shift;
+        shiftedSum += delta;
+        shiftedSquares += delta * delta;
+        if(binInFirstPass)
+        {
+          int32_t bin = binning.bin(static_cast<float>(value));
+          if(bin >= 0)
+          {
+            summary.histogram[bin]++;
+          }
+        }
+        if(findQuantiles)
+        {
+          summary.sketch.add(static_cast<double>(value));
+        }
+      }
+      if(summary.count > 0)
+      {
+        summary.mean = shift + shiftedSum / static_cast<double>(summary.count);
+        summary.m2 = shiftedSquares - shiftedSum * shiftedSum / static_cast<double>(summary.count);
       }
     }
+  });
+
+  StreamingSummary<T>& total = blocks[0];
+  for(size_t block = 1; block < numBlocks; block++)
+  {
+    total.merge(blocks[block]);
   }
+  storeMomentStatistics<T>(0, arrays, total.count, total.minValue, total.maxValue, total.sum, total.m2);
 
-  return Histogram;
+  if(arrays[7])
+  {
+    if(histfullrange && total.count > 0)
+    {
+      binning = HistogramBinning(static_cast<float>(total.minValue), static_cast<float>(total.maxValue), numBins);
+      dataAlg.execute([&](const SIMPLRange& range) {
+        for(size_t block = range.min(); block < range.max(); block++)
+        {
+          std::vector<uint64_t>& histogram = blocks[block].histogram;
+          histogram.assign(binning.numBins, 0);
+          for(size_t i = block * numTuples / numBlocks; i < (block + 1) * numTuples / numBlocks; i++)
+          {
+            if(useMask && !mask[i])
+            {
+              continue;
+            }
+            int32_t bin = binning.bin(static_cast<float>(dataPtr[i]));
+            if(bin >= 0)
+            {
+              histogram[bin]++;
+            }
+          }
+        }
+      });
+      for(size_t block = 1; block < numBlocks; block++)
+      {
+        for(size_t bin = 0; bin < total.histogram.size(); bin++)
+        {
+          total.histogram[bin] += blocks[block].histogram[bin];
+        }
+      }
+    }
+    std::vector<float> vals(numBins, 0.0f);
+    if(total.count > 0)
+    {
+      vals.assign(total.histogram.begin(), total.histogram.end());
+    }
+    std::shared_ptr<DataArray<float>> histArray = std::dynamic_pointer_cast<DataArray<float>>(arrays[7]);
+    histArray->setTuple(0, vals);
+  }
+  if(arrays[4])
+  {
+    float val = static_cast<float>(total.sketch.quantile(0.5));
+    arrays[4]->initializeTuple(0, &val);
+  }
+  if(arrays[8])
+  {
+    std::vector<float> vals(percentiles.size());
+    for(size_t i = 0; i < percentiles.size(); i++)
+    {
+      vals[i] = static_cast<float>(total.sketch.quantile(percentiles[i] / 100.0));
+    }
+    std::shared_ptr<DataArray<float>> percentilesArray = std::dynamic_pointer_cast<DataArray<float>>(arrays[8]);
+    percentilesArray->setTuple(0, vals);
+  }
 }
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -440,208 +813,97 @@ void standardizeData<bool>(IDataArray::Pointer dataPtr, FloatArrayType::Pointer
 //
 // -----------------------------------------------------------------------------
 template <typename T>
-class FindArrayStatisticsByIndexImpl
-{
-public:
-  FindArrayStatisticsByIndexImpl(std::unordered_map<int32_t, std::list<T>>& featureDataMap, bool length, bool min, bool max, bool mean, bool median, bool stdDeviation, bool summation,
-                                 std::vector<IDataArray::Pointer>& arrays, bool hist, float histmin, float histmax, bool histfullrange, int32_t numBins)
-  : m_FeatureDataMap(featureDataMap)
-  , m_Length(length)
-  , m_Min(min)
-  , m_Max(max)
-  , m_Mean(mean)
-  , m_Median(median)
-  , m_StdDeviation(stdDeviation)
-  , m_Summation(summation)
-  , m_Histogram(hist)
-  , m_HistMin(histmin)
-  , m_HistMax(histmax)
-  , m_HistFullRange(histfullrange)
-  , m_NumBins(numBins)
-  , m_Arrays(arrays)
+void findStatisticsByIndex(const T* dataPtr, const int32_t* featureIds, bool useMask, const bool* mask, size_t numTuples, int32_t numFeatures, const std::vector<IDataArray::Pointer>& arrays,
+                           const std::vector<float>& percentiles, float histmin, float histmax, bool histfullrange, int32_t numBins)
+{
+  if(numFeatures <= 0)
   {
+    return;
   }
-
-  virtual ~FindArrayStatisticsByIndexImpl() = default;
-
-  void compute(size_t start, size_t end) const
-  {
-    for(size_t i = start; i < end; i++)
+  const size_t numGroups = static_cast<size_t>(numFeatures);
+  auto isCounted = [&](size_t i) { return (!useMask || mask[i]) && featureIds[i] >= 0 && featureIds[i] < numFeatures; };
+
+  // Group the values by feature with a counting sort into one contiguous buffer (compressed sparse rows): every block of
+  // tuples counts its values per feature, the counts become per block write offsets, and every block scatters its values
+  size_t numBlocks = std::max(static_cast<size_t>(1), std::min({k_MaxBlocks, numTuples / k_MinBlockSize, k_MaxCounters / numGroups}));
+  std::vector<size_t> blockOffsets(numBlocks * numGroups, 0);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numBlocks);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t block = range.min(); block < range.max(); block++)
     {
-      if(m_Length)
-      {
-        if(m_Arrays[0])
-        {
-          int64_t val = static_cast<int64_t>(m_FeatureDataMap[i].size());
-          m_Arrays[0]->initializeTuple(i, &val);
-        }
-      }
-      if(m_Min)
-      {
-        if(m_Arrays[1])
-        {
-          T val = StatisticsHelpers::findMin(m_FeatureDataMap[i]);
-          m_Arrays[1]->initializeTuple(i, &val);
-        }
-      }
-      if(m_Max)
+      size_t* counts = blockOffsets.data() + block * numGroups;
+      for(size_t i = block * numTuples / numBlocks; i < (block + 1) * numTuples / numBlocks; i++)
       {
-        if(m_Arrays[2])
+        if(isCounted(i))
         {
-          T val = StatisticsHelpers::findMax(m_FeatureDataMap[i]);
-          m_Arrays[2]->initializeTuple(i, &val);
+          counts[featureIds[i]]++;
         }
       }
-      if(m_Mean)
-      {
-        if(m_Arrays[3])
-        {
-          float val = StatisticsHelpers::findMean(m_FeatureDataMap[i]);
-          m_Arrays[3]->initializeTuple(i, &val);
-        }
-      }
-      if(m_Median)
-      {
-        if(m_Arrays[4])
-        {
-          float val = StatisticsHelpers::findMedian(m_FeatureDataMap[i]);
-          m_Arrays[4]->initializeTuple(i, &val);
-        }
-      }
-      if(m_StdDeviation)
+    }
+  });
+
+  std::vector<size_t> featureOffsets(numGroups + 1, 0);
+  dataAlg.setRange(0, numGroups);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t feature = range.min(); feature < range.max(); feature++)
+    {
+      for(size_t block = 0; block < numBlocks; block++)
       {
-        if(m_Arrays[5])
-        {
-          float val = StatisticsHelpers::findStdDeviation(m_FeatureDataMap[i]);
-          m_Arrays[5]->initializeTuple(i, &val);
-        }
+        featureOffsets[feature] += blockOffsets[block * numGroups + feature];
       }
-      if(m_Summation)
+    }
+  });
+  size_t numValues = ParallelHelpers::exclusiveScan(featureOffsets);
+  featureOffsets[numGroups] = numValues;
+
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t feature = range.min(); feature < range.max(); feature++)
+    {
+      size_t offset = featureOffsets[feature];
+      for(size_t block = 0; block < numBlocks; block++)
       {
-        if(m_Arrays[6])
-        {
-          float val = StatisticsHelpers::findSummation(m_FeatureDataMap[i]);
-          m_Arrays[6]->initializeTuple(i, &val);
-        }
+        size_t count = blockOffsets[block * numGroups + feature];
+        blockOffsets[block * numGroups + feature] = offset;
+        offset += count;
       }
+    }
+  });
 
-      if(m_Histogram)
+  std::vector<StorageType<T>> values(numValues);
+  dataAlg.setRange(0, numBlocks);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t block = range.min(); block < range.max(); block++)
+    {
+      size_t* offsets = blockOffsets.data() + block * numGroups;
+      for(size_t i = block * numTuples / numBlocks; i < (block + 1) * numTuples / numBlocks; i++)
       {
-        if(m_Arrays[7])
+        if(isCounted(i))
         {
-          std::vector<float> vals = findHistogram(m_FeatureDataMap[i], m_HistMin, m_HistMax, m_HistFullRange, m_NumBins);
-          std::shared_ptr<DataArray<float>> histArray = std::dynamic_pointer_cast<DataArray<float>>(m_Arrays[7]);
-          histArray->setTuple(i, vals);
+          values[offsets[featureIds[i]]++] = static_cast<StorageType<T>>(dataPtr[i]);
         }
       }
     }
-  }
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
-  {
-    compute(r.begin(), r.end());
-  }
-#endif
-
-private:
-  std::unordered_map<int32_t, std::list<T>>& m_FeatureDataMap;
-  bool m_Length;
-  bool m_Min;
-  bool m_Max;
-  bool m_Mean;
-  bool m_Median;
-  bool m_StdDeviation;
-  bool m_Summation;
-  bool m_Histogram;
-  float m_HistMin;
-  float m_HistMax;
-  bool m_HistFullRange;
-  int32_t m_NumBins;
-  std::vector<IDataArray::Pointer>& m_Arrays;
-};
+  });
+  blockOffsets.clear();
+  blockOffsets.shrink_to_fit();
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-template <typename T>
-void findStatisticsImpl(bool length, bool min, bool max, bool mean, bool median, bool stdDeviation, bool summation, std::vector<IDataArray::Pointer>& arrays, std::vector<T>& data, bool hist,
-                        float histmin, float histmax, bool histfullrange, int32_t numBins)
-{
-  if(length)
-  {
-    if(arrays[0])
-    {
-      int64_t val = static_cast<int64_t>(data.size());
-      arrays[0]->initializeTuple(0, &val);
-    }
-  }
-  if(min)
-  {
-    if(arrays[1])
+  dataAlg.setRange(0, numGroups);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t feature = range.min(); feature < range.max(); feature++)
     {
-      T val = StatisticsHelpers::findMin(data);
-      arrays[1]->initializeTuple(0, &val);
+      findRangeStatistics<T>(values.data() + featureOffsets[feature], values.data() + featureOffsets[feature + 1], feature, arrays, percentiles, histmin, histmax, histfullrange, numBins);
     }
-  }
-  if(max)
-  {
-    if(arrays[2])
-    {
-      T val = StatisticsHelpers::findMax(data);
-      arrays[2]->initializeTuple(0, &val);
-    }
-  }
-  if(mean)
-  {
-    if(arrays[3])
-    {
-      float val = StatisticsHelpers::findMean(data);
-      arrays[3]->initializeTuple(0, &val);
-    }
-  }
-  if(median)
-  {
-    if(arrays[4])
-    {
-      float val = StatisticsHelpers::findMedian(data);
-      arrays[4]->initializeTuple(0, &val);
-    }
-  }
-  if(stdDeviation)
-  {
-    if(arrays[5])
-    {
-      float val = StatisticsHelpers::findStdDeviation(data);
-      arrays[5]->initializeTuple(0, &val);
-    }
-  }
-  if(summation)
-  {
-    if(arrays[6])
-    {
-      float val = StatisticsHelpers::findSummation(data);
-      arrays[6]->initializeTuple(0, &val);
-    }
-  }
-
-  if(hist)
-  {
-    if(arrays[7])
-    {
-      std::vector<float> vals = findHistogram(data, histmin, histmax, histfullrange, numBins);
-      std::shared_ptr<DataArray<float>> histArray = std::dynamic_pointer_cast<DataArray<float>>(arrays[7]);
-      histArray->setTuple(0, vals);
-    }
-  }
+  });
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 template <typename T>
-void findStatistics(IDataArray::Pointer source, Int32ArrayType::Pointer featureIds, bool useMask, bool* mask, bool length, bool min, bool max, bool mean, bool median, bool stdDeviation,
-                    bool summation, std::vector<IDataArray::Pointer>& arrays, int32_t numFeatures, bool computeByIndex, bool hist, float histmin, float histmax, bool histfullrange, int32_t numBins)
+void findStatistics(IDataArray::Pointer source, Int32ArrayType::Pointer featureIds, bool useMask, bool* mask, std::vector<IDataArray::Pointer>& arrays, const std::vector<float>& percentiles,
+                    int32_t numFeatures, bool computeByIndex, bool streaming, int32_t sketchSize, float histmin, float histmax, bool histfullrange, int32_t numBins)
 {
   size_t numTuples = source->getNumberOfTuples();
   typename DataArray<T>::Pointer sourcePtr = std::dynamic_pointer_cast<DataArray<T>>(source);
@@ -649,64 +911,25 @@ void findStatistics(IDataArray::Pointer source, Int32ArrayType::Pointer featureI
 
   if(computeByIndex)
   {
-    int32_t* featureIdsPtr = featureIds->getPointer(0);
-    std::unordered_map<int32_t, std::list<T>> featureValueMap;
-
-    for(size_t i = 0; i < numTuples; i++)
-    {
-      if(useMask)
-      {
-        if(mask[i])
-        {
-          featureValueMap[featureIdsPtr[i]].push_back(dataPtr[i]);
-        }
-      }
-      else
-      {
-        featureValueMap[featureIdsPtr[i]].push_back(dataPtr[i]);
-      }
-    }
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    bool doParallel = true;
-#endif
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    if(doParallel)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, numFeatures),
-                        FindArrayStatisticsByIndexImpl<T>(featureValueMap, length, min, max, mean, median, stdDeviation, summation, arrays, hist, histmin, histmax, histfullrange, numBins),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      FindArrayStatisticsByIndexImpl<T> serial(featureValueMap, length, min, max, mean, median, stdDeviation, summation, arrays, hist, histmin, histmax, histfullrange, numBins);
-      serial.compute(0, numFeatures);
-    }
+    findStatisticsByIndex(dataPtr, featureIds->getPointer(0), useMask, mask, numTuples, numFeatures, arrays, percentiles, histmin, histmax, histfullrange, numBins);
+  }
+  else if(streaming)
+  {
+    findStreamingStatistics(dataPtr, useMask, mask, numTuples, arrays, percentiles, histmin, histmax, histfullrange, numBins, sketchSize);
   }
   else
   {
-    std::vector<T> data;
+    std::vector<StorageType<T>> data;
     data.reserve(numTuples);
     for(size_t i = 0; i < numTuples; i++)
     {
-      if(useMask)
+      if(!useMask || mask[i])
       {
-        if(mask[i])
-        {
-          data.push_back(dataPtr[i]);
-        }
-      }
-      else
-      {
-        data.push_back(dataPtr[i]);
+        data.push_back(static_cast<StorageType<T>>(dataPtr[i]));
       }
     }
 
-    data.shrink_to_fit();
-
-    findStatisticsImpl(length, min, max, mean, median, stdDeviation, summation, arrays, data, hist, histmin, histmax, histfullrange, numBins);
+    findRangeStatistics<T>(data.data(), data.data() + data.size(), 0, arrays, percentiles, histmin, histmax, histfullrange, numBins);
   }
 }
 
@@ -721,7 +944,7 @@ void FindArrayStatistics::execute()
     return;
   }
 
-  if(!m_FindHistogram && !m_FindMin && !m_FindMax && !m_FindMean && !m_FindMedian && !m_FindStdDeviation && !m_FindSummation && !m_FindLength)
+  if(!m_FindHistogram && !m_FindMin && !m_FindMax && !m_FindMean && !m_FindMedian && !m_FindStdDeviation && !m_FindSummation && !m_FindLength && !m_FindPercentiles)
   {
     return;
   }
@@ -765,7 +988,7 @@ void FindArrayStatistics::execute()
     }
   }
 
-  std::vector<IDataArray::Pointer> arrays(8, nullptr);
+  std::vector<IDataArray::Pointer> arrays(9, nullptr);
 
   for(size_t i = 0; i < arrays.size(); i++)
   {
@@ -801,10 +1024,14 @@ void FindArrayStatistics::execute()
     {
       arrays[7] = m_HistogramListPtr.lock();
     }
+    if(m_FindPercentiles)
+    {
+      arrays[8] = m_PercentilesPtr.lock();
+    }
   }
 
-  EXECUTE_FUNCTION_TEMPLATE(this, findStatistics, m_InputArrayPtr.lock(), m_InputArrayPtr.lock(), m_FeatureIdsPtr.lock(), m_UseMask, m_Mask, m_FindLength, m_FindMin, m_FindMax, m_FindMean,
-                            m_FindMedian, m_FindStdDeviation, m_FindSummation, arrays, numFeatures, m_ComputeByIndex, m_FindHistogram, m_MinRange, m_MaxRange, m_UseFullRange, m_NumBins);
+  EXECUTE_FUNCTION_TEMPLATE(this, findStatistics, m_InputArrayPtr.lock(), m_InputArrayPtr.lock(), m_FeatureIdsPtr.lock(), m_UseMask, m_Mask, arrays, m_PercentileValues, numFeatures, m_ComputeByIndex,
+                            m_UseStreamingStatistics, m_QuantileSketchSize, m_MinRange, m_MaxRange, m_UseFullRange, m_NumBins);
 
   if(m_StandardizeData)
   {
@@ -1252,3 +1479,63 @@ DataArrayPath FindArrayStatistics::getFeatureIdsArrayPath() const
 {
   return m_FeatureIdsArrayPath;
 }
+
+// -----------------------------------------------------------------------------
+void FindArrayStatistics::setFindPercentiles(bool value)
+{
+  m_FindPercentiles = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindArrayStatistics::getFindPercentiles() const
+{
+  return m_FindPercentiles;
+}
+
+// -----------------------------------------------------------------------------
+void FindArrayStatistics::setPercentiles(const QString& value)
+{
+  m_Percentiles = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindArrayStatistics::getPercentiles() const
+{
+  return m_Percentiles;
+}
+
+// -----------------------------------------------------------------------------
+void FindArrayStatistics::setPercentilesArrayName(const QString& value)
+{
+  m_PercentilesArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindArrayStatistics::getPercentilesArrayName() const
+{
+  return m_PercentilesArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void FindArrayStatistics::setUseStreamingStatistics(bool value)
+{
+  m_UseStreamingStatistics = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindArrayStatistics::getUseStreamingStatistics() const
+{
+  return m_UseStreamingStatistics;
+}
+
+// -----------------------------------------------------------------------------
+void FindArrayStatistics::setQuantileSketchSize(int32_t value)
+{
+  m_QuantileSketchSize = value;
+}
+
+// -----------------------------------------------------------------------------
+int32_t FindArrayStatistics::getQuantileSketchSize() const
+{
+  return m_QuantileSketchSize;
+}
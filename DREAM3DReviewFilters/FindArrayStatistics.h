@@ -36,6 +36,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -88,6 +89,11 @@ class DREAM3DReview_EXPORT FindArrayStatistics : public AbstractFilter
   PYB11_PROPERTY(int32_t NumBins READ getNumBins WRITE setNumBins)
   PYB11_PROPERTY(float MinRange READ getMinRange WRITE setMinRange)
   PYB11_PROPERTY(float MaxRange READ getMaxRange WRITE setMaxRange)
+  PYB11_PROPERTY(bool FindPercentiles READ getFindPercentiles WRITE setFindPercentiles)
+  PYB11_PROPERTY(QString Percentiles READ getPercentiles WRITE setPercentiles)
+  PYB11_PROPERTY(QString PercentilesArrayName READ getPercentilesArrayName WRITE setPercentilesArrayName)
+  PYB11_PROPERTY(bool UseStreamingStatistics READ getUseStreamingStatistics WRITE setUseStreamingStatistics)
+  PYB11_PROPERTY(int32_t QuantileSketchSize READ getQuantileSketchSize WRITE setQuantileSketchSize)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -242,6 +248,28 @@ public:
   bool getFindSummation() const;
   Q_PROPERTY(bool FindSummation READ getFindSummation WRITE setFindSummation)
 
+  /**
+   * @brief Setter property for FindPercentiles
+   */
+  void setFindPercentiles(bool value);
+  /**
+   * @brief Getter property for FindPercentiles
+   * @return Value of FindPercentiles
+   */
+  bool getFindPercentiles() const;
+  Q_PROPERTY(bool FindPercentiles READ getFindPercentiles WRITE setFindPercentiles)
+
+  /**
+   * @brief Setter property for Percentiles, a comma separated list of percentiles between 0 and 100
+   */
+  void setPercentiles(const QString& value);
+  /**
+   * @brief Getter property for Percentiles
+   * @return Value of Percentiles
+   */
+  QString getPercentiles() const;
+  Q_PROPERTY(QString Percentiles READ getPercentiles WRITE setPercentiles)
+
   /**
    * @brief Setter property for UseMask
    */
@@ -275,6 +303,28 @@ public:
   bool getComputeByIndex() const;
   Q_PROPERTY(bool ComputeByIndex READ getComputeByIndex WRITE setComputeByIndex)
 
+  /**
+   * @brief Setter property for UseStreamingStatistics
+   */
+  void setUseStreamingStatistics(bool value);
+  /**
+   * @brief Getter property for UseStreamingStatistics
+   * @return Value of UseStreamingStatistics
+   */
+  bool getUseStreamingStatistics() const;
+  Q_PROPERTY(bool UseStreamingStatistics READ getUseStreamingStatistics WRITE setUseStreamingStatistics)
+
+  /**
+   * @brief Setter property for QuantileSketchSize
+   */
+  void setQuantileSketchSize(int32_t value);
+  /**
+   * @brief Getter property for QuantileSketchSize
+   * @return Value of QuantileSketchSize
+   */
+  int32_t getQuantileSketchSize() const;
+  Q_PROPERTY(int32_t QuantileSketchSize READ getQuantileSketchSize WRITE setQuantileSketchSize)
+
   /**
    * @brief Setter property for DestinationAttributeMatrix
    */
@@ -385,6 +435,17 @@ public:
   QString getSummationArrayName() const;
   Q_PROPERTY(QString SummationArrayName READ getSummationArrayName WRITE setSummationArrayName)
 
+  /**
+   * @brief Setter property for PercentilesArrayName
+   */
+  void setPercentilesArrayName(const QString& value);
+  /**
+   * @brief Getter property for PercentilesArrayName
+   * @return Value of PercentilesArrayName
+   */
+  QString getPercentilesArrayName() const;
+  Q_PROPERTY(QString PercentilesArrayName READ getPercentilesArrayName WRITE setPercentilesArrayName)
+
   /**
    * @brief Setter property for StandardizedArrayName
    */
@@ -514,6 +575,8 @@ private:
   bool* m_Mask = nullptr;
   std::weak_ptr<DataArray<float>> m_HistogramListPtr;
   float* m_HistogramList;
+  std::weak_ptr<DataArray<float>> m_PercentilesPtr;
+  std::vector<float> m_PercentileValues;
 
   // Histogram Related Parameters
   double m_MinRange = {};
@@ -532,6 +595,10 @@ private:
   bool m_UseMask = false;
   bool m_StandardizeData = false;
   bool m_ComputeByIndex = false;
+  bool m_FindPercentiles = false;
+  bool m_UseStreamingStatistics = false;
+  int32_t m_QuantileSketchSize = {200};
+  QString m_Percentiles = {"5, 25, 75, 95"};
 
   DataArrayPath m_DestinationAttributeMatrix = {"", "", ""};
   DataArrayPath m_MaskArrayPath = {"", "", "Mask"};
@@ -544,6 +611,7 @@ private:
   QString m_MedianArrayName = {"Median"};
   QString m_StdDeviationArrayName = {"StandardDeviation"};
   QString m_SummationArrayName = {"Summation"};
+  QString m_PercentilesArrayName = {"Percentiles"};
   QString m_StandardizedArrayName = {"Standardized"};
 
   DataArrayPath m_SelectedArrayPath = {};
@@ -37,9 +37,14 @@
 
 #include "FindCSLBoundaries.h"
 
+#include <algorithm>
+#include <array>
+#include <limits>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -52,18 +57,14 @@
 #include "SIMPLib/Math/GeometryMath.h"
 #include "SIMPLib/Math/MatrixMath.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/ParallelHelpers.hpp"
 
 //#include "Statistics/StatisticsConstants.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#endif
-
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -72,50 +73,69 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID32 = 32,
 };
 
-class CalculateCSLBoundaryImpl
+namespace
+{
+const uint64_t k_InvalidPair = std::numeric_limits<uint64_t>::max();
+
+/**
+ * @brief makePairKey Packs an ordered (feature1, feature2) pair into a single sortable key
+ */
+inline uint64_t makePairKey(int32_t feature1, int32_t feature2)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(feature1)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(feature2));
+}
+
+/**
+ * @brief The CSLMatch struct is one symmetric misorientation of a feature pair that lies within the CSL
+ * tolerances: the index of the first symmetry operator applied and the resulting misorientation axis.
+ */
+struct CSLMatch
+{
+  int32_t symOp;
+  std::array<double, 3> axis;
+};
+} // namespace
+
+/**
+ * @brief The FindCSLPairMatchesImpl class runs the nsym x nsym symmetry operator search once for each
+ * unique ordered feature pair. The search only depends on the two orientations, so the result is shared by
+ * every face separating the pair.
+ */
+class FindCSLPairMatchesImpl
 {
   int m_CSLIndex;
   float m_AxisTol;
   float m_AngTol;
-  int32_t* m_Labels;
-  double* m_Normals;
+  const std::vector<uint64_t>& m_PairKeys;
+  std::vector<std::vector<CSLMatch>>& m_PairMatches;
   int32_t* m_Phases;
   float* m_Quats;
-  bool* m_CSLBoundary;
-  float* m_CSLBoundaryIncoherence;
   unsigned int* m_CrystalStructures;
   LaueOpsContainer m_OrientationOps;
 
 public:
-  CalculateCSLBoundaryImpl(int cslindex, float angtol, float axistol, int32_t* Labels, double* Normals, float* Quats, int32_t* Phases, unsigned int* CrystalStructures, bool* CSLBoundary,
-                           float* CSLBoundaryIncoherence)
+  FindCSLPairMatchesImpl(int cslindex, float angtol, float axistol, const std::vector<uint64_t>& pairKeys, std::vector<std::vector<CSLMatch>>& pairMatches, float* Quats, int32_t* Phases,
+                         unsigned int* CrystalStructures)
   : m_CSLIndex(cslindex)
   , m_AxisTol(axistol)
   , m_AngTol(angtol)
-  , m_Labels(Labels)
-  , m_Normals(Normals)
+  , m_PairKeys(pairKeys)
+  , m_PairMatches(pairMatches)
   , m_Phases(Phases)
   , m_Quats(Quats)
-  , m_CSLBoundary(CSLBoundary)
-  , m_CSLBoundaryIncoherence(CSLBoundaryIncoherence)
   , m_CrystalStructures(CrystalStructures)
   {
     m_OrientationOps = LaueOps::GetAllOrientationOps();
   }
 
-  virtual ~CalculateCSLBoundaryImpl() = default;
+  virtual ~FindCSLPairMatchesImpl() = default;
 
   void generate(size_t start, size_t end) const
   {
-    int feature1, feature2;
-    double normal[3];
-    double g1[3][3];
     double w;
     unsigned int phase1, phase2;
 
     double axisdiffCSL, angdiffCSL;
-    double n[3];
-    double incoherence;
     double n1 = 0.0, n2 = 0.0, n3 = 0.0;
 
     QuatD misq;
@@ -123,8 +143,6 @@ public:
     QuatD s1_misq;
     QuatD s2_misq;
 
-    double xstl_norm[3];
-    std::array<double, 3> s_xstl_norm;
     double cslAxisNorm[3];
     double cslAxisNormDenom = 0.0;
     cslAxisNormDenom =
@@ -134,75 +152,161 @@ public:
       cslAxisNorm[i] = TransformationPhaseConstants::CSLAxisAngle[m_CSLIndex][i + 2] / cslAxisNormDenom;
     };
     for(size_t i = start; i < end; i++)
+    {
+      int32_t feature1 = static_cast<int32_t>(m_PairKeys[i] >> 32);
+      int32_t feature2 = static_cast<int32_t>(m_PairKeys[i] & 0xFFFFFFFF);
+
+      w = 10000.0;
+      float* quatPtr = m_Quats + feature1 * 4;
+      QuatD q1(quatPtr[0], quatPtr[1], quatPtr[2], quatPtr[3]);
+      quatPtr = m_Quats + feature2 * 4;
+      QuatD q2(quatPtr[0], quatPtr[1], quatPtr[2], quatPtr[3]);
+
+      phase1 = m_CrystalStructures[m_Phases[feature1]];
+      phase2 = m_CrystalStructures[m_Phases[feature2]];
+      if(phase1 != phase2)
+      {
+        continue;
+      }
+
+      std::vector<CSLMatch>& matches = m_PairMatches[i];
+      int nsym = m_OrientationOps[phase1]->getNumSymOps();
+      misq = q1 * (q2.conjugate());
+      for(int j = 0; j < nsym; j++)
+      {
+        sym_q = m_OrientationOps[phase1]->getQuatSymOp(j);
+        s1_misq = misq * sym_q;
+        for(int k = 0; k < nsym; k++)
+        {
+          // calculate the symmetric misorienation
+          sym_q = m_OrientationOps[phase1]->getQuatSymOp(k);
+          s2_misq = sym_q.conjugate() * s1_misq;
+
+          OrientationTransformation::qu2ax<QuatD, OrientationD>(s2_misq).toAxisAngle(n1, n2, n3, w);
+          w = w * 180.0 / SIMPLib::Constants::k_PiD;
+          axisdiffCSL = std::acos(std::fabs(n1) * cslAxisNorm[0] + std::fabs(n2) * cslAxisNorm[1] + std::fabs(n3) * cslAxisNorm[2]);
+          angdiffCSL = std::fabs(w - TransformationPhaseConstants::CSLAxisAngle[m_CSLIndex][1]);
+          if(axisdiffCSL < m_AxisTol && angdiffCSL < m_AngTol)
+          {
+            matches.push_back({j, {n1, n2, n3}});
+          }
+        }
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    generate(range.min(), range.max());
+  }
+};
+
+/**
+ * @brief The CalculateCSLBoundaryImpl class classifies each face by looking up the cached matches of its
+ * feature pair; only the incoherence check against the face normal is evaluated per face.
+ */
+class CalculateCSLBoundaryImpl
+{
+  const std::vector<uint64_t>& m_PairKeys;
+  const std::vector<std::vector<CSLMatch>>& m_PairMatches;
+  int32_t* m_Labels;
+  double* m_Normals;
+  int32_t* m_Phases;
+  float* m_Quats;
+  bool* m_CSLBoundary;
+  float* m_CSLBoundaryIncoherence;
+  unsigned int* m_CrystalStructures;
+  LaueOpsContainer m_OrientationOps;
+
+public:
+  CalculateCSLBoundaryImpl(const std::vector<uint64_t>& pairKeys, const std::vector<std::vector<CSLMatch>>& pairMatches, int32_t* Labels, double* Normals, float* Quats, int32_t* Phases,
+                           unsigned int* CrystalStructures, bool* CSLBoundary, float* CSLBoundaryIncoherence)
+  : m_PairKeys(pairKeys)
+  , m_PairMatches(pairMatches)
+  , m_Labels(Labels)
+  , m_Normals(Normals)
+  , m_Phases(Phases)
+  , m_Quats(Quats)
+  , m_CSLBoundary(CSLBoundary)
+  , m_CSLBoundaryIncoherence(CSLBoundaryIncoherence)
+  , m_CrystalStructures(CrystalStructures)
+  {
+    m_OrientationOps = LaueOps::GetAllOrientationOps();
+  }
+
+  virtual ~CalculateCSLBoundaryImpl() = default;
+
+  void generate(size_t start, size_t end) const
+  {
+    int feature1, feature2;
+    double normal[3];
+    double g1[3][3];
+    double n[3];
+    double incoherence;
+
+    QuatD sym_q;
+
+    double xstl_norm[3];
+    std::array<double, 3> s_xstl_norm;
+    for(size_t i = start; i < end; i++)
     {
       feature1 = m_Labels[2 * i];
       feature2 = m_Labels[2 * i + 1];
+      // different than Find Twin Boundaries here because will only compare if
+      // the features are different phases
+      if(feature1 <= 0 || feature2 <= 0) // || m_Phases[feature1] == m_Phases[feature2])
+      {
+        continue;
+      }
+
+      uint64_t key = makePairKey(feature1, feature2);
+      auto pairIter = std::lower_bound(m_PairKeys.begin(), m_PairKeys.end(), key);
+      const std::vector<CSLMatch>& matches = m_PairMatches[pairIter - m_PairKeys.begin()];
+      if(matches.empty())
+      {
+        continue;
+      }
+
       normal[0] = m_Normals[3 * i];
       normal[1] = m_Normals[3 * i + 1];
       normal[2] = m_Normals[3 * i + 2];
-      // different than Find Twin Boundaries here because will only compare if
-      // the features are different phases
-      if(feature1 > 0 && feature2 > 0) // && m_Phases[feature1] != m_Phases[feature2])
+      float* quatPtr = m_Quats + feature1 * 4;
+      QuatD q1(quatPtr[0], quatPtr[1], quatPtr[2], quatPtr[3]);
+      unsigned int phase1 = m_CrystalStructures[m_Phases[feature1]];
+      OrientationTransformation::qu2om<QuatD, OrientationD>(q1).toGMatrix(g1);
+      MatrixMath::Multiply3x3with3x1(g1, normal, xstl_norm);
+
+      m_CSLBoundary[i] = true;
+      int32_t lastSymOp = -1;
+      for(const CSLMatch& match : matches)
       {
-        w = 10000.0;
-        float* quatPtr = m_Quats + feature1 * 4;
-        QuatD q1(quatPtr[0], quatPtr[1], quatPtr[2], quatPtr[3]);
-        quatPtr = m_Quats + feature2 * 4;
-        QuatD q2(quatPtr[0], quatPtr[1], quatPtr[2], quatPtr[3]);
-
-        phase1 = m_CrystalStructures[m_Phases[feature1]];
-        phase2 = m_CrystalStructures[m_Phases[feature2]];
-        if(phase1 == phase2)
+        // calculate crystal direction parallel to normal
+        if(match.symOp != lastSymOp)
         {
-          int nsym = m_OrientationOps[phase1]->getNumSymOps();
-          misq = q1 * (q2.conjugate());
-          OrientationTransformation::qu2om<QuatD, OrientationD>(q1).toGMatrix(g1);
-          MatrixMath::Multiply3x3with3x1(g1, normal, xstl_norm);
-          for(int j = 0; j < nsym; j++)
-          {
-            sym_q = m_OrientationOps[phase1]->getQuatSymOp(j);
-            // calculate crystal direction parallel to normal
-            s1_misq = misq * sym_q;
-            s_xstl_norm = sym_q.multiplyByVector(xstl_norm);
-            for(int k = 0; k < nsym; k++)
-            {
-              // calculate the symmetric misorienation
-              sym_q = m_OrientationOps[phase1]->getQuatSymOp(k);
-              s2_misq = sym_q.conjugate() * s1_misq;
-
-              OrientationTransformation::qu2ax<QuatD, OrientationD>(s2_misq).toAxisAngle(n1, n2, n3, w);
-              w = w * 180.0 / SIMPLib::Constants::k_PiD;
-              axisdiffCSL = std::acos(std::fabs(n1) * cslAxisNorm[0] + std::fabs(n2) * cslAxisNorm[1] + std::fabs(n3) * cslAxisNorm[2]);
-              angdiffCSL = std::fabs(w - TransformationPhaseConstants::CSLAxisAngle[m_CSLIndex][1]);
-              if(axisdiffCSL < m_AxisTol && angdiffCSL < m_AngTol)
-              {
-                n[0] = n1;
-                n[1] = n2;
-                n[2] = n3;
-                m_CSLBoundary[i] = true;
-                incoherence = 180.0 * std::acos(GeometryMath::CosThetaBetweenVectors(n, s_xstl_norm.data())) / SIMPLib::Constants::k_PiD;
-                if(incoherence > 90.0)
-                {
-                  incoherence = 180.0 - incoherence;
-                }
-                if(incoherence < m_CSLBoundaryIncoherence[i])
-                {
-                  m_CSLBoundaryIncoherence[i] = incoherence;
-                }
-              }
-            }
-          }
+          sym_q = m_OrientationOps[phase1]->getQuatSymOp(match.symOp);
+          s_xstl_norm = sym_q.multiplyByVector(xstl_norm);
+          lastSymOp = match.symOp;
+        }
+        n[0] = match.axis[0];
+        n[1] = match.axis[1];
+        n[2] = match.axis[2];
+        incoherence = 180.0 * std::acos(GeometryMath::CosThetaBetweenVectors(n, s_xstl_norm.data())) / SIMPLib::Constants::k_PiD;
+        if(incoherence > 90.0)
+        {
+          incoherence = 180.0 - incoherence;
+        }
+        if(incoherence < m_CSLBoundaryIncoherence[i])
+        {
+          m_CSLBoundaryIncoherence[i] = incoherence;
         }
       }
     }
   }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
+  void operator()(const SIMPLRange& range) const
   {
-    generate(r.begin(), r.end());
+    generate(range.min(), range.max());
   }
-#endif
 };
 
 // -----------------------------------------------------------------------------
@@ -389,22 +493,44 @@ void FindCSLBoundaries::execute()
   float angtol = m_AngleTolerance;
   float axistol = static_cast<float>(m_AxisTolerance * M_PI / 180.0f);
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  if(true)
+  // Collect the unique ordered feature pairs that bound the faces. The misorientation search only depends
+  // on the pair, so it runs once per pair and every face is classified by a lookup plus its normal check.
+  std::vector<uint64_t> pairKeys(numTriangles, k_InvalidPair);
+  ParallelDataAlgorithm keysAlg;
+  keysAlg.setRange(0, numTriangles);
+  keysAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      int32_t feature1 = m_SurfaceMeshFaceLabels[2 * i];
+      int32_t feature2 = m_SurfaceMeshFaceLabels[2 * i + 1];
+      if(feature1 > 0 && feature2 > 0)
+      {
+        pairKeys[i] = makePairKey(feature1, feature2);
+      }
+    }
+  });
+  ParallelHelpers::sort(pairKeys.begin(), pairKeys.end());
+  pairKeys.erase(std::unique(pairKeys.begin(), pairKeys.end()), pairKeys.end());
+  if(!pairKeys.empty() && pairKeys.back() == k_InvalidPair)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles),
-                      CalculateCSLBoundaryImpl(cslindex, angtol, axistol, m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_AvgQuats, m_FeaturePhases, m_CrystalStructures, m_SurfaceMeshCSLBoundary,
-                                               m_SurfaceMeshCSLBoundaryIncoherence),
-                      tbb::auto_partitioner());
+    pairKeys.pop_back();
   }
-  else
-#endif
+
+  std::vector<std::vector<CSLMatch>> pairMatches(pairKeys.size());
+  ParallelDataAlgorithm pairsAlg;
+  pairsAlg.setRange(0, pairKeys.size());
+  pairsAlg.execute(FindCSLPairMatchesImpl(cslindex, angtol, axistol, pairKeys, pairMatches, m_AvgQuats, m_FeaturePhases, m_CrystalStructures));
+
+  if(getCancel())
   {
-    CalculateCSLBoundaryImpl serial(cslindex, angtol, axistol, m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_AvgQuats, m_FeaturePhases, m_CrystalStructures, m_SurfaceMeshCSLBoundary,
-                                    m_SurfaceMeshCSLBoundaryIncoherence);
-    serial.generate(0, numTriangles);
+    return;
   }
 
+  ParallelDataAlgorithm facesAlg;
+  facesAlg.setRange(0, numTriangles);
+  facesAlg.execute(CalculateCSLBoundaryImpl(pairKeys, pairMatches, m_SurfaceMeshFaceLabels, m_SurfaceMeshFaceNormals, m_AvgQuats, m_FeaturePhases, m_CrystalStructures, m_SurfaceMeshCSLBoundary,
+                                            m_SurfaceMeshCSLBoundaryIncoherence));
+
   notifyStatusMessage("FindCSLBoundaries Completed");
 }
 
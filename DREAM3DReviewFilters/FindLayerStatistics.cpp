@@ -13,15 +13,15 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindLayerStatistics.h"
 
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#endif
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/Common/TemplateHelpers.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
@@ -33,104 +33,326 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
+namespace
+{
+// Independent accumulators per row kernel; enough lanes for the compiler to map the reductions onto vector registers
+constexpr size_t k_Lanes = 8;
+// Target number of parallel tasks, so thin stacks of wide layers still spread over all cores
+constexpr size_t k_TargetTasks = 256;
+// Upper bound on the partial moments kept for layers normal to x
+constexpr size_t k_MaxPartials = 1 << 18;
+
 /**
- * @brief The CalcProjectedStatsImpl class implements a templated threaded algorithm for
- * determining the projected image statistics of a given volume.
+ * @brief The LayerMoments struct holds the running count, mean, sum of squared deviations (M2), min and max of
+ * the values of a layer. Partial results are combined with the pairwise update of Chan et al., so layers can be
+ * reduced in any number of independent pieces.
+ */
+struct LayerMoments
+{
+  double count = 0.0;
+  double mean = 0.0;
+  double m2 = 0.0;
+  double min = std::numeric_limits<double>::max();
+  double max = std::numeric_limits<double>::lowest();
+
+  /**
+   * @brief fromShiftedSums Builds the moments of count values from their sums s1 and s2 of (value - shift) and
+   * (value - shift)^2. Shifting by a value of the same data keeps the cancellation in s2 - s1 * s1 / count small.
+   */
+  static LayerMoments fromShiftedSums(double count, double shift, double s1, double s2, double min, double max)
+  {
+    LayerMoments moments;
+    if(count > 0.0)
+    {
+      moments.count = count;
+      moments.mean = shift + s1 / count;
+      moments.m2 = std::max(s2 - s1 * s1 / count, 0.0);
+      moments.min = min;
+      moments.max = max;
+    }
+    return moments;
+  }
+
+  void merge(const LayerMoments& other)
+  {
+    if(other.count == 0.0)
+    {
+      return;
+    }
+    if(count == 0.0)
+    {
+      *this = other;
+      return;
+    }
+    double total = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * other.count / total;
+    m2 += other.m2 + delta * delta * count * other.count / total;
+    count = total;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+  }
+};
+
+/**
+ * @brief rowMoments Single pass over a contiguous row. Only positive values are counted. The loop carries k_Lanes
+ * independent sums and selects instead of branches, so it vectorizes without reassociating floating point math.
  */
 template <typename T>
-class CalcLayerStatsImpl
+LayerMoments rowMoments(const T* row, size_t length)
 {
+  // Shift by the first counted value of the row
+  size_t first = 0;
+  while(first < length && !(static_cast<double>(row[first]) > 0.0))
+  {
+    first++;
+  }
+  if(first == length)
+  {
+    return LayerMoments();
+  }
+  double shift = static_cast<double>(row[first]);
+
+  double count[k_Lanes] = {};
+  double s1[k_Lanes] = {};
+  double s2[k_Lanes] = {};
+  double min[k_Lanes];
+  double max[k_Lanes];
+  std::fill(min, min + k_Lanes, std::numeric_limits<double>::max());
+  std::fill(max, max + k_Lanes, std::numeric_limits<double>::lowest());
 
+  size_t i = first;
+  for(; i + k_Lanes <= length; i += k_Lanes)
+  {
+    for(size_t l = 0; l < k_Lanes; l++)
+    {
+      double value = static_cast<double>(row[i + l]);
+      bool valid = value > 0.0;
+      double delta = valid ? value - shift : 0.0;
+      count[l] += valid ? 1.0 : 0.0;
+      s1[l] += delta;
+      s2[l] += delta * delta;
+      min[l] = std::min(min[l], valid ? value : std::numeric_limits<double>::max());
+      max[l] = std::max(max[l], valid ? value : std::numeric_limits<double>::lowest());
+    }
+  }
+  for(; i < length; i++)
+  {
+    double value = static_cast<double>(row[i]);
+    if(value > 0.0)
+    {
+      double delta = value - shift;
+      count[0] += 1.0;
+      s1[0] += delta;
+      s2[0] += delta * delta;
+      min[0] = std::min(min[0], value);
+      max[0] = std::max(max[0], value);
+    }
+  }
+
+  for(size_t l = 1; l < k_Lanes; l++)
+  {
+    count[0] += count[l];
+    s1[0] += s1[l];
+    s2[0] += s2[l];
+    min[0] = std::min(min[0], min[l]);
+    max[0] = std::max(max[0], max[l]);
+  }
+  return LayerMoments::fromShiftedSums(count[0], shift, s1[0], s2[0], min[0], max[0]);
+}
+
+/**
+ * @brief The ColumnMoments class accumulates element wise moments over a run of rows, one set per position along
+ * the row. It is used for layers normal to x, where every element of a row belongs to a different layer; the
+ * inner loop runs along the row and vectorizes the same way rowMoments does.
+ */
+class ColumnMoments
+{
 public:
-  CalcLayerStatsImpl(T* data, float* min, float* max, float* avg, float* std, float* var, int32_t* startPoints, size_t* stride, size_t* dims)
-  : m_Data(data)
-  , m_Min(min)
-  , m_Max(max)
-  , m_Avg(avg)
-  , m_Std(std)
-  , m_Var(var)
-  , m_StartPoints(startPoints)
-  , m_Stride(stride)
-  , m_Dims(dims)
+  explicit ColumnMoments(size_t length)
+  : m_Shift(length, 0.0)
+  , m_Count(length, 0.0)
+  , m_S1(length, 0.0)
+  , m_S2(length, 0.0)
+  , m_Min(length, std::numeric_limits<double>::max())
+  , m_Max(length, std::numeric_limits<double>::lowest())
   {
   }
-  virtual ~CalcLayerStatsImpl()
+
+  // The first row fixes the shift of every column
+  template <typename T>
+  void setShift(const T* row)
   {
+    for(size_t i = 0; i < m_Shift.size(); i++)
+    {
+      double value = static_cast<double>(row[i]);
+      m_Shift[i] = value > 0.0 ? value : 0.0;
+    }
   }
 
-  void convert(size_t start, size_t end) const
+  template <typename T>
+  void add(const T* row)
   {
-    size_t shift = 0;
-    size_t count = 0;
-    size_t point = 0, newPoint = 0;
-    T val = static_cast<T>(0);
-    for(size_t i = start; i < end; i++)
+    size_t length = m_Shift.size();
+    for(size_t i = 0; i < length; i++)
     {
-      count = 0;
-      point = m_StartPoints[i];
-      for(size_t k = 0; k < m_Dims[1]; k++)
+      double value = static_cast<double>(row[i]);
+      bool valid = value > 0.0;
+      double delta = valid ? value - m_Shift[i] : 0.0;
+      m_Count[i] += valid ? 1.0 : 0.0;
+      m_S1[i] += delta;
+      m_S2[i] += delta * delta;
+      m_Min[i] = std::min(m_Min[i], valid ? value : std::numeric_limits<double>::max());
+      m_Max[i] = std::max(m_Max[i], valid ? value : std::numeric_limits<double>::lowest());
+    }
+  }
+
+  LayerMoments moments(size_t i) const
+  {
+    return LayerMoments::fromShiftedSums(m_Count[i], m_Shift[i], m_S1[i], m_S2[i], m_Min[i], m_Max[i]);
+  }
+
+private:
+  std::vector<double> m_Shift;
+  std::vector<double> m_Count;
+  std::vector<double> m_S1;
+  std::vector<double> m_S2;
+  std::vector<double> m_Min;
+  std::vector<double> m_Max;
+};
+
+struct LayerOutputs
+{
+  int32_t* layerIds;
+  float* min;
+  float* max;
+  float* avg;
+  float* std;
+  float* var;
+};
+
+/**
+ * @brief calcLayerStats Computes the statistics of the positive values of every layer normal to the given axis
+ * (0 = z, 1 = y, 2 = x, matching the XY, XZ and YZ choices). The volume is cut into runs of contiguous x rows, so
+ * work is split within layers as well as across them; the partial moments are merged in a fixed order, which
+ * keeps the result independent of the thread count.
+ */
+template <typename T>
+void calcLayerStats(IDataArray::Pointer inDataPtr, unsigned int plane, const SizeVec3Type& dims, const LayerOutputs& out)
+{
+  typename DataArray<T>::Pointer input = std::dynamic_pointer_cast<DataArray<T>>(inDataPtr);
+  const T* data = input->getPointer(0);
+
+  size_t dimX = dims[0];
+  size_t numRows = dims[1] * dims[2];
+  size_t numLayers = plane == 0 ? dims[2] : (plane == 1 ? dims[1] : dims[0]);
+
+  std::vector<LayerMoments> layers(numLayers);
+
+  if(plane == 2)
+  {
+    // Layers normal to x: runs of rows each produce moments for every layer, merged per layer afterwards
+    size_t numBlocks = std::max(static_cast<size_t>(1), std::min({numRows, k_TargetTasks, k_MaxPartials / dimX}));
+    std::vector<LayerMoments> partials(numBlocks * numLayers);
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numBlocks);
+    dataAlg.execute([&](const SIMPLRange& range) {
+      for(size_t block = range.min(); block < range.max(); block++)
       {
-        shift = k * m_Stride[1];
-        for(size_t j = 0; j < m_Dims[0]; j++)
+        size_t rowBegin = block * numRows / numBlocks;
+        size_t rowEnd = (block + 1) * numRows / numBlocks;
+        ColumnMoments columns(dimX);
+        columns.setShift(data + rowBegin * dimX);
+        for(size_t row = rowBegin; row < rowEnd; row++)
         {
-          newPoint = static_cast<int32_t>(point + shift + (j * m_Stride[0]));
-          val = m_Data[newPoint];
-          if(val > 0.0)
-          {
-            if(val < m_Min[i])
-            {
-              m_Min[i] = val;
-            }
-            if(val > m_Max[i])
-            {
-              m_Max[i] = val;
-            }
-            m_Avg[i] += val;
-            count++;
-          }
+          columns.add(data + row * dimX);
+        }
+        for(size_t x = 0; x < dimX; x++)
+        {
+          partials[block * numLayers + x] = columns.moments(x);
+        }
+      }
+    });
+
+    dataAlg.setRange(0, numLayers);
+    dataAlg.execute([&](const SIMPLRange& range) {
+      for(size_t layer = range.min(); layer < range.max(); layer++)
+      {
+        for(size_t block = 0; block < numBlocks; block++)
+        {
+          layers[layer].merge(partials[block * numLayers + layer]);
         }
       }
-      m_Avg[i] /= count;
-      for(size_t k = 0; k < m_Dims[1]; k++)
+    });
+  }
+  else
+  {
+    // Layers normal to z or y: every row lies in one layer, and the rows of each layer are split into blocks
+    size_t rowsPerLayer = plane == 0 ? dims[1] : dims[2];
+    size_t blocksPerLayer = std::max(static_cast<size_t>(1), std::min(rowsPerLayer, (k_TargetTasks + numLayers - 1) / numLayers));
+    std::vector<LayerMoments> partials(numLayers * blocksPerLayer);
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, partials.size());
+    dataAlg.execute([&](const SIMPLRange& range) {
+      for(size_t task = range.min(); task < range.max(); task++)
       {
-        shift = k * m_Stride[1];
-        for(size_t j = 0; j < m_Dims[0]; j++)
+        size_t layer = task / blocksPerLayer;
+        size_t block = task % blocksPerLayer;
+        size_t rowBegin = block * rowsPerLayer / blocksPerLayer;
+        size_t rowEnd = (block + 1) * rowsPerLayer / blocksPerLayer;
+        LayerMoments moments;
+        for(size_t r = rowBegin; r < rowEnd; r++)
         {
-          newPoint = static_cast<int32_t>(point + shift + (j * m_Stride[0]));
-          val = m_Data[newPoint];
-          if(val > 0.0)
-          {
-            m_Std[i] += ((val - m_Avg[i]) * (val - m_Avg[i]));
-          }
+          size_t row = plane == 0 ? layer * dims[1] + r : r * dims[1] + layer;
+          moments.merge(rowMoments(data + row * dimX, dimX));
         }
+        partials[task] = moments;
+      }
+    });
+
+    for(size_t layer = 0; layer < numLayers; layer++)
+    {
+      for(size_t block = 0; block < blocksPerLayer; block++)
+      {
+        layers[layer].merge(partials[layer * blocksPerLayer + block]);
       }
-      m_Std[i] /= count;
-      m_Var[i] = m_Std[i];
-      m_Std[i] = sqrt(m_Std[i]);
     }
   }
 
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
-  {
-    convert(r.begin(), r.end());
+  // Layers without any positive value are reported as zero
+  for(size_t layer = 0; layer < numLayers; layer++)
+  {
+    const LayerMoments& moments = layers[layer];
+    bool empty = moments.count == 0.0;
+    double var = empty ? 0.0 : moments.m2 / moments.count;
+    out.min[layer] = empty ? 0.0f : static_cast<float>(moments.min);
+    out.max[layer] = empty ? 0.0f : static_cast<float>(moments.max);
+    out.avg[layer] = static_cast<float>(moments.mean);
+    out.var[layer] = static_cast<float>(var);
+    out.std[layer] = static_cast<float>(std::sqrt(var));
   }
-#endif
-private:
-  T* m_Data;
-  float* m_Min;
-  float* m_Max;
-  float* m_Avg;
-  float* m_Std;
-  float* m_Var;
-  int32_t* m_StartPoints;
-  size_t* m_Stride;
-  size_t* m_Dims;
-};
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numRows);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t row = range.min(); row < range.max(); row++)
+    {
+      int32_t* ids = out.layerIds + row * dimX;
+      for(size_t x = 0; x < dimX; x++)
+      {
+        ids[x] = static_cast<int32_t>(plane == 0 ? row / dims[1] : (plane == 1 ? row % dims[1] : x));
+      }
+    }
+  });
+}
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -321,239 +543,19 @@ void FindLayerStatistics::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getSelectedArrayPath().getDataContainerName());
+  SizeVec3Type dims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
-  SizeVec3Type dimsP = m->getGeometryAs<ImageGeom>()->getDimensions();
-
-  Int32ArrayType::Pointer startingPoints = Int32ArrayType::CreateArray(0, std::string("_INTERNAL_USE_ONLY_startingPoints"), true);
-  int32_t* startPoints = nullptr;
-  size_t stride[2];
-  size_t dims[2];
-  // size_t yStride = 0;
-  size_t depth = 0;
-  if(m_Plane == 0)
-  {
-    startingPoints->resizeTuples(dimsP[2]);
-    startPoints = startingPoints->getPointer(0);
-    stride[0] = 1;
-    stride[1] = dimsP[0];
-    dims[0] = dimsP[0];
-    dims[1] = dimsP[1];
-    depth = dimsP[2];
-    for(size_t i = 0; i < dimsP[2]; i++)
-    {
-      startPoints[i] = i * (dimsP[0] * dimsP[1]);
-    }
-  }
-  if(m_Plane == 1)
-  {
-    startingPoints->resizeTuples(dimsP[1]);
-    startPoints = startingPoints->getPointer(0);
-    stride[0] = 1;
-    stride[1] = (dimsP[0] * dimsP[1]);
-    dims[0] = dimsP[0];
-    dims[1] = dimsP[2];
-    depth = dimsP[1];
-    for(size_t i = 0; i < dimsP[1]; i++)
-    {
-      startPoints[i] = i * dimsP[0];
-    }
-  }
-  if(m_Plane == 2)
-  {
-    startingPoints->resizeTuples(dimsP[0]);
-    startPoints = startingPoints->getPointer(0);
-    stride[0] = dimsP[0];
-    stride[1] = (dimsP[0] * dimsP[1]);
-    dims[0] = dimsP[1];
-    dims[1] = dimsP[2];
-    depth = dimsP[0];
-    for(size_t i = 0; i < dimsP[0]; i++)
-    {
-      startPoints[i] = i;
-    }
-  }
-
-  if(nullptr == startPoints)
+  if(m_Plane > 2)
   {
     QString ss = QObject::tr("Unable to establish starting location for supplied plane. The plane is %1").arg(m_Plane);
     setErrorCondition(-11001, ss);
     return;
   }
 
-  if(TemplateHelpers::CanDynamicCast<Int8ArrayType>()(m_InDataPtr.lock()))
-  {
-    Int8ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int8ArrayType>(m_InDataPtr.lock());
-    int8_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<int8_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<int8_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<UInt8ArrayType>()(m_InDataPtr.lock()))
-  {
-    UInt8ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt8ArrayType>(m_InDataPtr.lock());
-    uint8_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<uint8_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<uint8_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<Int16ArrayType>()(m_InDataPtr.lock()))
-  {
-    Int16ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int16ArrayType>(m_InDataPtr.lock());
-    int16_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<int16_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<int16_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<UInt16ArrayType>()(m_InDataPtr.lock()))
-  {
-    UInt16ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt16ArrayType>(m_InDataPtr.lock());
-    uint16_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<uint16_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<uint16_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<Int32ArrayType>()(m_InDataPtr.lock()))
-  {
-    Int32ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int32ArrayType>(m_InDataPtr.lock());
-    int32_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<int32_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<int32_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<UInt32ArrayType>()(m_InDataPtr.lock()))
-  {
-    UInt32ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt32ArrayType>(m_InDataPtr.lock());
-    uint32_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<uint32_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<uint32_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<Int64ArrayType>()(m_InDataPtr.lock()))
-  {
-    Int64ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int64ArrayType>(m_InDataPtr.lock());
-    int64_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<int64_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<int64_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<UInt64ArrayType>()(m_InDataPtr.lock()))
-  {
-    UInt64ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt64ArrayType>(m_InDataPtr.lock());
-    uint64_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<uint64_t>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<uint64_t> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<FloatArrayType>()(m_InDataPtr.lock()))
-  {
-    FloatArrayType::Pointer cellArray = std::dynamic_pointer_cast<FloatArrayType>(m_InDataPtr.lock());
-    float* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<float>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<float> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else if(TemplateHelpers::CanDynamicCast<DoubleArrayType>()(m_InDataPtr.lock()))
-  {
-    DoubleArrayType::Pointer cellArray = std::dynamic_pointer_cast<DoubleArrayType>(m_InDataPtr.lock());
-    double* cPtr = cellArray->getPointer(0);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if(doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(0, depth), CalcLayerStatsImpl<double>(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims),
-                        tbb::auto_partitioner());
-    }
-    else
-#endif
-    {
-      CalcLayerStatsImpl<double> serial(cPtr, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar, startPoints, stride, dims);
-      serial.convert(0, depth);
-    }
-  }
-  else
+  LayerOutputs outputs = {m_LayerIDs, m_LayerMin, m_LayerMax, m_LayerAvg, m_LayerStd, m_LayerVar};
+  EXECUTE_FUNCTION_TEMPLATE_NO_BOOL(DataArray, this, calcLayerStats, m_InDataPtr.lock(), m_InDataPtr.lock(), m_Plane, dims, outputs)
+  if(getErrorCode() < 0)
   {
-    QString ss = QObject::tr("Selected array is of unsupported type. The type is %1").arg(m_InDataPtr.lock()->getTypeAsString());
-    setErrorCondition(-11001, ss);
     return;
   }
 
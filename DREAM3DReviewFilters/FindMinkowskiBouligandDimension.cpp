@@ -14,21 +14,215 @@
 
 #include "FindMinkowskiBouligandDimension.h"
 
+#include <algorithm>
+#include <bitset>
 #include <cmath>
-#include <cstring>
+#include <cstdint>
+#include <numeric>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/ParallelHelpers.hpp"
+
+namespace
+{
+/**
+ * @brief The OccupancyGrid struct is one level of the box counting pyramid: a cube (a square in 2D) of boxes with
+ * one occupancy bit per box, packed along x into rows of 64 bit words
+ */
+struct OccupancyGrid
+{
+  OccupancyGrid(size_t edge, bool is3D)
+  : side(edge)
+  , numRows(is3D ? edge * edge : edge)
+  , wordsPerRow((edge + 63) / 64)
+  , words(numRows * wordsPerRow, 0)
+  {
+  }
+
+  size_t side;
+  size_t numRows;
+  size_t wordsPerRow;
+  std::vector<uint64_t> words;
+};
+
+/**
+ * @brief The FeatureBoxes struct is one level of the per feature box pyramid: the sorted ids of the features found
+ * in every box, stored as offsets into one flat id list
+ */
+struct FeatureBoxes
+{
+  size_t side = 0;
+  std::vector<size_t> offsets;
+  std::vector<int32_t> ids;
+};
+
+// std::bitset::count lowers to a popcount instruction where the target has one
+size_t countBits(uint64_t word)
+{
+  return std::bitset<64>(word).count();
+}
+
+// Gathers the even bits of a word into its low 32 bits
+uint64_t compactEvenBits(uint64_t x)
+{
+  x &= 0x5555555555555555ULL;
+  x = (x | (x >> 1)) & 0x3333333333333333ULL;
+  x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+  x = (x | (x >> 4)) & 0x00FF00FF00FF00FFULL;
+  x = (x | (x >> 8)) & 0x0000FFFF0000FFFFULL;
+  x = (x | (x >> 16)) & 0x00000000FFFFFFFFULL;
+  return x;
+}
+
+/**
+ * @brief coarsen Fills the next coarser pyramid level, where every box is the OR of its 2x2(x2) children: the
+ * children rows are OR-ed word by word, then neighboring bits are OR-ed and the even bits packed together
+ * @param fine
+ * @param coarse
+ * @param is3D
+ * @return Number of occupied boxes of the coarse level
+ */
+size_t coarsen(const OccupancyGrid& fine, OccupancyGrid& coarse, bool is3D)
+{
+  std::vector<size_t> rowCounts(coarse.numRows, 0);
+  size_t zChildren = is3D ? 2 : 1;
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, coarse.numRows);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    std::vector<uint64_t> merged(fine.wordsPerRow);
+    for(size_t row = range.min(); row < range.max(); row++)
+    {
+      size_t y = row % coarse.side;
+      size_t z = row / coarse.side;
+      std::fill(merged.begin(), merged.end(), 0);
+      for(size_t dz = 0; dz < zChildren; dz++)
+      {
+        for(size_t dy = 0; dy < 2; dy++)
+        {
+          const uint64_t* source = fine.words.data() + ((2 * z + dz) * fine.side + 2 * y + dy) * fine.wordsPerRow;
+          for(size_t w = 0; w < fine.wordsPerRow; w++)
+          {
+            merged[w] |= source[w];
+          }
+        }
+      }
+
+      uint64_t* sink = coarse.words.data() + row * coarse.wordsPerRow;
+      size_t count = 0;
+      for(size_t w = 0; w < coarse.wordsPerRow; w++)
+      {
+        uint64_t word = compactEvenBits(merged[2 * w] | (merged[2 * w] >> 1));
+        if(2 * w + 1 < fine.wordsPerRow)
+        {
+          word |= compactEvenBits(merged[2 * w + 1] | (merged[2 * w + 1] >> 1)) << 32;
+        }
+        sink[w] = word;
+        count += countBits(word);
+      }
+      rowCounts[row] = count;
+    }
+  });
+
+  return std::accumulate(rowCounts.begin(), rowCounts.end(), static_cast<size_t>(0));
+}
+
+/**
+ * @brief coarsenFeatures Builds a per feature pyramid level of the given edge length by merging the feature ids of
+ * the 2x2(x2) children of every box
+ * @param side Edge length of the new level
+ * @param is3D
+ * @param appendChild Callable (x, y, z, ids) that appends the feature ids of a box of the finer level to ids
+ * @return
+ */
+template <typename AppendChild>
+FeatureBoxes coarsenFeatures(size_t side, bool is3D, AppendChild appendChild)
+{
+  size_t numRows = is3D ? side * side : side;
+  size_t zChildren = is3D ? 2 : 1;
+
+  FeatureBoxes coarse;
+  coarse.side = side;
+  coarse.offsets.assign(numRows * side + 1, 0);
+  std::vector<std::vector<int32_t>> rowIds(numRows);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numRows);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    std::vector<int32_t> buffer;
+    for(size_t row = range.min(); row < range.max(); row++)
+    {
+      size_t y = row % side;
+      size_t z = row / side;
+      std::vector<int32_t>& ids = rowIds[row];
+      for(size_t x = 0; x < side; x++)
+      {
+        buffer.clear();
+        for(size_t dz = 0; dz < zChildren; dz++)
+        {
+          for(size_t dy = 0; dy < 2; dy++)
+          {
+            for(size_t dx = 0; dx < 2; dx++)
+            {
+              appendChild(2 * x + dx, 2 * y + dy, 2 * z + dz, buffer);
+            }
+          }
+        }
+        std::sort(buffer.begin(), buffer.end());
+        auto last = std::unique(buffer.begin(), buffer.end());
+        coarse.offsets[row * side + x] = static_cast<size_t>(last - buffer.begin());
+        ids.insert(ids.end(), buffer.begin(), last);
+      }
+    }
+  });
+
+  coarse.ids.resize(ParallelHelpers::exclusiveScan(coarse.offsets));
+
+  dataAlg.setRange(0, numRows);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t row = range.min(); row < range.max(); row++)
+    {
+      std::copy(rowIds[row].begin(), rowIds[row].end(), coarse.ids.begin() + coarse.offsets[row * side]);
+      std::vector<int32_t>().swap(rowIds[row]);
+    }
+  });
+
+  return coarse;
+}
+
+/**
+ * @brief regressionSlope Least squares slope of y over x
+ * @param x
+ * @param y
+ * @return
+ */
+double regressionSlope(const std::vector<double>& x, const std::vector<double>& y)
+{
+  double xmean = std::accumulate(std::begin(x), std::end(x), 0.0) / x.size();
+  double ymean = std::accumulate(std::begin(y), std::end(y), 0.0) / y.size();
+  double sumxx = std::inner_product(std::begin(x), std::end(x), std::begin(x), 0.0);
+  double sumxy = std::inner_product(std::begin(x), std::end(x), std::begin(y), 0.0);
+  double ssxx = sumxx - (x.size() * xmean * xmean);
+  double ssxy = sumxy - (x.size() * xmean * ymean);
+  return ssxy / ssxx;
+}
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -60,10 +254,17 @@ void FindMinkowskiBouligandDimension::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   DataArraySelectionFilterParameter::RequirementType dasReq = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Bool, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+  QStringList linkedProps = {"FeatureIdsArrayPath", "FeatureMinkowskiBouligandDimensionArrayPath"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Compute Per Feature", ComputePerFeature, FilterParameter::Category::Parameter, FindMinkowskiBouligandDimension, linkedProps));
   parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Mask", MaskArrayPath, FilterParameter::Category::RequiredArray, FindMinkowskiBouligandDimension, dasReq));
+  dasReq = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+  parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Feature Ids", FeatureIdsArrayPath, FilterParameter::Category::RequiredArray, FindMinkowskiBouligandDimension, dasReq));
   parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Fractal Attribute Matrix", AttributeMatrixName, MaskArrayPath, FilterParameter::Category::CreatedArray, FindMinkowskiBouligandDimension));
   parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Minkowski-Bouligand Dimension", MinkowskiBouligandDimensionArrayName, MaskArrayPath, AttributeMatrixName,
                                                       FilterParameter::Category::CreatedArray, FindMinkowskiBouligandDimension));
+  DataArrayCreationFilterParameter::RequirementType dacReq = DataArrayCreationFilterParameter::CreateRequirement(AttributeMatrix::Type::CellFeature, IGeometry::Type::Image);
+  parameters.push_back(SIMPL_NEW_DA_CREATION_FP("Feature Minkowski-Bouligand Dimension", FeatureMinkowskiBouligandDimensionArrayPath, FilterParameter::Category::CreatedArray,
+                                                FindMinkowskiBouligandDimension, dacReq));
   setFilterParameters(parameters);
 }
 
@@ -113,26 +314,25 @@ void FindMinkowskiBouligandDimension::dataCheck()
   {
     m_MinkowskiBouligandDimension = m_MinkowskiBouligandDimensionPtr.lock()->getPointer(0);
   }
-}
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void FindMinkowskiBouligandDimension::findSourceIndices(std::vector<size_t>& indices, size_t sourceDim, size_t index, size_t box[3], size_t imageDim)
-{
-  size_t zloop = imageDim == 3 ? 2 : 1;
-  for(size_t z = 0; z < zloop; z++)
+  if(getComputePerFeature())
   {
-    size_t zStride = (z * sourceDim * sourceDim) + (box[2] * sourceDim * sourceDim * 2);
-    for(size_t y = 0; y < 2; y++)
+    m_FeatureIdsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>>(this, getFeatureIdsArrayPath(), cDims);
+    if(nullptr != m_FeatureIdsPtr.lock().get())
     {
-      size_t yStride = (y * sourceDim) + (box[1] * sourceDim * 2);
-      for(size_t x = 0; x < 2; x++)
-      {
-        size_t idx = (z * 2 * 2) + (y * 2) + x;
-        size_t mov_idx = zStride + yStride + x + (box[0] * 2);
-        indices[idx] = mov_idx;
-      }
+      m_FeatureIds = m_FeatureIdsPtr.lock()->getPointer(0);
+    }
+
+    m_FeatureMinkowskiBouligandDimensionPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<double>>(this, getFeatureMinkowskiBouligandDimensionArrayPath(), 0, cDims);
+    if(nullptr != m_FeatureMinkowskiBouligandDimensionPtr.lock().get())
+    {
+      m_FeatureMinkowskiBouligandDimension = m_FeatureMinkowskiBouligandDimensionPtr.lock()->getPointer(0);
+    }
+
+    if(getErrorCode() >= 0)
+    {
+      QVector<DataArrayPath> dataArrayPaths = {getMaskArrayPath(), getFeatureIdsArrayPath()};
+      getDataContainerArray()->validateNumberOfTuples(this, dataArrayPaths);
     }
   }
 }
@@ -198,9 +398,8 @@ void FindMinkowskiBouligandDimension::execute()
 
   maxDim = next_pow_2(maxDim);
   size_t exponent = floor_log2(maxDim);
-  size_t totalSize = std::pow(maxDim, imageDim);
 
-  std::vector<bool> source(totalSize, 0);
+  bool is3D = imageDim == 3;
   size_t offsets[3] = {(maxDim - dims[0]) / 2, (maxDim - dims[1]) / 2, (maxDim - dims[2]) / 2};
 
   if(imageDim == 2)
@@ -208,21 +407,6 @@ void FindMinkowskiBouligandDimension::execute()
     offsets[2] = 0;
   }
 
-  for(size_t z = 0; z < dims[2]; z++)
-  {
-    size_t zStride = (z * dims[1] * dims[0]);
-    for(size_t y = 0; y < dims[1]; y++)
-    {
-      size_t yStride = (y * dims[0]);
-      for(size_t x = 0; x < dims[0]; x++)
-      {
-        size_t index = zStride + yStride + x;
-        size_t gridIndex = ((z + offsets[2]) * maxDim * maxDim) + ((y + offsets[1]) * maxDim) + (x + offsets[0]);
-        source[gridIndex] = m_Mask[index];
-      }
-    }
-  }
-
   size_t edgeLength = maxDim;
   std::vector<size_t> boxDims(exponent + 1, edgeLength);
   std::generate(std::next(std::begin(boxDims)), std::end(boxDims), [&edgeLength]() {
@@ -231,58 +415,46 @@ void FindMinkowskiBouligandDimension::execute()
   });
 
   std::vector<size_t> covering(exponent + 1, 0);
-  size_t nextDim = *std::next(std::begin(boxDims));
-  std::vector<bool> sink;
-  sink.reserve(std::pow(nextDim, imageDim));
-  std::vector<size_t> indices(std::pow(2, imageDim), 0);
-  auto dimsIter = std::next(std::begin(boxDims));
-  auto coverIter = std::next(std::begin(covering));
-  size_t box[3] = {0, 0, 0};
-
-  for(auto&& box : source)
-  {
-    if(box)
-    {
-      (*std::begin(covering))++;
-    }
-  }
 
-  for(; dimsIter != std::prev(std::end(boxDims)); ++dimsIter, ++coverIter)
+  // Finest level: one bit per cell of the padded grid
+  OccupancyGrid level(maxDim, is3D);
   {
-    sink.resize(std::pow(*dimsIter, imageDim));
-
-    size_t zloop = imageDim == 3 ? *dimsIter : 1;
-    for(size_t z = 0; z < zloop; z++)
-    {
-      for(size_t y = 0; y < *dimsIter; y++)
+    std::vector<size_t> rowCounts(level.numRows, 0);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, level.numRows);
+    dataAlg.execute([&](const SIMPLRange& range) {
+      for(size_t row = range.min(); row < range.max(); row++)
       {
-        for(size_t x = 0; x < *dimsIter; x++)
+        size_t gy = row % maxDim;
+        size_t gz = row / maxDim;
+        if(gy < offsets[1] || gy >= offsets[1] + dims[1] || gz < offsets[2] || gz >= offsets[2] + dims[2])
+        {
+          continue;
+        }
+        uint64_t* words = level.words.data() + row * level.wordsPerRow;
+        size_t index = ((gz - offsets[2]) * dims[1] + (gy - offsets[1])) * dims[0];
+        for(size_t x = 0; x < dims[0]; x++)
         {
-          size_t index = (z * (*dimsIter) * (*dimsIter)) + (y * (*dimsIter)) + x;
-          box[0] = x;
-          box[1] = y;
-          box[2] = z;
-          findSourceIndices(indices, *std::prev(dimsIter), index, box, imageDim);
-          for(auto&& ind : indices)
+          if(m_Mask[index + x])
           {
-            if(source[ind])
-            {
-              sink[index] = true;
-              break;
-            }
+            size_t gx = x + offsets[0];
+            words[gx / 64] |= uint64_t(1) << (gx % 64);
           }
         }
+        for(size_t w = 0; w < level.wordsPerRow; w++)
+        {
+          rowCounts[row] += countBits(words[w]);
+        }
       }
-    }
-    for(auto&& box : sink)
-    {
-      if(box)
-      {
-        (*coverIter)++;
-      }
-    }
+    });
+    covering[0] = std::accumulate(rowCounts.begin(), rowCounts.end(), static_cast<size_t>(0));
+  }
 
-    source = sink;
+  for(size_t i = 1; i + 1 < boxDims.size(); i++)
+  {
+    OccupancyGrid next(boxDims[i], is3D);
+    covering[i] = coarsen(level, next, is3D);
+    level = std::move(next);
   }
 
   covering.back() = 1;
@@ -314,26 +486,99 @@ void FindMinkowskiBouligandDimension::execute()
 
   std::transform(std::begin(boxDims), std::end(boxDims), std::begin(LnOneOverE), [](size_t& x) -> double { return std::log(1.0 / x); });
 
-  auto linear_regression_slope = [&]() -> double {
-    double xmean = std::accumulate(std::begin(LnOneOverE), std::end(LnOneOverE), 0.0);
-    double ymean = std::accumulate(std::begin(LnNumBoxes), std::end(LnNumBoxes), 0.0);
-    xmean /= LnOneOverE.size();
-    ymean /= LnNumBoxes.size();
+  m_MinkowskiBouligandDimension[0] = regressionSlope(LnOneOverE, LnNumBoxes);
+
+  if(!m_ComputePerFeature)
+  {
+    notifyStatusMessage("Complete");
+    return;
+  }
+
+  notifyStatusMessage("Computing per feature dimensions");
 
-    std::vector<double> xx;
-    std::transform(std::begin(LnOneOverE), std::end(LnOneOverE), std::begin(LnOneOverE), std::back_inserter(xx), std::multiplies<double>());
-    double sumxx = std::accumulate(std::begin(xx), std::end(xx), 0.0);
-    double ssxx = sumxx - (xx.size() * xmean * xmean);
+  // Per feature box counts, laid out as [feature * numLevels + level]
+  size_t numFeatures = m_FeatureMinkowskiBouligandDimensionPtr.lock()->getNumberOfTuples();
+  size_t numLevels = exponent + 1;
+  std::vector<size_t> featureCovering(numFeatures * numLevels, 0);
 
-    std::vector<double> xy;
-    std::transform(std::begin(LnOneOverE), std::end(LnOneOverE), std::begin(LnNumBoxes), std::back_inserter(xy), std::multiplies<double>());
-    double sumxy = std::accumulate(std::begin(xy), std::end(xy), 0.0);
-    double ssxy = sumxy - (xy.size() * xmean * ymean);
+  size_t totalPoints = m_MaskPtr.lock()->getNumberOfTuples();
+  for(size_t i = 0; i < totalPoints; i++)
+  {
+    if(!m_Mask[i] || m_FeatureIds[i] <= 0)
+    {
+      continue;
+    }
+    if(static_cast<size_t>(m_FeatureIds[i]) >= numFeatures)
+    {
+      QString ss = QObject::tr("Feature Id %1 is out of range for the %2 tuples of the Feature Attribute Matrix").arg(m_FeatureIds[i]).arg(numFeatures);
+      setErrorCondition(-2, ss);
+      return;
+    }
+    featureCovering[m_FeatureIds[i] * numLevels]++;
+  }
 
-    return ssxy / ssxx;
-  };
+  // The first coarse level is merged directly from the cells, every further one from the level below it
+  FeatureBoxes boxes;
+  for(size_t i = 1; i < numLevels; i++)
+  {
+    if(getCancel())
+    {
+      return;
+    }
+
+    if(i == 1)
+    {
+      boxes = coarsenFeatures(boxDims[i], is3D, [&](size_t gx, size_t gy, size_t gz, std::vector<int32_t>& ids) {
+        if(gx < offsets[0] || gx >= offsets[0] + dims[0] || gy < offsets[1] || gy >= offsets[1] + dims[1] || gz < offsets[2] || gz >= offsets[2] + dims[2])
+        {
+          return;
+        }
+        size_t index = ((gz - offsets[2]) * dims[1] + (gy - offsets[1])) * dims[0] + (gx - offsets[0]);
+        if(m_Mask[index] && m_FeatureIds[index] > 0)
+        {
+          ids.push_back(m_FeatureIds[index]);
+        }
+      });
+    }
+    else
+    {
+      FeatureBoxes fine = std::move(boxes);
+      boxes = coarsenFeatures(boxDims[i], is3D, [&fine](size_t x, size_t y, size_t z, std::vector<int32_t>& ids) {
+        size_t index = (z * fine.side + y) * fine.side + x;
+        ids.insert(ids.end(), fine.ids.begin() + fine.offsets[index], fine.ids.begin() + fine.offsets[index + 1]);
+      });
+    }
 
-  m_MinkowskiBouligandDimension[0] = linear_regression_slope();
+    for(int32_t id : boxes.ids)
+    {
+      featureCovering[id * numLevels + i]++;
+    }
+  }
+
+  // Every feature is fitted from the finest level up to the first level where it fits into a single box, since
+  // all coarser levels add the same count of one
+  std::vector<double> lnOneOverE;
+  std::vector<double> lnNumBoxes;
+  for(size_t feature = 1; feature < numFeatures; feature++)
+  {
+    lnOneOverE.clear();
+    lnNumBoxes.clear();
+    for(size_t i = 0; i < numLevels; i++)
+    {
+      size_t count = featureCovering[feature * numLevels + i];
+      if(count == 0)
+      {
+        break;
+      }
+      lnOneOverE.push_back(std::log(1.0 / static_cast<double>(size_t(1) << i)));
+      lnNumBoxes.push_back(std::log(static_cast<double>(count)));
+      if(count == 1)
+      {
+        break;
+      }
+    }
+    m_FeatureMinkowskiBouligandDimension[feature] = lnOneOverE.size() > 1 ? regressionSlope(lnOneOverE, lnNumBoxes) : 0.0;
+  }
 
   notifyStatusMessage("Complete");
 }
@@ -474,3 +719,39 @@ QString FindMinkowskiBouligandDimension::getMinkowskiBouligandDimensionArrayName
 {
   return m_MinkowskiBouligandDimensionArrayName;
 }
+
+// -----------------------------------------------------------------------------
+void FindMinkowskiBouligandDimension::setComputePerFeature(bool value)
+{
+  m_ComputePerFeature = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindMinkowskiBouligandDimension::getComputePerFeature() const
+{
+  return m_ComputePerFeature;
+}
+
+// -----------------------------------------------------------------------------
+void FindMinkowskiBouligandDimension::setFeatureIdsArrayPath(const DataArrayPath& value)
+{
+  m_FeatureIdsArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath FindMinkowskiBouligandDimension::getFeatureIdsArrayPath() const
+{
+  return m_FeatureIdsArrayPath;
+}
+
+// -----------------------------------------------------------------------------
+void FindMinkowskiBouligandDimension::setFeatureMinkowskiBouligandDimensionArrayPath(const DataArrayPath& value)
+{
+  m_FeatureMinkowskiBouligandDimensionArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath FindMinkowskiBouligandDimension::getFeatureMinkowskiBouligandDimensionArrayPath() const
+{
+  return m_FeatureMinkowskiBouligandDimensionArrayPath;
+}
@@ -82,6 +82,39 @@ public:
   QString getMinkowskiBouligandDimensionArrayName() const;
   Q_PROPERTY(QString MinkowskiBouligandDimensionArrayName READ getMinkowskiBouligandDimensionArrayName WRITE setMinkowskiBouligandDimensionArrayName)
 
+  /**
+   * @brief Setter property for ComputePerFeature
+   */
+  void setComputePerFeature(bool value);
+  /**
+   * @brief Getter property for ComputePerFeature
+   * @return Value of ComputePerFeature
+   */
+  bool getComputePerFeature() const;
+  Q_PROPERTY(bool ComputePerFeature READ getComputePerFeature WRITE setComputePerFeature)
+
+  /**
+   * @brief Setter property for FeatureIdsArrayPath
+   */
+  void setFeatureIdsArrayPath(const DataArrayPath& value);
+  /**
+   * @brief Getter property for FeatureIdsArrayPath
+   * @return Value of FeatureIdsArrayPath
+   */
+  DataArrayPath getFeatureIdsArrayPath() const;
+  Q_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
+
+  /**
+   * @brief Setter property for FeatureMinkowskiBouligandDimensionArrayPath
+   */
+  void setFeatureMinkowskiBouligandDimensionArrayPath(const DataArrayPath& value);
+  /**
+   * @brief Getter property for FeatureMinkowskiBouligandDimensionArrayPath
+   * @return Value of FeatureMinkowskiBouligandDimensionArrayPath
+   */
+  DataArrayPath getFeatureMinkowskiBouligandDimensionArrayPath() const;
+  Q_PROPERTY(DataArrayPath FeatureMinkowskiBouligandDimensionArrayPath READ getFeatureMinkowskiBouligandDimensionArrayPath WRITE setFeatureMinkowskiBouligandDimensionArrayPath)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -155,12 +188,17 @@ private:
   bool* m_Mask = nullptr;
   std::weak_ptr<DataArray<double>> m_MinkowskiBouligandDimensionPtr;
   double* m_MinkowskiBouligandDimension = nullptr;
+  std::weak_ptr<DataArray<int32_t>> m_FeatureIdsPtr;
+  int32_t* m_FeatureIds = nullptr;
+  std::weak_ptr<DataArray<double>> m_FeatureMinkowskiBouligandDimensionPtr;
+  double* m_FeatureMinkowskiBouligandDimension = nullptr;
 
   DataArrayPath m_MaskArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask};
   QString m_AttributeMatrixName = {"FractalData"};
   QString m_MinkowskiBouligandDimensionArrayName = {"MinkowskiBouligandDimension"};
-
-  void findSourceIndices(std::vector<size_t>& indices, size_t sourceDim, size_t index, size_t box[3], size_t imageDim);
+  bool m_ComputePerFeature = {false};
+  DataArrayPath m_FeatureIdsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds};
+  DataArrayPath m_FeatureMinkowskiBouligandDimensionArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, "MinkowskiBouligandDimension"};
 
 public:
   FindMinkowskiBouligandDimension(const FindMinkowskiBouligandDimension&) = delete;            // Copy Constructor Not Implemented
@@ -0,0 +1,804 @@
+/* ============================================================================
+ * Software developed by US federal government employees (including military personnel)
+ * as part of their official duties is not subject to copyright protection and is
+ * considered "public domain" (see 17 USC Section 105). Public domain software can be used
+ * by anyone for any purpose, and cannot be released under a copyright license
+ * (including typical open source software licenses).
+ *
+ * This source code file was originally written by United States DoD employees. The
+ * original source code files are released into the Public Domain.
+ *
+ * Subsequent changes to the codes by others may elect to add a copyright and license
+ * for those changes.
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FindMovingWindowStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Common/TemplateHelpers.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "DREAM3DReview/DREAM3DReviewConstants.h"
+#include "DREAM3DReview/DREAM3DReviewVersion.h"
+
+namespace
+{
+// Number of neighboring x columns swept together along y and z, so those passes read whole cache lines
+constexpr size_t k_ColumnBlock = 32;
+
+struct WindowOutputs
+{
+  float* mean;
+  float* variance;
+  float* min;
+  float* max;
+};
+
+/**
+ * @brief The KahanSum class is a running sum that carries the rounding error of every addition into the next one
+ */
+class KahanSum
+{
+public:
+  void add(double value)
+  {
+    double y = value - m_Compensation;
+    double t = m_Sum + y;
+    m_Compensation = (t - m_Sum) - y;
+    m_Sum = t;
+  }
+
+  double sum() const
+  {
+    return m_Sum;
+  }
+
+private:
+  double m_Sum = 0.0;
+  double m_Compensation = 0.0;
+};
+
+/**
+ * @brief The IntegralImage class is a summed area table: entry (x, y, z) holds the sum of all values with smaller
+ * indices along every axis. It carries an extra leading zero plane per axis, so the sum over any box takes eight
+ * lookups regardless of the box size.
+ */
+class IntegralImage
+{
+public:
+  explicit IntegralImage(const SizeVec3Type& dims)
+  : m_StrideY(dims[0] + 1)
+  , m_StrideZ((dims[0] + 1) * (dims[1] + 1))
+  , m_Values(m_StrideZ * (dims[2] + 1), 0.0)
+  {
+  }
+
+  double* data()
+  {
+    return m_Values.data();
+  }
+
+  size_t index(size_t x, size_t y, size_t z) const
+  {
+    return z * m_StrideZ + y * m_StrideY + x;
+  }
+
+  /**
+   * @brief boxSum Sum over the half open box [x0, x1) x [y0, y1) x [z0, z1)
+   */
+  double boxSum(size_t x0, size_t x1, size_t y0, size_t y1, size_t z0, size_t z1) const
+  {
+    const double* v = m_Values.data();
+    double upper = v[index(x1, y1, z1)] - v[index(x0, y1, z1)] - v[index(x1, y0, z1)] + v[index(x0, y0, z1)];
+    double lower = v[index(x1, y1, z0)] - v[index(x0, y1, z0)] - v[index(x1, y0, z0)] + v[index(x0, y0, z0)];
+    return upper - lower;
+  }
+
+private:
+  size_t m_StrideY;
+  size_t m_StrideZ;
+  std::vector<double> m_Values;
+};
+
+/**
+ * @brief accumulateAxis Turns the rows of the integral images into running sums along y (axis 1) or z (axis 2).
+ * Blocks of neighboring x columns are swept together with one compensated sum per column; the blocks of
+ * different planes are independent tasks.
+ */
+void accumulateAxis(std::vector<IntegralImage*>& tables, const SizeVec3Type& dims, size_t axis)
+{
+  size_t numColumnBlocks = (dims[0] + k_ColumnBlock - 1) / k_ColumnBlock;
+  size_t numPlanes = axis == 1 ? dims[2] : dims[1];
+  size_t length = axis == 1 ? dims[1] : dims[2];
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numPlanes * numColumnBlocks);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t task = range.min(); task < range.max(); task++)
+    {
+      size_t plane = task / numColumnBlocks + 1;
+      size_t xBegin = (task % numColumnBlocks) * k_ColumnBlock + 1;
+      size_t xEnd = std::min(xBegin + k_ColumnBlock, dims[0] + 1);
+      for(IntegralImage* table : tables)
+      {
+        KahanSum sums[k_ColumnBlock];
+        double* values = table->data();
+        for(size_t i = 1; i <= length; i++)
+        {
+          size_t offset = axis == 1 ? table->index(0, i, plane) : table->index(0, plane, i);
+          for(size_t x = xBegin; x < xEnd; x++)
+          {
+            sums[x - xBegin].add(values[offset + x]);
+            values[offset + x] = sums[x - xBegin].sum();
+          }
+        }
+      }
+    }
+  });
+}
+
+/**
+ * @brief findWindowMoments Computes the mean and (population) variance over the window around every voxel from
+ * integral images of the values and of their squares. The values are shifted by the global mean first, which keeps
+ * the table entries small and limits the cancellation in the variance.
+ */
+template <typename T>
+void findWindowMoments(const T* data, const SizeVec3Type& dims, const size_t radius[3], float* mean, float* variance)
+{
+  size_t numRows = dims[1] * dims[2];
+  size_t dimX = dims[0];
+
+  std::vector<double> rowSums(numRows, 0.0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numRows);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t row = range.min(); row < range.max(); row++)
+    {
+      KahanSum sum;
+      for(size_t x = 0; x < dimX; x++)
+      {
+        sum.add(static_cast<double>(data[row * dimX + x]));
+      }
+      rowSums[row] = sum.sum();
+    }
+  });
+  KahanSum total;
+  for(double rowSum : rowSums)
+  {
+    total.add(rowSum);
+  }
+  double shift = total.sum() / static_cast<double>(numRows * dimX);
+
+  IntegralImage sums(dims);
+  std::unique_ptr<IntegralImage> squares;
+  std::vector<IntegralImage*> tables = {&sums};
+  if(variance != nullptr)
+  {
+    squares = std::make_unique<IntegralImage>(dims);
+    tables.push_back(squares.get());
+  }
+
+  // Running sums along x, one row per task
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t row = range.min(); row < range.max(); row++)
+    {
+      size_t y = row % dims[1];
+      size_t z = row / dims[1];
+      size_t offset = sums.index(1, y + 1, z + 1);
+      KahanSum sum;
+      KahanSum sumSquares;
+      for(size_t x = 0; x < dimX; x++)
+      {
+        double value = static_cast<double>(data[row * dimX + x]) - shift;
+        sum.add(value);
+        sums.data()[offset + x] = sum.sum();
+        if(squares)
+        {
+          sumSquares.add(value * value);
+          squares->data()[offset + x] = sumSquares.sum();
+        }
+      }
+    }
+  });
+  accumulateAxis(tables, dims, 1);
+  accumulateAxis(tables, dims, 2);
+
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t row = range.min(); row < range.max(); row++)
+    {
+      size_t y = row % dims[1];
+      size_t z = row / dims[1];
+      size_t y0 = y - std::min(y, radius[1]);
+      size_t y1 = std::min(y + radius[1] + 1, dims[1]);
+      size_t z0 = z - std::min(z, radius[2]);
+      size_t z1 = std::min(z + radius[2] + 1, dims[2]);
+      for(size_t x = 0; x < dimX; x++)
+      {
+        size_t x0 = x - std::min(x, radius[0]);
+        size_t x1 = std::min(x + radius[0] + 1, dimX);
+        double count = static_cast<double>((x1 - x0) * (y1 - y0) * (z1 - z0));
+        double average = sums.boxSum(x0, x1, y0, y1, z0, z1) / count;
+        if(mean != nullptr)
+        {
+          mean[row * dimX + x] = static_cast<float>(shift + average);
+        }
+        if(variance != nullptr)
+        {
+          double var = squares->boxSum(x0, x1, y0, y1, z0, z1) / count - average * average;
+          variance[row * dimX + x] = static_cast<float>(std::max(var, 0.0));
+        }
+      }
+    }
+  });
+}
+
+/**
+ * @brief The ExtremumFilter class computes running minima or maxima over windows of 2 * radius + 1 samples with
+ * the van Herk/Gil-Werman algorithm: the padded line is cut into blocks of the window length, and every window is
+ * the union of a block suffix and the following block prefix, so each sample costs three comparisons whatever the
+ * window length. Lines are processed in bundles of interleaved lanes so strided lines are read a cache line at a time.
+ */
+template <typename Compare>
+class ExtremumFilter
+{
+public:
+  ExtremumFilter(size_t length, size_t radius, size_t lanes, float identity)
+  : m_Length(length)
+  , m_Radius(radius)
+  , m_Lanes(lanes)
+  , m_Padded((length + 2 * radius) * lanes, identity)
+  , m_Prefix(m_Padded.size())
+  , m_Suffix(m_Padded.size())
+  {
+  }
+
+  /**
+   * @brief sample Returns the storage for sample i of the interleaved input lines
+   */
+  float* sample(size_t i)
+  {
+    return m_Padded.data() + (i + m_Radius) * m_Lanes;
+  }
+
+  /**
+   * @brief run Filters the current input and writes sample i of lane k to output(i)[k]
+   */
+  template <typename Output>
+  void run(size_t lanes, Output output)
+  {
+    Compare comp;
+    size_t window = 2 * m_Radius + 1;
+    size_t padded = m_Length + 2 * m_Radius;
+    for(size_t begin = 0; begin < padded; begin += window)
+    {
+      size_t end = std::min(begin + window, padded);
+      for(size_t k = 0; k < lanes; k++)
+      {
+        m_Prefix[begin * m_Lanes + k] = m_Padded[begin * m_Lanes + k];
+        m_Suffix[(end - 1) * m_Lanes + k] = m_Padded[(end - 1) * m_Lanes + k];
+      }
+      for(size_t j = begin + 1; j < end; j++)
+      {
+        for(size_t k = 0; k < lanes; k++)
+        {
+          m_Prefix[j * m_Lanes + k] = std::min(m_Prefix[(j - 1) * m_Lanes + k], m_Padded[j * m_Lanes + k], comp);
+        }
+      }
+      for(size_t j = end - 1; j > begin; j--)
+      {
+        for(size_t k = 0; k < lanes; k++)
+        {
+          m_Suffix[(j - 1) * m_Lanes + k] = std::min(m_Suffix[j * m_Lanes + k], m_Padded[(j - 1) * m_Lanes + k], comp);
+        }
+      }
+    }
+    for(size_t i = 0; i < m_Length; i++)
+    {
+      float* out = output(i);
+      for(size_t k = 0; k < lanes; k++)
+      {
+        out[k] = std::min(m_Suffix[i * m_Lanes + k], m_Prefix[(i + window - 1) * m_Lanes + k], comp);
+      }
+    }
+  }
+
+private:
+  size_t m_Length;
+  size_t m_Radius;
+  size_t m_Lanes;
+  std::vector<float> m_Padded;
+  std::vector<float> m_Prefix;
+  std::vector<float> m_Suffix;
+};
+
+/**
+ * @brief findWindowExtremum Writes the minimum (std::less) or maximum (std::greater) over the window around every
+ * voxel. The box is separable, so it is filtered along x from the input and then along y and z in place. Values are
+ * converted to float up front; the conversion is monotonic, so it commutes with taking the extremum.
+ */
+template <typename T, typename Compare>
+void findWindowExtremum(const T* data, const SizeVec3Type& dims, const size_t radius[3], float* output)
+{
+  const float identity = Compare()(0.0f, 1.0f) ? std::numeric_limits<float>::infinity() : -std::numeric_limits<float>::infinity();
+  size_t dimX = dims[0];
+  size_t numRows = dims[1] * dims[2];
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numRows);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    ExtremumFilter<Compare> filter(dimX, radius[0], 1, identity);
+    for(size_t row = range.min(); row < range.max(); row++)
+    {
+      for(size_t x = 0; x < dimX; x++)
+      {
+        *filter.sample(x) = static_cast<float>(data[row * dimX + x]);
+      }
+      filter.run(1, [&](size_t x) { return output + row * dimX + x; });
+    }
+  });
+
+  size_t numColumnBlocks = (dimX + k_ColumnBlock - 1) / k_ColumnBlock;
+  for(size_t axis = 1; axis < 3; axis++)
+  {
+    if(radius[axis] == 0)
+    {
+      continue;
+    }
+    size_t numPlanes = axis == 1 ? dims[2] : dims[1];
+    size_t stride = axis == 1 ? dimX : dimX * dims[1];
+    dataAlg.setRange(0, numPlanes * numColumnBlocks);
+    dataAlg.execute([&](const SIMPLRange& range) {
+      ExtremumFilter<Compare> filter(dims[axis], radius[axis], k_ColumnBlock, identity);
+      for(size_t task = range.min(); task < range.max(); task++)
+      {
+        size_t plane = task / numColumnBlocks;
+        size_t xBegin = (task % numColumnBlocks) * k_ColumnBlock;
+        size_t lanes = std::min(k_ColumnBlock, dimX - xBegin);
+        float* first = output + (axis == 1 ? plane * dimX * dims[1] : plane * dimX) + xBegin;
+        for(size_t i = 0; i < dims[axis]; i++)
+        {
+          std::copy(first + i * stride, first + i * stride + lanes, filter.sample(i));
+        }
+        filter.run(lanes, [&](size_t i) { return first + i * stride; });
+      }
+    });
+  }
+}
+
+/**
+ * @brief findMovingWindowStatistics Computes the requested statistics over the box of (2 * radius + 1) voxels
+ * around every voxel. Boxes are clipped at the borders of the image, and statistics are taken over the voxels
+ * that remain.
+ */
+template <typename T>
+void findMovingWindowStatistics(IDataArray::Pointer inDataPtr, const SizeVec3Type& dims, const IntVec3Type& windowRadius, const WindowOutputs& out)
+{
+  typename DataArray<T>::Pointer input = std::dynamic_pointer_cast<DataArray<T>>(inDataPtr);
+  const T* data = input->getPointer(0);
+  if(input->getNumberOfTuples() == 0)
+  {
+    return;
+  }
+
+  // A radius beyond the image covers the whole axis
+  size_t radius[3] = {0, 0, 0};
+  for(size_t d = 0; d < 3; d++)
+  {
+    radius[d] = std::min(static_cast<size_t>(windowRadius[d]), dims[d] - 1);
+  }
+
+  if(out.mean != nullptr || out.variance != nullptr)
+  {
+    findWindowMoments(data, dims, radius, out.mean, out.variance);
+  }
+  if(out.min != nullptr)
+  {
+    findWindowExtremum<T, std::less<float>>(data, dims, radius, out.min);
+  }
+  if(out.max != nullptr)
+  {
+    findWindowExtremum<T, std::greater<float>>(data, dims, radius, out.max);
+  }
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FindMovingWindowStatistics::FindMovingWindowStatistics() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FindMovingWindowStatistics::~FindMovingWindowStatistics() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindMovingWindowStatistics::setupFilterParameters()
+{
+  FilterParameterVectorType parameters;
+  parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Window Radius (Voxels)", WindowRadius, FilterParameter::Category::Parameter, FindMovingWindowStatistics));
+  QStringList linkedProps = {"MeanArrayName"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Find Mean", FindMean, FilterParameter::Category::Parameter, FindMovingWindowStatistics, linkedProps));
+  linkedProps = {"VarianceArrayName"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Find Variance", FindVariance, FilterParameter::Category::Parameter, FindMovingWindowStatistics, linkedProps));
+  linkedProps = {"MinimumArrayName"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Find Minimum", FindMin, FilterParameter::Category::Parameter, FindMovingWindowStatistics, linkedProps));
+  linkedProps = {"MaximumArrayName"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Find Maximum", FindMax, FilterParameter::Category::Parameter, FindMovingWindowStatistics, linkedProps));
+  parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
+  {
+    DataArraySelectionFilterParameter::RequirementType req =
+        DataArraySelectionFilterParameter::CreateRequirement(SIMPL::Defaults::AnyPrimitive, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    req.daTypes = {SIMPL::TypeNames::Int8,   SIMPL::TypeNames::Int16,  SIMPL::TypeNames::Int32, SIMPL::TypeNames::Int64, SIMPL::TypeNames::UInt8,
+                   SIMPL::TypeNames::UInt16, SIMPL::TypeNames::UInt32, SIMPL::TypeNames::UInt64, SIMPL::TypeNames::Float, SIMPL::TypeNames::Double};
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Attribute Array to Quantify", SelectedArrayPath, FilterParameter::Category::RequiredArray, FindMovingWindowStatistics, req));
+  }
+  parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::CreatedArray));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Mean", MeanArrayName, SelectedArrayPath, SelectedArrayPath, FilterParameter::Category::CreatedArray, FindMovingWindowStatistics));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Variance", VarianceArrayName, SelectedArrayPath, SelectedArrayPath, FilterParameter::Category::CreatedArray, FindMovingWindowStatistics));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Minimum", MinimumArrayName, SelectedArrayPath, SelectedArrayPath, FilterParameter::Category::CreatedArray, FindMovingWindowStatistics));
+  parameters.push_back(SIMPL_NEW_DA_WITH_LINKED_AM_FP("Maximum", MaximumArrayName, SelectedArrayPath, SelectedArrayPath, FilterParameter::Category::CreatedArray, FindMovingWindowStatistics));
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindMovingWindowStatistics::initialize()
+{
+  m_Mean = nullptr;
+  m_Variance = nullptr;
+  m_Minimum = nullptr;
+  m_Maximum = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindMovingWindowStatistics::dataCheck()
+{
+  clearErrorCode();
+  clearWarningCode();
+  initialize();
+
+  if(m_WindowRadius[0] < 0 || m_WindowRadius[1] < 0 || m_WindowRadius[2] < 0)
+  {
+    QString ss = QObject::tr("The window radius must be zero or positive along every axis");
+    setErrorCondition(-11000, ss);
+  }
+
+  if(!m_FindMean && !m_FindVariance && !m_FindMin && !m_FindMax)
+  {
+    QString ss = QObject::tr("At least one statistic must be selected");
+    setErrorCondition(-11001, ss);
+  }
+
+  getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getSelectedArrayPath().getDataContainerName());
+
+  m_InDataPtr = getDataContainerArray()->getPrereqIDataArrayFromPath(this, getSelectedArrayPath());
+  if(nullptr != m_InDataPtr.lock())
+  {
+    if(TemplateHelpers::CanDynamicCast<BoolArrayType>()(m_InDataPtr.lock()))
+    {
+      QString ss = QObject::tr("Selected array cannot be of type bool.  The path is %1").arg(getSelectedArrayPath().serialize());
+      setErrorCondition(-11002, ss);
+    }
+    if(m_InDataPtr.lock()->getNumberOfComponents() != 1)
+    {
+      QString ss = QObject::tr("Selected array must be a scalar array.  The path is %1").arg(getSelectedArrayPath().serialize());
+      setErrorCondition(-11003, ss);
+    }
+  }
+
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  std::vector<size_t> cDims(1, 1);
+  DataArrayPath tempPath(getSelectedArrayPath().getDataContainerName(), getSelectedArrayPath().getAttributeMatrixName(), "");
+
+  if(m_FindMean)
+  {
+    tempPath.setDataArrayName(getMeanArrayName());
+    m_MeanPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims);
+    if(nullptr != m_MeanPtr.lock())
+    {
+      m_Mean = m_MeanPtr.lock()->getPointer(0);
+    }
+  }
+
+  if(m_FindVariance)
+  {
+    tempPath.setDataArrayName(getVarianceArrayName());
+    m_VariancePtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims);
+    if(nullptr != m_VariancePtr.lock())
+    {
+      m_Variance = m_VariancePtr.lock()->getPointer(0);
+    }
+  }
+
+  if(m_FindMin)
+  {
+    tempPath.setDataArrayName(getMinimumArrayName());
+    m_MinimumPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims);
+    if(nullptr != m_MinimumPtr.lock())
+    {
+      m_Minimum = m_MinimumPtr.lock()->getPointer(0);
+    }
+  }
+
+  if(m_FindMax)
+  {
+    tempPath.setDataArrayName(getMaximumArrayName());
+    m_MaximumPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims);
+    if(nullptr != m_MaximumPtr.lock())
+    {
+      m_Maximum = m_MaximumPtr.lock()->getPointer(0);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindMovingWindowStatistics::execute()
+{
+  dataCheck();
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getSelectedArrayPath().getDataContainerName());
+  SizeVec3Type dims = m->getGeometryAs<ImageGeom>()->getDimensions();
+  if(m_InDataPtr.lock()->getNumberOfTuples() != dims[0] * dims[1] * dims[2])
+  {
+    QString ss = QObject::tr("The number of tuples of the selected array does not match the dimensions of the Image Geometry");
+    setErrorCondition(-11004, ss);
+    return;
+  }
+
+  WindowOutputs outputs = {m_Mean, m_Variance, m_Minimum, m_Maximum};
+  EXECUTE_FUNCTION_TEMPLATE_NO_BOOL(DataArray, this, findMovingWindowStatistics, m_InDataPtr.lock(), m_InDataPtr.lock(), dims, m_WindowRadius, outputs)
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer FindMovingWindowStatistics::newFilterInstance(bool copyFilterParameters) const
+{
+  FindMovingWindowStatistics::Pointer filter = FindMovingWindowStatistics::New();
+  if(copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindMovingWindowStatistics::getCompiledLibraryName() const
+{
+  return DREAM3DReviewConstants::DREAM3DReviewBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindMovingWindowStatistics::getBrandingString() const
+{
+  return "DREAM3DReview";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindMovingWindowStatistics::getFilterVersion() const
+{
+  QString version;
+  QTextStream vStream(&version);
+  vStream << DREAM3DReview::Version::Major() << "." << DREAM3DReview::Version::Minor() << "." << DREAM3DReview::Version::Patch();
+  return version;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindMovingWindowStatistics::getGroupName() const
+{
+  return SIMPL::FilterGroups::StatisticsFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindMovingWindowStatistics::getSubGroupName() const
+{
+  return SIMPL::FilterSubGroups::ImageFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FindMovingWindowStatistics::getHumanLabel() const
+{
+  return "Find Moving Window Statistics";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QUuid FindMovingWindowStatistics::getUuid() const
+{
+  return QUuid("{c48a553b-79fc-47a4-90b2-e9c1e43fc179}");
+}
+
+// -----------------------------------------------------------------------------
+FindMovingWindowStatistics::Pointer FindMovingWindowStatistics::NullPointer()
+{
+  return Pointer(static_cast<Self*>(nullptr));
+}
+
+// -----------------------------------------------------------------------------
+std::shared_ptr<FindMovingWindowStatistics> FindMovingWindowStatistics::New()
+{
+  struct make_shared_enabler : public FindMovingWindowStatistics
+  {
+  };
+  std::shared_ptr<make_shared_enabler> val = std::make_shared<make_shared_enabler>();
+  val->setupFilterParameters();
+  return val;
+}
+
+// -----------------------------------------------------------------------------
+QString FindMovingWindowStatistics::getNameOfClass() const
+{
+  return QString("FindMovingWindowStatistics");
+}
+
+// -----------------------------------------------------------------------------
+QString FindMovingWindowStatistics::ClassName()
+{
+  return QString("FindMovingWindowStatistics");
+}
+
+// -----------------------------------------------------------------------------
+void FindMovingWindowStatistics::setSelectedArrayPath(const DataArrayPath& value)
+{
+  m_SelectedArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath FindMovingWindowStatistics::getSelectedArrayPath() const
+{
+  return m_SelectedArrayPath;
+}
+
+// -----------------------------------------------------------------------------
+void FindMovingWindowStatistics::setWindowRadius(const IntVec3Type& value)
+{
+  m_WindowRadius = value;
+}
+
+// -----------------------------------------------------------------------------
+IntVec3Type FindMovingWindowStatistics::getWindowRadius() const
+{
+  return m_WindowRadius;
+}
+
+// -----------------------------------------------------------------------------
+void FindMovingWindowStatistics::setFindMean(bool value)
+{
+  m_FindMean = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindMovingWindowStatistics::getFindMean() const
+{
+  return m_FindMean;
+}
+
+// -----------------------------------------------------------------------------
+void FindMovingWindowStatistics::setFindVariance(bool value)
+{
+  m_FindVariance = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindMovingWindowStatistics::getFindVariance() const
+{
+  return m_FindVariance;
+}
+
+// -----------------------------------------------------------------------------
+void FindMovingWindowStatistics::setFindMin(bool value)
+{
+  m_FindMin = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindMovingWindowStatistics::getFindMin() const
+{
+  return m_FindMin;
+}
+
+// -----------------------------------------------------------------------------
+void FindMovingWindowStatistics::setFindMax(bool value)
+{
+  m_FindMax = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindMovingWindowStatistics::getFindMax() const
+{
+  return m_FindMax;
+}
+
+// -----------------------------------------------------------------------------
+void FindMovingWindowStatistics::setMeanArrayName(const QString& value)
+{
+  m_MeanArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindMovingWindowStatistics::getMeanArrayName() const
+{
+  return m_MeanArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void FindMovingWindowStatistics::setVarianceArrayName(const QString& value)
+{
+  m_VarianceArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindMovingWindowStatistics::getVarianceArrayName() const
+{
+  return m_VarianceArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void FindMovingWindowStatistics::setMinimumArrayName(const QString& value)
+{
+  m_MinimumArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindMovingWindowStatistics::getMinimumArrayName() const
+{
+  return m_MinimumArrayName;
+}
+
+// -----------------------------------------------------------------------------
+void FindMovingWindowStatistics::setMaximumArrayName(const QString& value)
+{
+  m_MaximumArrayName = value;
+}
+
+// -----------------------------------------------------------------------------
+QString FindMovingWindowStatistics::getMaximumArrayName() const
+{
+  return m_MaximumArrayName;
+}
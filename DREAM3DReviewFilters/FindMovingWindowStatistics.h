@@ -0,0 +1,262 @@
+/* ============================================================================
+ * Software developed by US federal government employees (including military personnel)
+ * as part of their official duties is not subject to copyright protection and is
+ * considered "public domain" (see 17 USC Section 105). Public domain software can be used
+ * by anyone for any purpose, and cannot be released under a copyright license
+ * (including typical open source software licenses).
+ *
+ * This source code file was originally written by United States DoD employees. The
+ * original source code files are released into the Public Domain.
+ *
+ * Subsequent changes to the codes by others may elect to add a copyright and license
+ * for those changes.
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <memory>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+class IDataArray;
+using IDataArrayWkPtrType = std::weak_ptr<IDataArray>;
+
+#include "DREAM3DReview/DREAM3DReviewDLLExport.h"
+
+/**
+ * @brief The FindMovingWindowStatistics class. See [Filter documentation](@ref findmovingwindowstatistics) for details.
+ */
+class DREAM3DReview_EXPORT FindMovingWindowStatistics : public AbstractFilter
+{
+  Q_OBJECT
+
+public:
+  using Self = FindMovingWindowStatistics;
+  using Pointer = std::shared_ptr<Self>;
+  using ConstPointer = std::shared_ptr<const Self>;
+  using WeakPointer = std::weak_ptr<Self>;
+  using ConstWeakPointer = std::weak_ptr<const Self>;
+  static Pointer NullPointer();
+
+  static std::shared_ptr<FindMovingWindowStatistics> New();
+
+  /**
+   * @brief Returns the name of the class for FindMovingWindowStatistics
+   */
+  QString getNameOfClass() const override;
+  /**
+   * @brief Returns the name of the class for FindMovingWindowStatistics
+   */
+  static QString ClassName();
+
+  ~FindMovingWindowStatistics() override;
+
+  /**
+   * @brief Setter property for SelectedArrayPath
+   */
+  void setSelectedArrayPath(const DataArrayPath& value);
+  /**
+   * @brief Getter property for SelectedArrayPath
+   * @return Value of SelectedArrayPath
+   */
+  DataArrayPath getSelectedArrayPath() const;
+  Q_PROPERTY(DataArrayPath SelectedArrayPath READ getSelectedArrayPath WRITE setSelectedArrayPath)
+
+  /**
+   * @brief Setter property for WindowRadius
+   */
+  void setWindowRadius(const IntVec3Type& value);
+  /**
+   * @brief Getter property for WindowRadius
+   * @return Value of WindowRadius
+   */
+  IntVec3Type getWindowRadius() const;
+  Q_PROPERTY(IntVec3Type WindowRadius READ getWindowRadius WRITE setWindowRadius)
+
+  /**
+   * @brief Setter property for FindMean
+   */
+  void setFindMean(bool value);
+  /**
+   * @brief Getter property for FindMean
+   * @return Value of FindMean
+   */
+  bool getFindMean() const;
+  Q_PROPERTY(bool FindMean READ getFindMean WRITE setFindMean)
+
+  /**
+   * @brief Setter property for FindVariance
+   */
+  void setFindVariance(bool value);
+  /**
+   * @brief Getter property for FindVariance
+   * @return Value of FindVariance
+   */
+  bool getFindVariance() const;
+  Q_PROPERTY(bool FindVariance READ getFindVariance WRITE setFindVariance)
+
+  /**
+   * @brief Setter property for FindMin
+   */
+  void setFindMin(bool value);
+  /**
+   * @brief Getter property for FindMin
+   * @return Value of FindMin
+   */
+  bool getFindMin() const;
+  Q_PROPERTY(bool FindMin READ getFindMin WRITE setFindMin)
+
+  /**
+   * @brief Setter property for FindMax
+   */
+  void setFindMax(bool value);
+  /**
+   * @brief Getter property for FindMax
+   * @return Value of FindMax
+   */
+  bool getFindMax() const;
+  Q_PROPERTY(bool FindMax READ getFindMax WRITE setFindMax)
+
+  /**
+   * @brief Setter property for MeanArrayName
+   */
+  void setMeanArrayName(const QString& value);
+  /**
+   * @brief Getter property for MeanArrayName
+   * @return Value of MeanArrayName
+   */
+  QString getMeanArrayName() const;
+  Q_PROPERTY(QString MeanArrayName READ getMeanArrayName WRITE setMeanArrayName)
+
+  /**
+   * @brief Setter property for VarianceArrayName
+   */
+  void setVarianceArrayName(const QString& value);
+  /**
+   * @brief Getter property for VarianceArrayName
+   * @return Value of VarianceArrayName
+   */
+  QString getVarianceArrayName() const;
+  Q_PROPERTY(QString VarianceArrayName READ getVarianceArrayName WRITE setVarianceArrayName)
+
+  /**
+   * @brief Setter property for MinimumArrayName
+   */
+  void setMinimumArrayName(const QString& value);
+  /**
+   * @brief Getter property for MinimumArrayName
+   * @return Value of MinimumArrayName
+   */
+  QString getMinimumArrayName() const;
+  Q_PROPERTY(QString MinimumArrayName READ getMinimumArrayName WRITE setMinimumArrayName)
+
+  /**
+   * @brief Setter property for MaximumArrayName
+   */
+  void setMaximumArrayName(const QString& value);
+  /**
+   * @brief Getter property for MaximumArrayName
+   * @return Value of MaximumArrayName
+   */
+  QString getMaximumArrayName() const;
+  Q_PROPERTY(QString MaximumArrayName READ getMaximumArrayName WRITE setMaximumArrayName)
+
+  /**
+   * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
+   */
+  QString getCompiledLibraryName() const override;
+
+  /**
+   * @brief getBrandingString Returns the branding string for the filter, which is a tag
+   * used to denote the filter's association with specific plugins
+   * @return Branding string
+   */
+  QString getBrandingString() const override;
+
+  /**
+   * @brief getFilterVersion Returns a version string for this filter. Default
+   * value is an empty string.
+   * @return
+   */
+  QString getFilterVersion() const override;
+
+  /**
+   * @brief newFilterInstance Reimplemented from @see AbstractFilter class
+   */
+  AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters) const override;
+
+  /**
+   * @brief getGroupName Reimplemented from @see AbstractFilter class
+   */
+  QString getGroupName() const override;
+
+  /**
+   * @brief getSubGroupName Reimplemented from @see AbstractFilter class
+   */
+  QString getSubGroupName() const override;
+
+  /**
+   * @brief getHumanLabel Reimplemented from @see AbstractFilter class
+   */
+  QString getHumanLabel() const override;
+
+  /**
+   * @brief setupFilterParameters Reimplemented from @see AbstractFilter class
+   */
+  void setupFilterParameters() override;
+
+  /**
+   * @brief execute Reimplemented from @see AbstractFilter class
+   */
+  void execute() override;
+
+  /**
+   * @brief getUuid Return the unique identifier for this filter.
+   * @return A QUuid object.
+   */
+  QUuid getUuid() const override;
+
+protected:
+  FindMovingWindowStatistics();
+
+  /**
+   * @brief dataCheck Checks for the appropriate parameter values and availability of arrays
+   */
+  void dataCheck() override;
+
+  /**
+   * @brief Initializes all the private instance variables.
+   */
+  void initialize();
+
+private:
+  IDataArrayWkPtrType m_InDataPtr;
+
+  std::weak_ptr<DataArray<float>> m_MeanPtr;
+  float* m_Mean = nullptr;
+  std::weak_ptr<DataArray<float>> m_VariancePtr;
+  float* m_Variance = nullptr;
+  std::weak_ptr<DataArray<float>> m_MinimumPtr;
+  float* m_Minimum = nullptr;
+  std::weak_ptr<DataArray<float>> m_MaximumPtr;
+  float* m_Maximum = nullptr;
+
+  DataArrayPath m_SelectedArrayPath = {"", "", ""};
+  IntVec3Type m_WindowRadius = {1, 1, 1};
+  bool m_FindMean = {true};
+  bool m_FindVariance = {true};
+  bool m_FindMin = {false};
+  bool m_FindMax = {false};
+  QString m_MeanArrayName = {"WindowMean"};
+  QString m_VarianceArrayName = {"WindowVariance"};
+  QString m_MinimumArrayName = {"WindowMinimum"};
+  QString m_MaximumArrayName = {"WindowMaximum"};
+
+public:
+  FindMovingWindowStatistics(const FindMovingWindowStatistics&) = delete;            // Copy Constructor Not Implemented
+  FindMovingWindowStatistics(FindMovingWindowStatistics&&) = delete;                 // Move Constructor Not Implemented
+  FindMovingWindowStatistics& operator=(const FindMovingWindowStatistics&) = delete; // Copy Assignment Not Implemented
+  FindMovingWindowStatistics& operator=(FindMovingWindowStatistics&&) = delete;      // Move Assignment Not Implemented
+};
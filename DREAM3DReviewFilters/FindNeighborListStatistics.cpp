@@ -14,8 +14,12 @@
 
 #include "FindNeighborListStatistics.h"
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <numeric>
+#include <type_traits>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
@@ -155,32 +159,73 @@ void FindNeighborListStatistics::dataCheck()
   getDataContainerArray()->validateNumberOfTuples(this, dataArrayPaths);
 }
 
+// -----------------------------------------------------------------------------
+namespace
+{
+// Smallest number of list entries worth a parallel task of its own
+constexpr size_t k_MinTaskWork = 1 << 12;
+// Upper bound on the number of parallel tasks the lists are split into
+constexpr size_t k_MaxTasks = 1024;
+
+/**
+ * @brief partitionByLength Splits the lists into consecutive runs of about equal work, counting every list as its length
+ * plus one, so a few long lists do not leave the other tasks idle
+ * @return Index of the first list of every run, followed by the number of lists
+ */
+template <typename T>
+std::vector<size_t> partitionByLength(NeighborList<T>& lists)
+{
+  const size_t numLists = lists.getNumberOfTuples();
+  size_t totalWork = 0;
+  for(size_t i = 0; i < numLists; i++)
+  {
+    totalWork += lists[i].size() + 1;
+  }
+  const size_t numTasks = std::max(static_cast<size_t>(1), std::min(k_MaxTasks, totalWork / k_MinTaskWork));
+  const size_t taskWork = (totalWork + numTasks - 1) / numTasks;
+
+  std::vector<size_t> bounds = {0};
+  size_t work = 0;
+  for(size_t i = 0; i < numLists; i++)
+  {
+    work += lists[i].size() + 1;
+    if(work >= taskWork && i + 1 < numLists)
+    {
+      bounds.push_back(i + 1);
+      work = 0;
+    }
+  }
+  bounds.push_back(numLists);
+  return bounds;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 template <typename T>
 class FindNeighborListStatisticsImpl
 {
 public:
-  FindNeighborListStatisticsImpl(AbstractFilter* filter, IDataArray::Pointer& source, bool length, bool min, bool max, bool mean, bool median, bool stdDeviation, bool summation,
-                                 std::vector<IDataArray::Pointer>& arrays)
+  FindNeighborListStatisticsImpl(AbstractFilter* filter, IDataArray::Pointer& source, const std::vector<size_t>& taskBounds, std::vector<IDataArray::Pointer>& arrays)
   : m_Filter(filter)
   , m_Source(source)
-  , m_Length(length)
-  , m_Min(min)
-  , m_Max(max)
-  , m_Mean(mean)
-  , m_Median(median)
-  , m_StdDeviation(stdDeviation)
-  , m_Summation(summation)
+  , m_TaskBounds(taskBounds)
   , m_Arrays(arrays)
   {
   }
 
   virtual ~FindNeighborListStatisticsImpl() = default;
 
+  /**
+   * @brief compute Computes the selected statistics of every list in [start, end) in a single pass over the list
+   * storage; only the median copies the list, into a scratch buffer reused across the lists, to partially order it
+   * with std::nth_element
+   */
   void compute(size_t start, size_t end) const
   {
     using NeighborListType = NeighborList<T>;
     typename NeighborListType::Pointer inputDataPtr = std::dynamic_pointer_cast<NeighborListType>(m_Source);
+    NeighborListType& lists = *inputDataPtr;
+    std::vector<T> scratch;
 
     for(size_t i = start; i < end; i++)
     {
@@ -188,96 +233,77 @@ public:
       {
         break;
       }
-      std::vector<T>& tmpList = (*inputDataPtr)[i];
+      // The median reorders the values, so it works on a copy of the list
+      const std::vector<T>& list = lists[i];
+      T* medianValues = nullptr;
+      if(m_Arrays[4])
+      {
+        scratch.assign(list.begin(), list.end());
+        medianValues = scratch.data();
+      }
+      StatisticsHelpers::RangeStatistics<T, StatisticsHelpers::SumType<T>> stats = StatisticsHelpers::computeRangeStatistics<T>(list.data(), list.data() + list.size(), medianValues);
 
-      if(m_Length)
+      if(m_Arrays[0])
       {
-        if(m_Arrays[0])
-        {
-          int64_t val = static_cast<int64_t>(tmpList.size());
-          m_Arrays[0]->initializeTuple(i, &val);
-        }
+        int64_t val = static_cast<int64_t>(stats.count);
+        m_Arrays[0]->initializeTuple(i, &val);
       }
-      if(m_Min)
+      if(m_Arrays[1])
       {
-        if(m_Arrays[1])
-        {
-          T val = StatisticsHelpers::findMin(tmpList);
-          m_Arrays[1]->initializeTuple(i, &val);
-        }
+        m_Arrays[1]->initializeTuple(i, &stats.minValue);
       }
-      if(m_Max)
+      if(m_Arrays[2])
       {
-        if(m_Arrays[2])
-        {
-          T val = StatisticsHelpers::findMax(tmpList);
-          m_Arrays[2]->initializeTuple(i, &val);
-        }
+        m_Arrays[2]->initializeTuple(i, &stats.maxValue);
       }
-      if(m_Mean)
+      if(m_Arrays[3])
       {
-        if(m_Arrays[3])
-        {
-          float val = StatisticsHelpers::findMean(tmpList);
-          m_Arrays[3]->initializeTuple(i, &val);
-        }
+        float val = stats.count > 0 ? static_cast<float>(stats.sum) / static_cast<float>(stats.count) : 0.0f;
+        m_Arrays[3]->initializeTuple(i, &val);
       }
-      if(m_Median)
+      if(m_Arrays[4])
       {
-        if(m_Arrays[4])
-        {
-          float val = StatisticsHelpers::findMedian(tmpList);
-          m_Arrays[4]->initializeTuple(i, &val);
-        }
+        float val = static_cast<float>(stats.median);
+        m_Arrays[4]->initializeTuple(i, &val);
       }
-      if(m_StdDeviation)
+      if(m_Arrays[5])
       {
-        if(m_Arrays[5])
-        {
-          float val = StatisticsHelpers::findStdDeviation(tmpList);
-          m_Arrays[5]->initializeTuple(i, &val);
-        }
+        float val = stats.count > 0 ? static_cast<float>(std::sqrt(stats.m2 / static_cast<double>(stats.count))) : 0.0f;
+        m_Arrays[5]->initializeTuple(i, &val);
       }
-      if(m_Summation)
+      if(m_Arrays[6])
       {
-        if(m_Arrays[6])
-        {
-          float val = StatisticsHelpers::findSummation(tmpList);
-          m_Arrays[6]->initializeTuple(i, &val);
-        }
+        float val = static_cast<float>(stats.sum);
+        m_Arrays[6]->initializeTuple(i, &val);
       }
     }
   }
 
   void operator()(const SIMPLRange& range) const
   {
-    compute(range.min(), range.max());
+    for(size_t task = range.min(); task < range.max(); task++)
+    {
+      compute(m_TaskBounds[task], m_TaskBounds[task + 1]);
+    }
   }
 
 private:
   AbstractFilter* m_Filter = nullptr;
   IDataArray::Pointer m_Source;
-  bool m_Length = false;
-  bool m_Min = false;
-  bool m_Max = false;
-  bool m_Mean = false;
-  bool m_Median = false;
-  bool m_StdDeviation = false;
-  bool m_Summation = false;
+  const std::vector<size_t>& m_TaskBounds;
 
   std::vector<IDataArray::Pointer>& m_Arrays;
 };
 
 // -----------------------------------------------------------------------------
 template <typename T>
-void findStatistics(AbstractFilter* filter, IDataArray::Pointer source, bool length, bool min, bool max, bool mean, bool median, bool stdDeviation, bool summation,
-                    std::vector<IDataArray::Pointer>& arrays)
+void findStatistics(AbstractFilter* filter, IDataArray::Pointer source, std::vector<IDataArray::Pointer>& arrays)
 {
-  size_t numTuples = source->getNumberOfTuples();
-  // Allow data-based parallelization
+  std::vector<size_t> taskBounds = partitionByLength(*std::dynamic_pointer_cast<NeighborList<T>>(source));
+  // Allow data-based parallelization over runs of lists of about equal total length
   ParallelDataAlgorithm dataAlg;
-  dataAlg.setRange(0, numTuples);
-  dataAlg.execute(FindNeighborListStatisticsImpl<T>(filter, source, length, min, max, mean, median, stdDeviation, summation, arrays));
+  dataAlg.setRange(0, taskBounds.size() - 1);
+  dataAlg.execute(FindNeighborListStatisticsImpl<T>(filter, source, taskBounds, arrays));
 }
 
 // -----------------------------------------------------------------------------
@@ -327,8 +353,7 @@ void FindNeighborListStatistics::execute()
     arrays[6] = m_SummationPtr.lock();
   }
 
-  EXECUTE_FUNCTION_TEMPLATE_NO_BOOL(NeighborList, this, findStatistics, m_InputArrayPtr.lock(), this, m_InputArrayPtr.lock(), m_FindLength, m_FindMin, m_FindMax, m_FindMean, m_FindMedian,
-                                    m_FindStdDeviation, m_FindSummation, arrays);
+  EXECUTE_FUNCTION_TEMPLATE_NO_BOOL(NeighborList, this, findStatistics, m_InputArrayPtr.lock(), this, m_InputArrayPtr.lock(), arrays);
 }
 
 // -----------------------------------------------------------------------------
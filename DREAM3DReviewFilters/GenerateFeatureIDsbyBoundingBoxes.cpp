@@ -4,28 +4,98 @@
 
 #include "GenerateFeatureIDsbyBoundingBoxes.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
-
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/Geometry/EdgeGeom.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Geometry/VertexGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/BoundingBoxTree.hpp"
 
 namespace
 {
 constexpr int32_t k_AttributeMatrixTypeSelectionError = -5555;
+constexpr int32_t k_TupleCountMismatchError = -5556;
 
+/**
+ * @brief computeBoxBounds Converts the box centers and dimensions into box extents
+ */
+std::vector<BoundingBoxTree::Box> computeBoxBounds(const float* centers, const float* dimensions, size_t numBoxes)
+{
+  std::vector<BoundingBoxTree::Box> boxes(numBoxes);
+  for(size_t k = 0; k < numBoxes; k++)
+  {
+    for(size_t d = 0; d < 3; d++)
+    {
+      boxes[k].min[d] = centers[3 * k + d] - dimensions[3 * k + d] / 2.0;
+      boxes[k].max[d] = centers[3 * k + d] + dimensions[3 * k + d] / 2.0;
+    }
+  }
+  return boxes;
 }
 
+/**
+ * @brief findIndexRange Returns the half open range [first, last) of sample indices i for which
+ * origin + spacing * i lies strictly inside (minValue, maxValue). The range is estimated from the spacing and
+ * then corrected with the exact comparison so it matches the per sample test.
+ */
+std::pair<int64_t, int64_t> findIndexRange(float minValue, float maxValue, float origin, float spacing, int64_t dim)
+{
+  auto inside = [&](int64_t index) {
+    float value = origin + spacing * index;
+    return value > minValue && value < maxValue;
+  };
+  if(!(maxValue > minValue) || spacing <= 0.0f)
+  {
+    return {0, 0};
+  }
+  int64_t first = static_cast<int64_t>(std::max(0.0, std::min(static_cast<double>(dim), std::floor((static_cast<double>(minValue) - origin) / spacing))));
+  while(first > 0 && origin + spacing * (first - 1) > minValue)
+  {
+    first--;
+  }
+  while(first < dim && !inside(first))
+  {
+    first++;
+  }
+  int64_t estimate = static_cast<int64_t>(std::max(0.0, std::min(static_cast<double>(dim), std::ceil((static_cast<double>(maxValue) - origin) / spacing))));
+  int64_t last = std::max(first, estimate);
+  while(last > first && !inside(last - 1))
+  {
+    last--;
+  }
+  while(last < dim && inside(last))
+  {
+    last++;
+  }
+  return {first, last};
+}
+
+/**
+ * @brief isInsideBox Strict containment test used for every cell, edge and vertex
+ */
+inline bool isInsideBox(const BoundingBoxTree::Box& box, float x, float y, float z)
+{
+  return (x < box.max[0]) && (x > box.min[0]) && (y < box.max[1]) && (y > box.min[1]) && (z < box.max[2]) && (z > box.min[2]);
+}
+} // namespace
+
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
 enum createdPathID : RenameDataPath::DataID_t
 {
@@ -66,7 +136,7 @@ void GenerateFeatureIDsbyBoundingBoxes::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   DataArrayCreationFilterParameter::RequirementType dacReq;
-  dacReq.amTypes = {AttributeMatrix::Type::Vertex, AttributeMatrix::Type::Cell};
+  dacReq.amTypes = {AttributeMatrix::Type::Vertex, AttributeMatrix::Type::Edge, AttributeMatrix::Type::Cell};
   parameters.push_back(SIMPL_NEW_DA_CREATION_FP("Feature IDs", FeatureIDsArrayPath, FilterParameter::Category::CreatedArray, GenerateFeatureIDsbyBoundingBoxes, dacReq));
   AttributeMatrixCreationFilterParameter::RequirementType amcReq;
   parameters.push_back(SIMPL_NEW_AM_CREATION_FP("Feature Attribute Matrix", FeatureAttributeMatrixArrayPath, FilterParameter::Category::CreatedArray, GenerateFeatureIDsbyBoundingBoxes, amcReq));
@@ -101,26 +171,54 @@ void GenerateFeatureIDsbyBoundingBoxes::dataCheck()
   m_DestAttributeMatrixType = AttributeMatrix::Type::Unknown;
   AttributeMatrix::Type attrMatType = attrMat->getType();
 
+  // The execute paths index the geometry elements directly with the Feature IDs tuples, so the geometry must
+  // match the Attribute Matrix type and hold exactly one element per tuple
+  size_t numElements = 0;
   if(attrMatType == AttributeMatrix::Type::Vertex)
   {
     m_DestAttributeMatrixType = AttributeMatrix::Type::VertexFeature;
+    VertexGeom::Pointer vertex = getDataContainerArray()->getPrereqGeometryFromDataContainer<VertexGeom>(this, path.getDataContainerName());
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+    numElements = vertex->getNumberOfVertices();
   }
   else if(attrMatType == AttributeMatrix::Type::Cell)
   {
     m_DestAttributeMatrixType = AttributeMatrix::Type::CellFeature;
+    ImageGeom::Pointer image = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, path.getDataContainerName());
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+    numElements = image->getNumberOfElements();
+  }
+  else if(attrMatType == AttributeMatrix::Type::Edge)
+  {
+    m_DestAttributeMatrixType = AttributeMatrix::Type::EdgeFeature;
+    EdgeGeom::Pointer edge = getDataContainerArray()->getPrereqGeometryFromDataContainer<EdgeGeom>(this, path.getDataContainerName());
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+    numElements = edge->getNumberOfEdges();
   }
-  // else if (attrMatType == AttributeMatrix::Type::Edge)
-  //{
-  //  m_DestAttributeMatrixType = AttributeMatrix::Type::EdgeFeature;
-  //}
   else
   {
     m_DestAttributeMatrixType = AttributeMatrix::Type::Unknown;
-    QString ss = QObject::tr("The Attribute Matrix must have a cell, vertex geometry.");
+    QString ss = QObject::tr("The Attribute Matrix must have a cell, edge or vertex geometry.");
     setErrorCondition(::k_AttributeMatrixTypeSelectionError, ss);
     return;
   }
 
+  if(attrMat->getNumberOfTuples() != numElements)
+  {
+    QString ss = QObject::tr("The Attribute Matrix %1 has %2 tuples, but its Geometry has %3 elements").arg(attrMat->getName()).arg(attrMat->getNumberOfTuples()).arg(numElements);
+    setErrorCondition(::k_TupleCountMismatchError, ss);
+    return;
+  }
+
   std::vector<size_t> cDims = {1};
   m_BoxFeatureIdsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>>(this, getBoxFeatureIDsArrayPath(), cDims);
   if(nullptr != m_BoxFeatureIdsPtr.lock())
@@ -161,21 +259,12 @@ void GenerateFeatureIDsbyBoundingBoxes::dataCheck()
   m->createNonPrereqAttributeMatrix(this, getFeatureAttributeMatrixArrayPath(), tDims, m_DestAttributeMatrixType, AttributeMatrixID20);
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-bool IsPointInBounds(float xmax, float xmin, float ymax, float ymin, float zmax, float zmin, float x, float y, float z)
-{
-  return (x < xmax) && (x > xmin) && (y < ymax) && (y > ymin) && (z < zmax) && (z > zmin);
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 void GenerateFeatureIDsbyBoundingBoxes::checkBoundingBoxImage()
 {
   size_t totalNumFIDs = m_BoxFeatureIdsPtr.lock()->getNumberOfTuples();
-  size_t totalNumElementsDest = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(getFeatureIDsArrayPath().getDataContainerName());
   ImageGeom::Pointer image = dc->getGeometryAs<ImageGeom>();
   SizeVec3Type udims = image->getDimensions();
@@ -200,39 +289,50 @@ void GenerateFeatureIDsbyBoundingBoxes::checkBoundingBoxImage()
       static_cast<float>(uspacing[2]),
   };
 
-  for(size_t i = 0; i < totalNumElementsDest; i++)
-  {
-    int64_t zindex = i / (dims[0] * dims[1]);
-    int64_t tempMod = i % (dims[0] * dims[1]);
-    int64_t yindex = tempMod / (dims[0]);
-    int64_t xindex = tempMod % (dims[0]);
-
-    float currentx = origin[0] + spacing[0] * xindex;
-    float currenty = origin[1] + spacing[1] * yindex;
-    float currentz = origin[2] + spacing[2] * zindex;
-
-    bool inBounds = false;
-    size_t k = 0;
-
-    while(!inBounds && k < totalNumFIDs)
+  // Clip every box to the range of cell indices whose positions fall inside it
+  std::vector<BoundingBoxTree::Box> boxes = computeBoxBounds(m_BoxCenter, m_BoxDims, totalNumFIDs);
+  std::vector<std::array<int64_t, 6>> boxRanges(totalNumFIDs);
+  ParallelDataAlgorithm rangeAlg;
+  rangeAlg.setRange(0, totalNumFIDs);
+  rangeAlg.execute([&](const SIMPLRange& range) {
+    for(size_t k = range.min(); k < range.max(); k++)
     {
-      float xmin = m_BoxCenter[3 * k] - m_BoxDims[3 * k] / 2.0;
-      float xmax = m_BoxCenter[3 * k] + m_BoxDims[3 * k] / 2.0;
-      float ymin = m_BoxCenter[3 * k + 1] - m_BoxDims[3 * k + 1] / 2.0;
-      float ymax = m_BoxCenter[3 * k + 1] + m_BoxDims[3 * k + 1] / 2.0;
-      float zmin = m_BoxCenter[3 * k + 2] - m_BoxDims[3 * k + 2] / 2.0;
-      float zmax = m_BoxCenter[3 * k + 2] + m_BoxDims[3 * k + 2] / 2.0;
-
-      inBounds = IsPointInBounds(xmax, xmin, ymax, ymin, zmax, zmin, currentx, currenty, currentz);
-
-      if(inBounds)
+      for(size_t d = 0; d < 3; d++)
       {
-        m_FeatureIds[i] = m_BoxFeatureIds[k];
+        std::pair<int64_t, int64_t> indices = findIndexRange(boxes[k].min[d], boxes[k].max[d], origin[d], spacing[d], dims[d]);
+        boxRanges[k][2 * d] = indices.first;
+        boxRanges[k][2 * d + 1] = indices.second;
       }
-
-      k++;
     }
-  }
+  });
+
+  // Rasterize the boxes over blocks of z slices. Each block writes the boxes from last to first, so where
+  // boxes overlap the first box in the list wins, exactly as with the per cell search.
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, dims[2]);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    const int64_t zBegin = static_cast<int64_t>(range.min());
+    const int64_t zEnd = static_cast<int64_t>(range.max());
+    for(size_t k = totalNumFIDs; k-- > 0;)
+    {
+      const std::array<int64_t, 6>& box = boxRanges[k];
+      int64_t zFirst = std::max(box[4], zBegin);
+      int64_t zLast = std::min(box[5], zEnd);
+      if(box[0] >= box[1] || box[2] >= box[3] || zFirst >= zLast)
+      {
+        continue;
+      }
+      int32_t featureId = m_BoxFeatureIds[k];
+      for(int64_t z = zFirst; z < zLast; z++)
+      {
+        for(int64_t y = box[2]; y < box[3]; y++)
+        {
+          int32_t* row = m_FeatureIds + (z * dims[1] + y) * dims[0];
+          std::fill(row + box[0], row + box[1], featureId);
+        }
+      }
+    }
+  });
 }
 
 // -----------------------------------------------------------------------------
@@ -242,13 +342,32 @@ void GenerateFeatureIDsbyBoundingBoxes::checkBoundingBoxEdge()
 {
   size_t totalNumFIDs = m_BoxFeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalNumElementsDest = m_FeatureIdsPtr.lock()->getNumberOfTuples();
-
-  for(size_t i = 0; i < totalNumElementsDest; i++)
-  {
-    for(size_t k = 0; k < totalNumFIDs; k++)
+  DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(getFeatureIDsArrayPath().getDataContainerName());
+  EdgeGeom::Pointer edge = dc->getGeometryAs<EdgeGeom>();
+
+  std::vector<BoundingBoxTree::Box> boxes = computeBoxBounds(m_BoxCenter, m_BoxDims, totalNumFIDs);
+  BoundingBoxTree tree(std::move(boxes));
+
+  // Each edge is located by its midpoint
+  float* vertices = edge->getVertexPointer(0);
+  MeshIndexType* edges = edge->getEdgePointer(0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, totalNumElementsDest);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
+      float* v0 = vertices + 3 * edges[2 * i];
+      float* v1 = vertices + 3 * edges[2 * i + 1];
+      float x = 0.5f * (v0[0] + v1[0]);
+      float y = 0.5f * (v0[1] + v1[1]);
+      float z = 0.5f * (v0[2] + v1[2]);
+      int64_t box = tree.findFirstBox(x, y, z, [&](size_t k) { return isInsideBox(tree.getBox(k), x, y, z); });
+      if(box >= 0)
+      {
+        m_FeatureIds[i] = m_BoxFeatureIds[box];
+      }
     }
-  }
+  });
 }
 
 // -----------------------------------------------------------------------------
@@ -261,34 +380,25 @@ void GenerateFeatureIDsbyBoundingBoxes::checkBoundingBoxVertex()
   DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(getFeatureIDsArrayPath().getDataContainerName());
   VertexGeom::Pointer vertex = dc->getGeometryAs<VertexGeom>();
 
-  float* vertices = vertex->getVertexPointer(0);
-  for(size_t i = 0; i < totalNumElementsDest; i++)
-  {
-    bool inBounds = false;
-    size_t k = 0;
-    float currentx = vertices[3 * i];
-    float currenty = vertices[3 * i + 1];
-    float currentz = vertices[3 * i + 2];
+  std::vector<BoundingBoxTree::Box> boxes = computeBoxBounds(m_BoxCenter, m_BoxDims, totalNumFIDs);
+  BoundingBoxTree tree(std::move(boxes));
 
-    while(!inBounds && k < totalNumFIDs)
+  float* vertices = vertex->getVertexPointer(0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, totalNumElementsDest);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      float xmin = m_BoxCenter[3 * k] - m_BoxDims[3 * k] / 2.0;
-      float xmax = m_BoxCenter[3 * k] + m_BoxDims[3 * k] / 2.0;
-      float ymin = m_BoxCenter[3 * k + 1] - m_BoxDims[3 * k + 1] / 2.0;
-      float ymax = m_BoxCenter[3 * k + 1] + m_BoxDims[3 * k + 1] / 2.0;
-      float zmin = m_BoxCenter[3 * k + 2] - m_BoxDims[3 * k + 2] / 2.0;
-      float zmax = m_BoxCenter[3 * k + 2] + m_BoxDims[3 * k + 2] / 2.0;
-
-      inBounds = IsPointInBounds(xmax, xmin, ymax, ymin, zmax, zmin, currentx, currenty, currentz);
-
-      if(inBounds)
+      float x = vertices[3 * i];
+      float y = vertices[3 * i + 1];
+      float z = vertices[3 * i + 2];
+      int64_t box = tree.findFirstBox(x, y, z, [&](size_t k) { return isInsideBox(tree.getBox(k), x, y, z); });
+      if(box >= 0)
       {
-        m_FeatureIds[i] = m_BoxFeatureIds[k];
+        m_FeatureIds[i] = m_BoxFeatureIds[box];
       }
-
-      k++;
     }
-  }
+  });
 }
 
 // -----------------------------------------------------------------------------
@@ -316,10 +426,10 @@ void GenerateFeatureIDsbyBoundingBoxes::execute()
   {
     checkBoundingBoxVertex();
   }
-  // else if(m_DestAttributeMatrixType == AttributeMatrix::Type::EdgeFeature)
-  // {
-  //   checkBoundingBoxEdge();
-  // }
+  else if(m_DestAttributeMatrixType == AttributeMatrix::Type::EdgeFeature)
+  {
+    checkBoundingBoxEdge();
+  }
 }
 
 // -----------------------------------------------------------------------------
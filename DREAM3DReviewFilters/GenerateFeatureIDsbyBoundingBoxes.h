@@ -182,17 +182,17 @@ protected:
   void initialize();
 
   /**
-   * @brief Initializes all the private instance variables.
+   * @brief Assigns each cell of an Image Geometry the feature ID of the first box containing it
    */
   void checkBoundingBoxImage();
 
   /**
-   * @brief Initializes all the private instance variables.
+   * @brief Assigns each edge of an Edge Geometry the feature ID of the first box containing its midpoint
    */
   void checkBoundingBoxEdge();
 
   /**
-   * @brief Initializes all the private instance variables.
+   * @brief Assigns each vertex of a Vertex Geometry the feature ID of the first box containing it
    */
   void checkBoundingBoxVertex();
 
@@ -4,12 +4,16 @@
 
 #include "GenerateMaskFromSimpleShapes.h"
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <utility>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
@@ -17,9 +21,11 @@
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Geometry/VertexGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/BoundingBoxTree.hpp"
 
 // -----------------------------------------------------------------------------
 //
@@ -106,7 +112,7 @@ void GenerateMaskFromSimpleShapes::dataCheck()
 
   AttributeMatrix::Type attrMatType = attrMat->getType();
 
-  if(attrMatType == AttributeMatrix::Type::Vertex || attrMatType == AttributeMatrix::Type::Cell)
+  if(attrMatType != AttributeMatrix::Type::Vertex && attrMatType != AttributeMatrix::Type::Cell)
   {
     QString ss = QObject::tr("The Attribute Matrix must have a cell or vertex geometry.");
     setErrorCondition(-5555, ss);
@@ -196,13 +202,131 @@ bool IsPointInEllipsoidBounds(float xcenter, float ycenter, float zcenter, float
 {
   return ((xcenter - x) * (xcenter - x) / (a * a) + (ycenter - y) * (ycenter - y) / (b * b) + (zcenter - z) * (zcenter - z) / (c * c)) < 1;
 }
+
+namespace
+{
+// Relative slack on the analytic cross sections, so rows that only graze a shape in single precision are kept
+constexpr double k_RowTolerance = 1.0e-5;
+
+/**
+ * @brief estimateIndexRange Returns the half open range of sample indices i for which origin + spacing * i may
+ * lie in [minValue, maxValue]. The range is padded by one sample on each side to absorb rounding; callers trim
+ * it with the exact containment test.
+ */
+std::pair<int64_t, int64_t> estimateIndexRange(double minValue, double maxValue, float origin, float spacing, int64_t dim)
+{
+  if(!(maxValue >= minValue))
+  {
+    return {0, 0};
+  }
+  if(!(spacing > 0.0f))
+  {
+    return {0, dim};
+  }
+  auto clampIndex = [dim](double index) { return static_cast<int64_t>(std::max(0.0, std::min(static_cast<double>(dim), index))); };
+  return {clampIndex(std::floor((minValue - origin) / spacing) - 1.0), clampIndex(std::ceil((maxValue - origin) / spacing) + 2.0)};
+}
+
+/**
+ * @brief The ShapeQuery class wraps the exact containment test of the selected shape together with the
+ * analytic extents used to bound it: the half extents of its bounding box and the half width in x of its
+ * cross section along a row at a given (y, z).
+ */
+class ShapeQuery
+{
+public:
+  ShapeQuery(int shape, const float* centers, const float* axisLengths, const float* boxDims, const float* cylinderRadii, const float* cylinderHeights)
+  : m_Shape(shape)
+  , m_Centers(centers)
+  , m_AxisLengths(axisLengths)
+  , m_BoxDims(boxDims)
+  , m_CylinderRadii(cylinderRadii)
+  , m_CylinderHeights(cylinderHeights)
+  {
+  }
+
+  bool contains(size_t k, float x, float y, float z) const
+  {
+    const float* center = m_Centers + 3 * k;
+    switch(m_Shape)
+    {
+    case 0:
+      return IsPointInEllipsoidBounds(center[0], center[1], center[2], m_AxisLengths[3 * k], m_AxisLengths[3 * k + 1], m_AxisLengths[3 * k + 2], x, y, z);
+    case 1:
+      return IsPointInBoxBounds(center[0], center[1], center[2], m_BoxDims[3 * k], m_BoxDims[3 * k + 1], m_BoxDims[3 * k + 2], x, y, z);
+    case 2:
+      return IsPointInCylinderBounds(center[0], center[1], center[2], m_CylinderRadii[k], m_CylinderHeights[k], x, y, z);
+    default:
+      return false;
+    }
+  }
+
+  std::array<double, 3> halfExtents(size_t k) const
+  {
+    switch(m_Shape)
+    {
+    case 0:
+      return {std::fabs(m_AxisLengths[3 * k]), std::fabs(m_AxisLengths[3 * k + 1]), std::fabs(m_AxisLengths[3 * k + 2])};
+    case 1:
+      return {m_BoxDims[3 * k] / 2.0, m_BoxDims[3 * k + 1] / 2.0, m_BoxDims[3 * k + 2] / 2.0};
+    case 2:
+      return {m_CylinderRadii[k], m_CylinderRadii[k], m_CylinderHeights[k] / 2.0};
+    default:
+      return {-1.0, -1.0, -1.0};
+    }
+  }
+
+  /**
+   * @brief rowHalfWidth Half width in x of the shape's cross section with the row at (y, z); negative or NaN
+   * when the row misses the shape
+   */
+  double rowHalfWidth(size_t k, double y, double z) const
+  {
+    const double dy = y - m_Centers[3 * k + 1];
+    const double dz = z - m_Centers[3 * k + 2];
+    switch(m_Shape)
+    {
+    case 0:
+    {
+      const double b = m_AxisLengths[3 * k + 1];
+      const double c = m_AxisLengths[3 * k + 2];
+      const double remainder = 1.0 - dy * dy / (b * b) - dz * dz / (c * c);
+      return remainder < -k_RowTolerance ? -1.0 : std::fabs(m_AxisLengths[3 * k]) * std::sqrt(std::max(0.0, remainder));
+    }
+    case 1:
+      return m_BoxDims[3 * k] / 2.0;
+    case 2:
+    {
+      const double radius = m_CylinderRadii[k];
+      const double remainder = radius * radius - dy * dy;
+      return remainder < -k_RowTolerance * radius * radius ? -1.0 : std::sqrt(std::max(0.0, remainder));
+    }
+    default:
+      return -1.0;
+    }
+  }
+
+  float centerX(size_t k) const
+  {
+    return m_Centers[3 * k];
+  }
+
+private:
+  int m_Shape;
+  const float* m_Centers;
+  const float* m_AxisLengths;
+  const float* m_BoxDims;
+  const float* m_CylinderRadii;
+  const float* m_CylinderHeights;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 void GenerateMaskFromSimpleShapes::createImageMask()
 {
   size_t totalNumFIDs = m_CentersPtr.lock()->getNumberOfTuples();
-  size_t totalNumElementsDest = m_MaskPtr.lock()->getNumberOfTuples();
   DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(getMaskArrayPath().getDataContainerName());
   ImageGeom::Pointer image = dc->getGeometryAs<ImageGeom>();
   SizeVec3Type udims = image->getDimensions();
@@ -227,112 +351,53 @@ void GenerateMaskFromSimpleShapes::createImageMask()
       static_cast<float>(uspacing[2]),
   };
 
-  bool inBounds = false;
-
-  float currentx = 0;
-  float currenty = 0;
-  float currentz = 0;
+  ShapeQuery shapes(m_MaskShape, m_Centers, m_AxisLengths, m_BoxDims, m_CylinderRad, m_CylinderHeight);
 
-  int64_t xindex = 0;
-  int64_t yindex = 0;
-  int64_t zindex = 0;
-  int64_t tempMod = 0;
-
-  size_t k = 0;
-
-  if(m_MaskShape == 0)
+  // Bound every shape by the y and z index ranges of its bounding box
+  std::vector<std::array<int64_t, 4>> shapeRanges(totalNumFIDs);
+  for(size_t k = 0; k < totalNumFIDs; k++)
   {
-    for(size_t i = 0; i < totalNumElementsDest; i++)
-    {
-
-      zindex = i / (dims[0] * dims[1]);
-      tempMod = i % (dims[0] * dims[1]);
-      yindex = tempMod / (dims[0]);
-      xindex = tempMod % (dims[0]);
-
-      currentx = origin[0] + spacing[0] * xindex;
-      currenty = origin[1] + spacing[1] * yindex;
-      currentz = origin[2] + spacing[2] * zindex;
-
-      inBounds = false;
-      k = 0;
-
-      while(!inBounds && k < totalNumFIDs)
-      {
-        inBounds = IsPointInEllipsoidBounds(m_Centers[3 * k], m_Centers[3 * k + 1], m_Centers[3 * k + 2], m_AxisLengths[3 * k], m_AxisLengths[3 * k + 1], m_AxisLengths[3 * k + 2], currentx, currenty,
-                                            currentz);
-
-        if(inBounds)
-        {
-          m_Mask[i] = true;
-        }
-
-        k++;
-      }
-    }
+    std::array<double, 3> extents = shapes.halfExtents(k);
+    std::pair<int64_t, int64_t> yRange = estimateIndexRange(m_Centers[3 * k + 1] - extents[1], m_Centers[3 * k + 1] + extents[1], origin[1], spacing[1], dims[1]);
+    std::pair<int64_t, int64_t> zRange = estimateIndexRange(m_Centers[3 * k + 2] - extents[2], m_Centers[3 * k + 2] + extents[2], origin[2], spacing[2], dims[2]);
+    shapeRanges[k] = {yRange.first, yRange.second, zRange.first, zRange.second};
   }
 
-  if(m_MaskShape == 1)
-  {
-    for(size_t i = 0; i < totalNumElementsDest; i++)
+  // Within those ranges every row only visits the analytic x span of the shape's cross section, trimmed with
+  // the exact per cell test. The volume is split into blocks of z slices so no two threads share a cell.
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, dims[2]);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    const int64_t zBegin = static_cast<int64_t>(range.min());
+    const int64_t zEnd = static_cast<int64_t>(range.max());
+    for(size_t k = 0; k < totalNumFIDs; k++)
     {
-
-      zindex = i / (dims[0] * dims[1]);
-      tempMod = i % (dims[0] * dims[1]);
-      yindex = tempMod / (dims[0]);
-      xindex = tempMod % (dims[0]);
-
-      currentx = origin[0] + spacing[0] * xindex;
-      currenty = origin[1] + spacing[1] * yindex;
-      currentz = origin[2] + spacing[2] * zindex;
-
-      inBounds = false;
-      k = 0;
-
-      while(!inBounds && k < totalNumFIDs)
-      {
-        inBounds = IsPointInBoxBounds(m_Centers[3 * k], m_Centers[3 * k + 1], m_Centers[3 * k + 2], m_BoxDims[0], m_BoxDims[1], m_BoxDims[2], currentx, currenty, currentz);
-
-        if(inBounds)
-        {
-          m_Mask[i] = true;
-        }
-
-        k++;
-      }
-    }
-  }
-
-  if(m_MaskShape == 2)
-  {
-    for(size_t i = 0; i < totalNumElementsDest; i++)
-    {
-
-      zindex = i / (dims[0] * dims[1]);
-      tempMod = i % (dims[0] * dims[1]);
-      yindex = tempMod / (dims[0]);
-      xindex = tempMod % (dims[0]);
-
-      currentx = origin[0] + spacing[0] * xindex;
-      currenty = origin[1] + spacing[1] * yindex;
-      currentz = origin[2] + spacing[2] * zindex;
-
-      inBounds = false;
-      k = 0;
-
-      while(!inBounds && k < totalNumFIDs)
+      const std::array<int64_t, 4>& shapeRange = shapeRanges[k];
+      const int64_t zFirst = std::max(shapeRange[2], zBegin);
+      const int64_t zLast = std::min(shapeRange[3], zEnd);
+      for(int64_t zindex = zFirst; zindex < zLast; zindex++)
       {
-        inBounds = IsPointInCylinderBounds(m_Centers[3 * k], m_Centers[3 * k + 1], m_Centers[3 * k + 2], m_CylinderRad[k], m_CylinderHeight[k], currentx, currenty, currentz);
-
-        if(inBounds)
+        const float currentz = origin[2] + spacing[2] * zindex;
+        for(int64_t yindex = shapeRange[0]; yindex < shapeRange[1]; yindex++)
         {
-          m_Mask[i] = true;
+          const float currenty = origin[1] + spacing[1] * yindex;
+          const double halfWidth = shapes.rowHalfWidth(k, currenty, currentz);
+          std::pair<int64_t, int64_t> xRange = estimateIndexRange(shapes.centerX(k) - halfWidth, shapes.centerX(k) + halfWidth, origin[0], spacing[0], dims[0]);
+          auto inside = [&](int64_t xindex) { return shapes.contains(k, origin[0] + spacing[0] * xindex, currenty, currentz); };
+          while(xRange.first < xRange.second && !inside(xRange.first))
+          {
+            xRange.first++;
+          }
+          while(xRange.second > xRange.first && !inside(xRange.second - 1))
+          {
+            xRange.second--;
+          }
+          bool* row = m_Mask + (zindex * dims[1] + yindex) * dims[0];
+          std::fill(row + xRange.first, row + xRange.second, true);
         }
-
-        k++;
       }
     }
-  }
+  });
 }
 // -----------------------------------------------------------------------------
 //
@@ -344,87 +409,37 @@ void GenerateMaskFromSimpleShapes::createVertexMask()
   DataContainer::Pointer dc = getDataContainerArray()->getDataContainer(getMaskArrayPath().getDataContainerName());
   VertexGeom::Pointer vertex = dc->getGeometryAs<VertexGeom>();
 
-  bool inBounds = false;
-
-  float currentx = 0;
-  float currenty = 0;
-  float currentz = 0;
-
-  float* vertices = vertex->getVertexPointer(0);
-  size_t k = 0;
-
-  if(m_MaskShape == 0)
-  {
-    for(size_t i = 0; i < totalNumElementsDest; i++)
-    {
-      inBounds = false;
-      k = 0;
-      currentx = vertices[3 * i];
-      currenty = vertices[3 * i + 1];
-      currentz = vertices[3 * i + 2];
-
-      while(!inBounds && k < totalNumCenters)
-      {
-        inBounds = IsPointInEllipsoidBounds(m_Centers[3 * k], m_Centers[3 * k + 1], m_Centers[3 * k + 2], m_AxisLengths[3 * k], m_AxisLengths[3 * k + 1], m_AxisLengths[3 * k + 2], currentx, currenty,
-                                            currentz);
-
-        if(inBounds)
-        {
-          m_Mask[i] = true;
-        }
-
-        k++;
-      }
-    }
-  }
+  ShapeQuery shapes(m_MaskShape, m_Centers, m_AxisLengths, m_BoxDims, m_CylinderRad, m_CylinderHeight);
 
-  if(m_MaskShape == 1)
+  // Index the bounding boxes of the shapes so each vertex only runs the exact test against shapes whose box
+  // contains it
+  std::vector<BoundingBoxTree::Box> boxes(totalNumCenters);
+  for(size_t k = 0; k < totalNumCenters; k++)
   {
-    for(size_t i = 0; i < totalNumElementsDest; i++)
+    std::array<double, 3> extents = shapes.halfExtents(k);
+    for(size_t d = 0; d < 3; d++)
     {
-      inBounds = false;
-      k = 0;
-      currentx = vertices[3 * i];
-      currenty = vertices[3 * i + 1];
-      currentz = vertices[3 * i + 2];
-
-      while(!inBounds && k < totalNumCenters)
-      {
-        inBounds = IsPointInBoxBounds(m_Centers[3 * k], m_Centers[3 * k + 1], m_Centers[3 * k + 2], m_BoxDims[3 * k], m_BoxDims[3 * k + 1], m_BoxDims[3 * k + 2], currentx, currenty, currentz);
-
-        if(inBounds)
-        {
-          m_Mask[i] = true;
-        }
-
-        k++;
-      }
+      boxes[k].min[d] = static_cast<float>(m_Centers[3 * k + d] - extents[d]);
+      boxes[k].max[d] = static_cast<float>(m_Centers[3 * k + d] + extents[d]);
     }
   }
+  BoundingBoxTree tree(std::move(boxes));
 
-  if(m_MaskShape == 2)
-  {
-    for(size_t i = 0; i < totalNumElementsDest; i++)
+  float* vertices = vertex->getVertexPointer(0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, totalNumElementsDest);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      inBounds = false;
-      k = 0;
-      currentx = vertices[3 * i];
-      currenty = vertices[3 * i + 1];
-      currentz = vertices[3 * i + 2];
-
-      while(!inBounds && k < totalNumCenters)
+      float currentx = vertices[3 * i];
+      float currenty = vertices[3 * i + 1];
+      float currentz = vertices[3 * i + 2];
+      if(tree.findFirstBox(currentx, currenty, currentz, [&](size_t k) { return shapes.contains(k, currentx, currenty, currentz); }) >= 0)
       {
-        inBounds = IsPointInCylinderBounds(m_Centers[3 * k], m_Centers[3 * k + 1], m_Centers[3 * k + 2], m_CylinderRad[k], m_CylinderHeight[k], currentx, currenty, currentz);
-
-        if(inBounds)
-        {
-          m_Mask[i] = true;
-        }
-
-        k++;
+        m_Mask[i] = true;
       }
     }
-  }
+  });
 }
 
 // -----------------------------------------------------------------------------
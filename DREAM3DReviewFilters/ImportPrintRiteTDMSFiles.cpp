@@ -1190,12 +1190,10 @@ void ImportPrintRiteTDMSFiles::determinePointsForLeastSquares(const PRH::Polygon
   {
     if(pointsToPolys.second[p])
     {
-      TriMesh::VertexCoordList vertexList(polygons.polygons[p].vertices.size(), std::vector<float>(3));
+      TriMesh::VertexCoordList vertexList(polygons.polygons[p].vertices.size());
       for(auto v = 0; v < vertexList.size(); v++)
       {
-        vertexList[v][0] = polygons.polygons[p].vertices[v].x;
-        vertexList[v][1] = polygons.polygons[p].vertices[v].y;
-        vertexList[v][2] = 0.0f;
+        vertexList.setCoordinates(v, polygons.polygons[p].vertices[v].x, polygons.polygons[p].vertices[v].y, 0.0f);
       }
       Delaunay2D::Pointer delaunay = Delaunay2D::New(vertexList, 1.0, 1e-05, 0.0);
       QString ss = QObject::tr("Finding STL Region Convex Hulls || Region %1 of %2").arg(counter).arg(numValidPolys);
@@ -1250,8 +1248,7 @@ void ImportPrintRiteTDMSFiles::determinePointsForLeastSquares(const PRH::Polygon
   {
     if(maskPtr[i] && pointsToPolysPtr[i] >= 0)
     {
-      std::vector<float> vert = {tdmsPtr[2 * i + 0], tdmsPtr[2 * i + 1], 0.0f};
-      vertexLists[pointsToPolysPtr[i]].push_back(vert);
+      vertexLists[pointsToPolysPtr[i]].push_back(tdmsPtr[2 * i + 0], tdmsPtr[2 * i + 1], 0.0f);
     }
   }
 
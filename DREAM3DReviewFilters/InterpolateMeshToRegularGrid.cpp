@@ -14,10 +14,12 @@
 
 #include "InterpolateMeshToRegularGrid.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include <QtCore/QTextStream>
 
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/Common/TemplateHelpers.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
@@ -31,12 +33,45 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Geometry/QuadGeom.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
-#include "DREAM3DReview/DREAM3DReviewFilters/util/DifferentialGeometryOps.hpp"
-#include "DREAM3DReview/DREAM3DReviewFilters/util/DistanceTemplate.hpp"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/nanoflann.hpp"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
 
+namespace
+{
+struct CentroidAdaptor
+{
+  const float* centroids;
+  size_t numCentroids;
+
+  CentroidAdaptor(const float* centroids_, size_t numCentroids_)
+  : centroids(centroids_)
+  , numCentroids(numCentroids_)
+  {
+  }
+
+  inline size_t kdtree_get_point_count() const
+  {
+    return numCentroids;
+  }
+
+  inline float kdtree_get_pt(const size_t idx, const size_t dim) const
+  {
+    return centroids[3 * idx + dim];
+  }
+
+  template <class BBOX>
+  bool kdtree_get_bbox(BBOX& /*bb*/) const
+  {
+    return false;
+  }
+};
+
+using CentroidTree = nanoflann::KDTreeSingleIndexAdaptor<nanoflann::L2_Simple_Adaptor<float, CentroidAdaptor>, CentroidAdaptor, 3>;
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -213,8 +248,8 @@ void InterpolateMeshToRegularGrid::createRegularGrid()
 
   image->setDimensions(iDims[0], iDims[1], iDims[2]);
 
-  QVector<float> iRes(3, 0.0f);
-  QVector<float> iOrigin(3, 0.0f);
+  FloatVec3Type iRes(0.0f, 0.0f, 0.0f);
+  FloatVec3Type iOrigin(0.0f, 0.0f, 0.0f);
   float minRes = -1.0f * std::numeric_limits<float>::max();
 
   iRes[0] = m_MeshMaxExtents[0] / (static_cast<float>(iDims[0]));
@@ -234,7 +269,7 @@ void InterpolateMeshToRegularGrid::createRegularGrid()
   iOrigin[2] = m_MeshMinExtents[2];
 
   image->setSpacing(minRes, minRes, minRes);
-  image->setOrigin(iOrigin[0], iOrigin[1], iOrigin[2]);
+  image->setOrigin(iOrigin);
 
   interpolatedAttrMat->resizeAttributeArrays(iDims);
 }
@@ -281,136 +316,99 @@ void InterpolateMeshToRegularGrid::interpolateMeshPointsToGrid(DataContainer::Po
   }
 
   SharedEdgeList::Pointer bEdges = geom2D->getUnsharedEdges();
-  int64_t* edge = bEdges->getPointer(0);
+  MeshIndexType* edge = bEdges->getPointer(0);
   size_t numBoundaryEdges = bEdges->getNumberOfTuples();
 
-  int64_t startVertex = 0;
-  QVector<int64_t> woundVertices;
-
-  startVertex = edge[0];
-  woundVertices.push_back(startVertex);
-  ;
-  QSet<int32_t> visitedEdges;
-  visitedEdges.insert(0);
-
-  while(visitedEdges.size() < numBoundaryEdges)
-  {
-    for(size_t i = 1; i < numBoundaryEdges; i++)
+  FloatVec3Type iRes = image->getSpacing();
+  SizeVec3Type iDims = image->getDimensions();
+  FloatVec3Type iOrigin = image->getOrigin();
+
+  // Determine if cells lie within the original mesh geometry with an even-odd scanline fill of the
+  // unshared edges: every row collects the x positions where boundary edges cross it, sorts them,
+  // and marks the cells between each pair of crossings. The boundary edges are used directly, so
+  // any number of outer boundary loops and holes is handled without winding them. Edges are half
+  // open in y, so a scanline passing through a boundary vertex counts it exactly once. The mask does
+  // not depend on z; rows are filled in parallel for the first slice and copied to the others.
+  const size_t sliceSize = iDims[0] * iDims[1];
+
+  ParallelDataAlgorithm rowAlg;
+  rowAlg.setRange(0, iDims[1]);
+  rowAlg.execute([&](const SIMPLRange& range) {
+    std::vector<float> crossings;
+    for(size_t y = range.min(); y < range.max(); y++)
     {
-      if(!visitedEdges.contains(i))
+      const float rowY = float(y) * iRes[1] + iOrigin[1];
+      crossings.clear();
+      for(size_t e = 0; e < numBoundaryEdges; e++)
       {
-        if(edge[2 * i] == startVertex)
-        {
-          woundVertices.push_back(edge[2 * i + 1]);
-          startVertex = edge[2 * i + 1];
-          visitedEdges.insert(i);
-          break;
-        }
-        else if(edge[2 * i + 1] == startVertex)
+        const float* v0 = vertex + 3 * edge[2 * e + 0];
+        const float* v1 = vertex + 3 * edge[2 * e + 1];
+        if((v0[1] <= rowY) != (v1[1] <= rowY))
         {
-          woundVertices.push_back(edge[2 * i]);
-          startVertex = edge[2 * i];
-          visitedEdges.insert(i);
-          break;
+          float t = (rowY - v0[1]) / (v1[1] - v0[1]);
+          crossings.push_back(v0[0] + t * (v1[0] - v0[0]));
         }
       }
-    }
-  }
+      std::sort(crossings.begin(), crossings.end());
 
-  // Determine if cells lie within the original mesh geometry
-  size_t index = 0;
-  FloatVec3Type iPos;
-  FloatVec3Type iRes;
-  image->getSpacing(iRes);
-  size_t iDims[3] = {0, 0, 0};
-  std::tie(iDims[0], iDims[1], iDims[2]) = image->getDimensions();
-  float iOrigin[3] = {0, 0, 0};
-  image->getOrigin(iOrigin);
-
-  bool insidePolygon = false;
-  float xEpsilon = iRes[0] / 2.0f;
-  float yEpsilon = iRes[1] / 2.0f;
-
-  DifferentialGeometryOps diffGeomPimpl;
-
-  for(size_t z = 0; z < iDims[2]; z++)
-  {
-    for(size_t y = 0; y < iDims[1]; y++)
-    {
-      for(size_t x = 0; x < iDims[0]; x++)
+      for(size_t c = 0; c + 1 < crossings.size(); c += 2)
       {
-        index = (z * iDims[0] * iDims[1]) + (iDims[0] * y) + x;
-
-        // Find the (x,y,z) position of the current cell in the interpolated grid
-        iPos[0] = float(x) * iRes[0] + iOrigin[0];
-        iPos[1] = float(y) * iRes[1] + iOrigin[1];
-        iPos[2] = float(z) * iRes[2] + iOrigin[2];
-
-        // If the cell is on the boundary, move its position by epsilon
-        if(iPos[0] == 0)
-        {
-          iPos[0] += xEpsilon;
-        }
-        else if(iPos[1] == 0)
-        {
-          iPos[1] += yEpsilon;
-        }
-
-        // Apply point-in-poygon
-        insidePolygon = diffGeomPimpl.pointInPolygon(iPos[0], iPos[1], woundVertices, vertex);
-
-        // If the point passes point-in-polygon, then we are inside the mesh ; else, we are outside the mesh
-        if(insidePolygon)
+        float first = std::ceil((crossings[c] - iOrigin[0]) / iRes[0]);
+        float last = std::ceil((crossings[c + 1] - iOrigin[0]) / iRes[0]);
+        size_t xBegin = static_cast<size_t>(std::max(first, 0.0f));
+        size_t xEnd = static_cast<size_t>(std::min(std::max(last, 0.0f), static_cast<float>(iDims[0])));
+        for(size_t x = xBegin; x < xEnd; x++)
         {
-          m_InsideMesh[index] = true;
+          m_InsideMesh[iDims[0] * y + x] = 1;
         }
       }
     }
-  }
+  });
 
-  // Set the interpolated data point to the point closest to the original mesh
-  DistanceTemplate distancePimpl;
-
-  for(size_t z = 0; z < iDims[2]; z++)
+  for(size_t z = 1; z < iDims[2]; z++)
   {
-    for(size_t y = 0; y < iDims[1]; y++)
-    {
-      for(size_t x = 0; x < iDims[0]; x++)
-      {
-        index = (z * iDims[0] * iDims[1]) + (iDims[0] * y) + x;
-
-        // Find the (x,y,z) position of the current cell in the interpolated grid
-        iPos[0] = float(x) * iRes[0] + iOrigin[0];
-        iPos[1] = float(y) * iRes[1] + iOrigin[1];
-        iPos[2] = float(z) * iRes[2] + iOrigin[2];
-
-        // Find the index of the closest input cell centroid to the interpolated grid position
-        float minDist = std::numeric_limits<float>::max();
-        float dist = 0.0f;
-        size_t ptrIndex = 0;
-
-        for(size_t i = 0; i < numElements; i++)
-        {
-          dist = distancePimpl.getDistance<float, float, float>(cellCentroids + (nDims * i), iPos, nDims, 0);
-          if(dist < minDist)
-          {
-            minDist = dist;
-            ptrIndex = i;
-          }
-        }
+    std::copy(m_InsideMesh.begin(), m_InsideMesh.begin() + sliceSize, m_InsideMesh.begin() + z * sliceSize);
+  }
 
-        m_InterpolatedIndex[index] = ptrIndex;
-      }
+  // Set the interpolated data point to the point closest to the original mesh; the closest element
+  // centroid is found through a kd-tree, and the queries are independent so the cells are processed
+  // in parallel
+  const CentroidAdaptor adaptor(cellCentroids, numElements);
+  CentroidTree centroidTree(static_cast<int>(nDims), adaptor, nanoflann::KDTreeSingleIndexAdaptorParams(10));
+  centroidTree.buildIndex();
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, iDims[0] * iDims[1] * iDims[2]);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    float cellPos[3] = {0.0f, 0.0f, 0.0f};
+    for(size_t index = range.min(); index < range.max(); index++)
+    {
+      size_t x = index % iDims[0];
+      size_t y = (index / iDims[0]) % iDims[1];
+      size_t z = index / (iDims[0] * iDims[1]);
+
+      // Find the (x,y,z) position of the current cell in the interpolated grid
+      cellPos[0] = float(x) * iRes[0] + iOrigin[0];
+      cellPos[1] = float(y) * iRes[1] + iOrigin[1];
+      cellPos[2] = float(z) * iRes[2] + iOrigin[2];
+
+      size_t ptrIndex = 0;
+      float minDist = std::numeric_limits<float>::max();
+      nanoflann::KNNResultSet<float> results(1);
+      results.init(&ptrIndex, &minDist);
+      centroidTree.findNeighbors(results, cellPos, nanoflann::SearchParams());
+
+      m_InterpolatedIndex[index] = ptrIndex;
     }
-  }
+  });
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 template <typename inDataType>
-void copyDataToInterpolatedGrid(IDataArray::Pointer inDataPtr, IDataArray::Pointer outDataPtr, DataContainer::Pointer interpolatedGrid, std::vector<bool> insideMesh,
-                                const std::vector<size_t> interpolatedIndex, int outsideMeshVal)
+void copyDataToInterpolatedGrid(IDataArray::Pointer inDataPtr, IDataArray::Pointer outDataPtr, DataContainer::Pointer interpolatedGrid, const std::vector<uint8_t>& insideMesh,
+                                const std::vector<size_t>& interpolatedIndex, int outsideMeshVal)
 {
   // Cast the IDataArray pointers to the correct types
   typename DataArray<inDataType>::Pointer inputDataPtr = std::dynamic_pointer_cast<DataArray<inDataType>>(inDataPtr);
@@ -418,9 +416,8 @@ void copyDataToInterpolatedGrid(IDataArray::Pointer inDataPtr, IDataArray::Point
   typename DataArray<inDataType>::Pointer interpolatedDataPtr = std::dynamic_pointer_cast<DataArray<inDataType>>(outDataPtr);
   inDataType* interpolatedData = static_cast<inDataType*>(interpolatedDataPtr->getPointer(0));
 
-  size_t iDims[3] = {0, 0, 0};
   ImageGeom::Pointer image = interpolatedGrid->getGeometryAs<ImageGeom>();
-  std::tie(iDims[0], iDims[1], iDims[2]) = image->getDimensions();
+  SizeVec3Type iDims = image->getDimensions();
 
   size_t nComps = inDataPtr->getNumberOfComponents();
   size_t index = 0;
@@ -481,12 +478,12 @@ void findVertexAverage(AbstractFilter* filter, IDataArray::Pointer inDataPtr, Da
     {
     case IGeometry::Type::Triangle: {
       TriangleGeom::Pointer tris = std::dynamic_pointer_cast<TriangleGeom>(geom2D);
-      GeometryHelpers::Generic::WeightedAverageVertexArrayValues<int64_t, DataType>(tris->getTriangles(), tris->getVertices(), tris->getElementCentroids(), inputDataPtr, outDataPtr);
+      GeometryHelpers::Generic::WeightedAverageVertexArrayValues<MeshIndexType, DataType>(tris->getTriangles(), tris->getVertices(), tris->getElementCentroids(), inputDataPtr, outDataPtr);
       break;
     }
     case IGeometry::Type::Quad: {
       QuadGeom::Pointer quads = std::dynamic_pointer_cast<QuadGeom>(geom2D);
-      GeometryHelpers::Generic::WeightedAverageVertexArrayValues<int64_t, DataType>(quads->getQuads(), quads->getVertices(), quads->getElementCentroids(), inputDataPtr, outDataPtr);
+      GeometryHelpers::Generic::WeightedAverageVertexArrayValues<MeshIndexType, DataType>(quads->getQuads(), quads->getVertices(), quads->getElementCentroids(), inputDataPtr, outDataPtr);
       break;
     }
     case IGeometry::Type::Image:
@@ -511,12 +508,12 @@ void findVertexAverage(AbstractFilter* filter, IDataArray::Pointer inDataPtr, Da
     {
     case IGeometry::Type::Triangle: {
       TriangleGeom::Pointer tris = std::dynamic_pointer_cast<TriangleGeom>(geom2D);
-      GeometryHelpers::Generic::AverageVertexArrayValues<int64_t, DataType>(tris->getTriangles(), inputDataPtr, outDataPtr);
+      GeometryHelpers::Generic::AverageVertexArrayValues<MeshIndexType, DataType>(tris->getTriangles(), inputDataPtr, outDataPtr);
       break;
     }
     case IGeometry::Type::Quad: {
       QuadGeom::Pointer quads = std::dynamic_pointer_cast<QuadGeom>(geom2D);
-      GeometryHelpers::Generic::AverageVertexArrayValues<int64_t, DataType>(quads->getQuads(), inputDataPtr, outDataPtr);
+      GeometryHelpers::Generic::AverageVertexArrayValues<MeshIndexType, DataType>(quads->getQuads(), inputDataPtr, outDataPtr);
       break;
     }
     case IGeometry::Type::Image:
@@ -579,7 +576,7 @@ void InterpolateMeshToRegularGrid::dataCheck()
     return;
   }
 
-  DataContainer::Pointer interpolatedDC = getDataContainerArray()->createNonPrereqDataContainer<AbstractFilter>(this, getInterpolatedDataContainerName());
+  DataContainer::Pointer interpolatedDC = getDataContainerArray()->createNonPrereqDataContainer(this, getInterpolatedDataContainerName());
   if(getErrorCode() < 0)
   {
     return;
@@ -598,7 +595,11 @@ void InterpolateMeshToRegularGrid::dataCheck()
   // All vertex/edge/face/cell data in the original mesh will be interpolated to the regular grid's cells
   // Feature/ensemble attribute matrices will remain unchanged and are deep copied to the new data container below
   // Create the attribute matrix where all the interpolated data will be stored
-  interpolatedDC->createAndAddAttributeMatrix(tDims, getInterpolatedAttributeMatrixName(), AttributeMatrix::Type::Cell);
+  interpolatedDC->createNonPrereqAttributeMatrix(this, getInterpolatedAttributeMatrixName(), tDims, AttributeMatrix::Type::Cell);
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
 
   // Loop through all the attribute matrices in the original data container
   // If we are in a vertex/edge/face/cell attribute matrix, create data arrays for all in the new interpolated data attribute matrix
@@ -623,13 +624,13 @@ void InterpolateMeshToRegularGrid::dataCheck()
           for(QList<QString>::iterator jt = tempDataArrayList.begin(); jt != tempDataArrayList.end(); ++jt)
           {
             tempPath.update(getInterpolatedDataContainerName(), getInterpolatedAttributeMatrixName(), *jt);
-            IDataArray::Pointer tmpDataArray = tmpAttrMat->getPrereqIDataArray<IDataArray, AbstractFilter>(this, *jt, -90002);
+            IDataArray::Pointer tmpDataArray = tmpAttrMat->getPrereqIDataArray(this, *jt, -90002);
             if(getErrorCode() >= 0)
             {
               std::vector<size_t> cDims = tmpDataArray->getComponentDimensions();
               if(tempAttrMatType == AttributeMatrix::Type::Vertex)
               {
-                getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(this, tempPath, 0, cDims);
+                getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>>(this, tempPath, 0, cDims);
               }
               else
               {
@@ -664,9 +665,8 @@ void InterpolateMeshToRegularGrid::execute()
   createRegularGrid();
 
   // Set up internal variables
-  size_t iDims[3] = {0, 0, 0};
-  std::tie(iDims[0], iDims[1], iDims[2]) = image->getDimensions();
-  m_InsideMesh.resize(iDims[0] * iDims[1] * iDims[2], false);
+  SizeVec3Type iDims = image->getDimensions();
+  m_InsideMesh.resize(iDims[0] * iDims[1] * iDims[2], 0);
   m_InterpolatedIndex.resize(iDims[0] * iDims[1] * iDims[2], 0);
 
   // Determine interpolation
@@ -678,7 +678,7 @@ void InterpolateMeshToRegularGrid::execute()
   for(QMap<QString, QList<QString>>::iterator it = m_AttrArrayMap.begin(); it != m_AttrArrayMap.end(); ++it)
   {
     tempAttrMatType = m->getAttributeMatrix(it.key())->getType();
-    for(size_t i = 0; i < it.value().size(); i++)
+    for(int32_t i = 0; i < it.value().size(); i++)
     {
       IDataArray::Pointer tmpInPtr = m->getAttributeMatrix(it.key())->getAttributeArray(it.value()[i]);
       IDataArray::Pointer tmpOutPtr = interpolatedDC->getAttributeMatrix(getInterpolatedAttributeMatrixName())->getAttributeArray(it.value()[i]);
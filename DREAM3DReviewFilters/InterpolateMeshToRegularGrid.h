@@ -15,6 +15,9 @@
 #define _interpolatemeshtoregulargrid_h_
 
 #include <memory>
+#include <vector>
+
+#include <QtCore/QMap>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
@@ -239,7 +242,7 @@ protected:
   /**
    * @brief dataCheck Checks for the appropriate parameter values and availability of arrays
    */
-  void dataCheck();
+  void dataCheck() override;
 
   /**
    * @brief Initializes all the private instance variables.
@@ -260,7 +263,7 @@ private:
   QMap<QString, QList<QString>> m_AttrArrayMap;
   std::vector<float> m_MeshMinExtents;
   std::vector<float> m_MeshMaxExtents;
-  std::vector<bool> m_InsideMesh;
+  std::vector<uint8_t> m_InsideMesh;
   std::vector<size_t> m_InterpolatedIndex;
 
   InterpolateMeshToRegularGrid(const InterpolateMeshToRegularGrid&) = delete; // Copy Constructor Not Implemented
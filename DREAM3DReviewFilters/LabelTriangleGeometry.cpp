@@ -14,9 +14,14 @@
 
 #include "LabelTriangleGeometry.h"
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -25,9 +30,12 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Math/GeometryMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/ParallelHelpers.hpp"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/UnionFind.hpp"
 
 // -----------------------------------------------------------------------------
 //
@@ -143,107 +151,123 @@ void LabelTriangleGeometry::execute()
   }
   ElementDynamicList::Pointer m_TriangleNeighbors = triangle->getElementNeighbors();
 
-  size_t chunkSize = 1000;
-  std::vector<int64_t> triList(chunkSize, -1);
-
-  // first identify connected triangle sets as features
-  size_t size = 0;
-  int32_t regionCount = 1;
-  for(size_t i = 0; i < numTris; i++)
-  {
-    if(m_RegionId[i] == 0)
+  // first identify connected triangle sets as features; the union-find keeps the smallest triangle
+  // index as the root of each set, so regions are numbered in order of their first triangle
+  UnionFind<MeshIndexType> unionFind(numTris);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numTris);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      m_RegionId[i] = regionCount;
-      size = 0;
-      triList[size] = i;
-      size++;
-      while(size > 0)
+      uint16_t tCount = m_TriangleNeighbors->getNumberOfElements(i);
+      MeshIndexType* data = m_TriangleNeighbors->getElementListPointer(i);
+      for(uint16_t j = 0; j < tCount; j++)
       {
-        MeshIndexType tri = triList[size - 1];
-        size -= 1;
-        uint16_t tCount = m_TriangleNeighbors->getNumberOfElements(tri);
-        MeshIndexType* data = m_TriangleNeighbors->getElementListPointer(tri);
-        for(int j = 0; j < tCount; j++)
+        if(data[j] > i)
         {
-          MeshIndexType neighTri = data[j];
-          if(m_RegionId[neighTri] == 0)
-          {
-            m_RegionId[neighTri] = regionCount;
-            triList[size] = neighTri;
-            size++;
-            if(size >= triList.size())
-            {
-              size = triList.size();
-              triList.resize(size + chunkSize);
-              for(std::vector<int64_t>::size_type k = size; k < triList.size(); ++k)
-              {
-                triList[k] = -1;
-              }
-            }
-          }
+          unionFind.unite(i, data[j]);
         }
       }
-      regionCount++;
+    }
+  });
+
+  std::vector<int32_t> rootRegionIds(numTris, 0);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      rootRegionIds[i] = unionFind.isRoot(i) ? 1 : 0;
+    }
+  });
+  int32_t regionCount = ParallelHelpers::exclusiveScan(rootRegionIds) + 1;
+
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      m_RegionId[i] = rootRegionIds[unionFind.find(i)] + 1;
+    }
+  });
+  rootRegionIds.clear();
+  rootRegionIds.shrink_to_fit();
+
+  // next determine bounding boxes so we can see if any regions are within other regions; triangles
+  // are grouped by region with a counting sort so each box is reduced independently
+  std::vector<MeshIndexType> regionOffsets(regionCount + 1, 0);
+  for(size_t i = 0; i < numTris; i++)
+  {
+    regionOffsets[m_RegionId[i]]++;
+  }
+  ParallelHelpers::exclusiveScan(regionOffsets);
+  std::vector<MeshIndexType> regionTris(numTris);
+  {
+    std::vector<MeshIndexType> cursors(regionOffsets.begin(), regionOffsets.end() - 1);
+    for(size_t i = 0; i < numTris; i++)
+    {
+      regionTris[cursors[m_RegionId[i]]++] = i;
     }
   }
 
-  // next determine bounding boxes so we can see if any regions are within other regions
   std::vector<float> xMinList(regionCount, std::numeric_limits<float>::max());
   std::vector<float> yMinList(regionCount, std::numeric_limits<float>::max());
   std::vector<float> zMinList(regionCount, std::numeric_limits<float>::max());
   std::vector<float> xMaxList(regionCount, -std::numeric_limits<float>::max());
   std::vector<float> yMaxList(regionCount, -std::numeric_limits<float>::max());
   std::vector<float> zMaxList(regionCount, -std::numeric_limits<float>::max());
-  for(MeshIndexType i = 0; i < numTris; i++)
-  {
-    int32_t regionId = m_RegionId[i];
-    for(int j = 0; j < 3; j++)
+  dataAlg.setRange(1, regionCount);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t regionId = range.min(); regionId < range.max(); regionId++)
     {
-      MeshIndexType vert = tris[3 * i + j];
-      if(xMinList[regionId] > triVerts[3 * vert + 0])
-      {
-        xMinList[regionId] = triVerts[3 * vert + 0];
-      }
-      if(yMinList[regionId] > triVerts[3 * vert + 1])
-      {
-        yMinList[regionId] = triVerts[3 * vert + 1];
-      }
-      if(zMinList[regionId] > triVerts[3 * vert + 2])
-      {
-        zMinList[regionId] = triVerts[3 * vert + 2];
-      }
-      if(xMaxList[regionId] < triVerts[3 * vert + 0])
+      for(MeshIndexType k = regionOffsets[regionId]; k < regionOffsets[regionId + 1]; k++)
       {
-        xMaxList[regionId] = triVerts[3 * vert + 0];
-      }
-      if(yMaxList[regionId] < triVerts[3 * vert + 1])
-      {
-        yMaxList[regionId] = triVerts[3 * vert + 1];
-      }
-      if(zMaxList[regionId] < triVerts[3 * vert + 2])
-      {
-        zMaxList[regionId] = triVerts[3 * vert + 2];
+        MeshIndexType i = regionTris[k];
+        for(int j = 0; j < 3; j++)
+        {
+          MeshIndexType vert = tris[3 * i + j];
+          xMinList[regionId] = std::min(xMinList[regionId], triVerts[3 * vert + 0]);
+          yMinList[regionId] = std::min(yMinList[regionId], triVerts[3 * vert + 1]);
+          zMinList[regionId] = std::min(zMinList[regionId], triVerts[3 * vert + 2]);
+          xMaxList[regionId] = std::max(xMaxList[regionId], triVerts[3 * vert + 0]);
+          yMaxList[regionId] = std::max(yMaxList[regionId], triVerts[3 * vert + 1]);
+          zMaxList[regionId] = std::max(zMaxList[regionId], triVerts[3 * vert + 2]);
+        }
       }
     }
-  }
-
-  std::vector<int32_t> newRegionIds(regionCount);
-  std::vector<int32_t> contiguousRegionIds(regionCount);
-  for(size_t i = 1; i < regionCount; i++)
-  {
-    newRegionIds[i] = i;
-    for(size_t j = 1; j < regionCount; j++)
+  });
+  regionTris.clear();
+  regionTris.shrink_to_fit();
+
+  // A region strictly inside the box of another region is merged into the highest numbered such
+  // region. Only regions whose xMin is smaller can contain region i, so candidates are limited to a
+  // prefix of the regions sorted by xMin
+  std::vector<int32_t> xMinOrder(regionCount - 1);
+  std::iota(xMinOrder.begin(), xMinOrder.end(), 1);
+  ParallelHelpers::sort(xMinOrder.begin(), xMinOrder.end(), [&xMinList](int32_t a, int32_t b) { return xMinList[a] < xMinList[b]; });
+
+  std::vector<int32_t> newRegionIds(regionCount, 0);
+  dataAlg.setRange(1, regionCount);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      if(xMinList[i] > xMinList[j] && xMinList[i] < xMaxList[j] && xMaxList[i] > xMinList[j] && xMaxList[i] < xMaxList[j] && yMinList[i] > yMinList[j] && yMinList[i] < yMaxList[j] &&
-         yMaxList[i] > yMinList[j] && yMaxList[i] < yMaxList[j] && zMinList[i] > zMinList[j] && zMinList[i] < zMaxList[j] && zMaxList[i] > zMinList[j] && zMaxList[i] < zMaxList[j])
+      int32_t container = 0;
+      auto candidatesEnd = std::lower_bound(xMinOrder.begin(), xMinOrder.end(), xMinList[i], [&xMinList](int32_t a, float value) { return xMinList[a] < value; });
+      for(auto iter = xMinOrder.begin(); iter != candidatesEnd; ++iter)
       {
-        newRegionIds[i] = j;
+        int32_t j = *iter;
+        if(j > container && xMinList[i] > xMinList[j] && xMinList[i] < xMaxList[j] && xMaxList[i] > xMinList[j] && xMaxList[i] < xMaxList[j] && yMinList[i] > yMinList[j] &&
+           yMinList[i] < yMaxList[j] && yMaxList[i] > yMinList[j] && yMaxList[i] < yMaxList[j] && zMinList[i] > zMinList[j] && zMinList[i] < zMaxList[j] && zMaxList[i] > zMinList[j] &&
+           zMaxList[i] < zMaxList[j])
+        {
+          container = j;
+        }
       }
+      newRegionIds[i] = (container > 0) ? container : static_cast<int32_t>(i);
     }
-  }
+  });
 
+  // Renumber the surviving regions contiguously, then resolve nested regions to their outermost
+  // region with path compression so every region is visited a bounded number of times
+  std::vector<int32_t> contiguousRegionIds(regionCount, 0);
   int32_t newRegionCount = 1;
-  for(size_t i = 1; i < regionCount; i++)
+  for(int32_t i = 1; i < regionCount; i++)
   {
     if(newRegionIds[i] == i)
     {
@@ -251,27 +275,31 @@ void LabelTriangleGeometry::execute()
       newRegionCount++;
     }
   }
-
-  int32_t newRegionId = 0;
-  for(size_t i = 0; i < numTris; i++)
+  for(int32_t i = 1; i < regionCount; i++)
   {
-    int32_t regionId = m_RegionId[i];
-    bool keepGoing = true;
-    while(keepGoing)
+    int32_t root = i;
+    while(newRegionIds[root] != root)
     {
-      if(newRegionIds[regionId] != regionId)
-      {
-        regionId = newRegionIds[regionId];
-      }
-      else
-      {
-        newRegionId = regionId;
-        keepGoing = false;
-      }
+      root = newRegionIds[root];
     }
-    m_RegionId[i] = contiguousRegionIds[newRegionId];
+    int32_t regionId = i;
+    while(newRegionIds[regionId] != root && regionId != root)
+    {
+      int32_t next = newRegionIds[regionId];
+      newRegionIds[regionId] = root;
+      regionId = next;
+    }
+    contiguousRegionIds[i] = contiguousRegionIds[root];
   }
 
+  dataAlg.setRange(0, numTris);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      m_RegionId[i] = contiguousRegionIds[m_RegionId[i]];
+    }
+  });
+
   notifyStatusMessage("Complete");
 }
 
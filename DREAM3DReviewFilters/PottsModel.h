@@ -60,6 +60,7 @@ class DREAM3DReview_EXPORT PottsModel : public AbstractFilter
   PYB11_PROPERTY(int Iterations READ getIterations WRITE setIterations)
   PYB11_PROPERTY(double Temperature READ getTemperature WRITE setTemperature)
   PYB11_PROPERTY(bool PeriodicBoundaries READ getPeriodicBoundaries WRITE setPeriodicBoundaries)
+  PYB11_PROPERTY(bool KineticMode READ getKineticMode WRITE setKineticMode)
   PYB11_PROPERTY(bool UseMask READ getUseMask WRITE setUseMask)
   PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
   PYB11_PROPERTY(DataArrayPath MaskArrayPath READ getMaskArrayPath WRITE setMaskArrayPath)
@@ -122,6 +123,17 @@ public:
   bool getPeriodicBoundaries() const;
   Q_PROPERTY(bool PeriodicBoundaries READ getPeriodicBoundaries WRITE setPeriodicBoundaries)
 
+  /**
+   * @brief Setter property for KineticMode
+   */
+  void setKineticMode(bool value);
+  /**
+   * @brief Getter property for KineticMode
+   * @return Value of KineticMode
+   */
+  bool getKineticMode() const;
+  Q_PROPERTY(bool KineticMode READ getKineticMode WRITE setKineticMode)
+
   /**
    * @brief Setter property for UseMask
    */
@@ -232,6 +244,7 @@ private:
   int m_Iterations = {100};
   double m_Temperature = {273.0};
   bool m_PeriodicBoundaries = {false};
+  bool m_KineticMode = {false};
   bool m_UseMask = {false};
   DataArrayPath m_FeatureIdsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds};
   DataArrayPath m_MaskArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask};
@@ -34,16 +34,25 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "RobustAutomaticThreshold.h"
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/Common/TemplateHelpers.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedChoicesFilterParameter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/ITK/Dream3DTemplateAliasMacro.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
@@ -55,6 +64,14 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+namespace
+{
+// Choices of the gradient magnitude source
+constexpr int32_t k_GradientArray = 0;
+constexpr int32_t k_CentralDifferences = 1;
+constexpr int32_t k_Sobel = 2;
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -74,10 +91,27 @@ RobustAutomaticThreshold::~RobustAutomaticThreshold() = default;
 void RobustAutomaticThreshold::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
+  {
+    LinkedChoicesFilterParameter::Pointer parameter = LinkedChoicesFilterParameter::New();
+    parameter->setHumanLabel("Gradient Magnitude Source");
+    parameter->setPropertyName("GradientMethod");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(RobustAutomaticThreshold, this, GradientMethod));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(RobustAutomaticThreshold, this, GradientMethod));
+    QVector<QString> choices;
+    choices.push_back("Gradient Magnitude Array");
+    choices.push_back("Compute with Central Differences");
+    choices.push_back("Compute with Sobel Operator");
+    parameter->setChoices(choices);
+    QStringList linkedProps = {"GradientMagnitudeArrayPath"};
+    parameter->setLinkedProperties(linkedProps);
+    parameter->setEditable(false);
+    parameter->setCategory(FilterParameter::Category::Parameter);
+    parameters.push_back(parameter);
+  }
   DataArraySelectionFilterParameter::RequirementType dasReq = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::Defaults::AnyPrimitive, 1, AttributeMatrix::Type::Any, IGeometry::Type::Any);
   parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Attribute Array to Threshold", InputArrayPath, FilterParameter::Category::RequiredArray, RobustAutomaticThreshold, dasReq));
   dasReq = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 1, AttributeMatrix::Type::Any, IGeometry::Type::Any);
-  parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Gradient Magnitude", GradientMagnitudeArrayPath, FilterParameter::Category::RequiredArray, RobustAutomaticThreshold, dasReq));
+  parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Gradient Magnitude", GradientMagnitudeArrayPath, FilterParameter::Category::RequiredArray, RobustAutomaticThreshold, dasReq, 0));
   DataArrayCreationFilterParameter::RequirementType dacReq = DataArrayCreationFilterParameter::CreateRequirement(AttributeMatrix::Type::Any, IGeometry::Type::Any);
   parameters.push_back(SIMPL_NEW_DA_CREATION_FP("Mask", FeatureIdsArrayPath, FilterParameter::Category::RequiredArray, RobustAutomaticThreshold, dacReq));
   setFilterParameters(parameters);
@@ -92,6 +126,7 @@ void RobustAutomaticThreshold::readFilterParameters(AbstractFilterParametersRead
   setInputArrayPath(reader->readDataArrayPath("InputArrayPath", getInputArrayPath()));
   setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath()));
   setGradientMagnitudeArrayPath(reader->readDataArrayPath("GradientMagnitudeArrayPath", getGradientMagnitudeArrayPath()));
+  setGradientMethod(reader->readValue("GradientMethod", getGradientMethod()));
   reader->closeFilterGroup();
 }
 
@@ -133,14 +168,41 @@ void RobustAutomaticThreshold::dataCheck()
     dataArrayPaths.push_back(getInputArrayPath());
   }
 
-  m_GradientMagnitudePtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>>(this, getGradientMagnitudeArrayPath(), cDims);
-  if(m_GradientMagnitudePtr.lock())
+  if(getGradientMethod() == k_GradientArray)
   {
-    m_GradientMagnitude = m_GradientMagnitudePtr.lock()->getPointer(0);
+    m_GradientMagnitudePtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>>(this, getGradientMagnitudeArrayPath(), cDims);
+    if(m_GradientMagnitudePtr.lock())
+    {
+      m_GradientMagnitude = m_GradientMagnitudePtr.lock()->getPointer(0);
+    }
+    if(getErrorCode() >= 0)
+    {
+      dataArrayPaths.push_back(getGradientMagnitudeArrayPath());
+    }
   }
-  if(getErrorCode() >= 0)
+  else if(getGradientMethod() == k_CentralDifferences || getGradientMethod() == k_Sobel)
   {
-    dataArrayPaths.push_back(getGradientMagnitudeArrayPath());
+    m_GradientMagnitudePtr.reset();
+    m_GradientMagnitude = nullptr;
+    ImageGeom::Pointer image = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getInputArrayPath().getDataContainerName());
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+    if(image->getNumberOfElements() != m_InputArrayPtr.lock()->getNumberOfTuples())
+    {
+      QString ss = QObject::tr("Computing the gradient magnitude requires the Attribute Array to threshold to hold one value per Cell of the Image Geometry (%1), but it has %2 tuples")
+                       .arg(image->getNumberOfElements())
+                       .arg(m_InputArrayPtr.lock()->getNumberOfTuples());
+      setErrorCondition(-11003, ss);
+      return;
+    }
+  }
+  else
+  {
+    QString ss = QObject::tr("Invalid selection for the gradient magnitude source");
+    setErrorCondition(-11002, ss);
+    return;
   }
 
   m_FeatureIdsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<bool>>(this, getFeatureIdsArrayPath(), false, cDims, "", DataArrayID31);
@@ -159,37 +221,189 @@ void RobustAutomaticThreshold::dataCheck()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
+namespace
+{
+// Number of tuples summed by each block of the reduction
+constexpr size_t k_BlockSize = 1 << 16;
+
+/**
+ * @brief weightedSums Sums value * weight and weight over [0, numItems) in parallel. Every block of blockSize items is
+ * accumulated in double and the block sums are added in order, so the result does not depend on the thread count.
+ * accumulate(begin, end, numerator, denominator) adds the items in [begin, end) to the two sums.
+ */
+template <typename Accumulate>
+std::pair<double, double> weightedSums(size_t numItems, size_t blockSize, Accumulate accumulate)
+{
+  size_t numBlocks = (numItems + blockSize - 1) / blockSize;
+  std::vector<double> numerators(numBlocks, 0.0);
+  std::vector<double> denominators(numBlocks, 0.0);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numBlocks);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t block = range.min(); block < range.max(); block++)
+    {
+      accumulate(block * blockSize, std::min((block + 1) * blockSize, numItems), numerators[block], denominators[block]);
+    }
+  });
+
+  std::pair<double, double> sums = {0.0, 0.0};
+  for(size_t block = 0; block < numBlocks; block++)
+  {
+    sums.first += numerators[block];
+    sums.second += denominators[block];
+  }
+  return sums;
+}
+
+/**
+ * @brief The ImageGradient class evaluates the gradient magnitude of a scalar image at single voxels, with central
+ * differences or the 3x3x3 Sobel operator, so the gradient never has to be stored. Neighbors beyond the border are
+ * replaced by the border voxel, which makes the differences one sided there; an axis of extent 1 has no gradient.
+ */
 template <typename T>
-void findThreshold(IDataArray::Pointer inputPtr, const FloatArrayType::Pointer& gradMagPtr, const BoolArrayType::Pointer& maskPtr)
+class ImageGradient
+{
+public:
+  ImageGradient(const T* data, const SizeVec3Type& dims, const FloatVec3Type& spacing)
+  : m_Data(data)
+  , m_Dims(dims)
+  , m_Spacing(spacing)
+  {
+  }
+
+  double centralDifference(size_t x, size_t y, size_t z) const
+  {
+    size_t lower[3] = {x, y, z};
+    size_t upper[3] = {x, y, z};
+    double gradient[3] = {0.0, 0.0, 0.0};
+    for(size_t axis = 0; axis < 3; axis++)
+    {
+      size_t position[3] = {x, y, z};
+      neighbors(axis, position[axis], lower[axis], upper[axis]);
+      if(lower[axis] == upper[axis])
+      {
+        continue;
+      }
+      size_t low[3] = {x, y, z};
+      size_t high[3] = {x, y, z};
+      low[axis] = lower[axis];
+      high[axis] = upper[axis];
+      gradient[axis] = (value(high[0], high[1], high[2]) - value(low[0], low[1], low[2])) / (static_cast<double>(upper[axis] - lower[axis]) * m_Spacing[axis]);
+    }
+    return std::sqrt(gradient[0] * gradient[0] + gradient[1] * gradient[1] + gradient[2] * gradient[2]);
+  }
+
+  double sobel(size_t x, size_t y, size_t z) const
+  {
+    // Clamped neighbor coordinates at offsets -1, 0 and +1 along every axis
+    size_t coords[3][3];
+    size_t position[3] = {x, y, z};
+    for(size_t axis = 0; axis < 3; axis++)
+    {
+      coords[axis][1] = position[axis];
+      neighbors(axis, position[axis], coords[axis][0], coords[axis][2]);
+    }
+    const double weights[3] = {1.0, 2.0, 1.0};
+    double differences[3] = {0.0, 0.0, 0.0};
+    for(size_t k = 0; k < 3; k++)
+    {
+      for(size_t j = 0; j < 3; j++)
+      {
+        double wx = weights[j] * weights[k];
+        differences[0] += wx * (value(coords[0][2], coords[1][j], coords[2][k]) - value(coords[0][0], coords[1][j], coords[2][k]));
+        differences[1] += wx * (value(coords[0][j], coords[1][2], coords[2][k]) - value(coords[0][j], coords[1][0], coords[2][k]));
+        differences[2] += wx * (value(coords[0][j], coords[1][k], coords[2][2]) - value(coords[0][j], coords[1][k], coords[2][0]));
+      }
+    }
+    double gradient = 0.0;
+    for(size_t axis = 0; axis < 3; axis++)
+    {
+      size_t span = coords[axis][2] - coords[axis][0];
+      if(span > 0)
+      {
+        // The smoothing weights sum to 16
+        double derivative = differences[axis] / (16.0 * static_cast<double>(span) * m_Spacing[axis]);
+        gradient += derivative * derivative;
+      }
+    }
+    return std::sqrt(gradient);
+  }
+
+private:
+  const T* m_Data = nullptr;
+  SizeVec3Type m_Dims;
+  FloatVec3Type m_Spacing;
+
+  double value(size_t x, size_t y, size_t z) const
+  {
+    return static_cast<double>(m_Data[(z * m_Dims[1] + y) * m_Dims[0] + x]);
+  }
+
+  void neighbors(size_t axis, size_t position, size_t& lower, size_t& upper) const
+  {
+    lower = position > 0 ? position - 1 : position;
+    upper = position + 1 < m_Dims[axis] ? position + 1 : position;
+  }
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+void findThreshold(IDataArray::Pointer inputPtr, const FloatArrayType::Pointer& gradMagPtr, const BoolArrayType::Pointer& maskPtr, int32_t gradientMethod, const ImageGeom::Pointer& image)
 {
   typename DataArray<T>::Pointer input = std::dynamic_pointer_cast<DataArray<T>>(inputPtr);
   T* iPtr = input->getPointer(0);
-  float* gradMag = gradMagPtr->getPointer(0);
   bool* mask = maskPtr->getPointer(0);
 
   size_t numTuples = input->getNumberOfTuples();
-  float numerator = 0;
-  float denominator = 0;
+  std::pair<double, double> sums = {0.0, 0.0};
 
-  for(size_t i = 0; i < numTuples; i++)
+  if(gradientMethod == k_GradientArray)
+  {
+    float* gradMag = gradMagPtr->getPointer(0);
+    sums = weightedSums(numTuples, k_BlockSize, [&](size_t begin, size_t end, double& numerator, double& denominator) {
+      for(size_t i = begin; i < end; i++)
+      {
+        numerator += static_cast<double>(iPtr[i]) * gradMag[i];
+        denominator += gradMag[i];
+      }
+    });
+  }
+  else
   {
-    numerator += (iPtr[i] * gradMag[i]);
-    denominator += gradMag[i];
+    // Blocks of whole rows, so every block walks the image in memory order
+    SizeVec3Type dims = image->getDimensions();
+    ImageGradient<T> gradient(iPtr, dims, image->getSpacing());
+    const bool sobel = gradientMethod == k_Sobel;
+    size_t rowsPerBlock = std::max(static_cast<size_t>(1), k_BlockSize / dims[0]);
+    sums = weightedSums(dims[1] * dims[2], rowsPerBlock, [&](size_t begin, size_t end, double& numerator, double& denominator) {
+      for(size_t row = begin; row < end; row++)
+      {
+        size_t y = row % dims[1];
+        size_t z = row / dims[1];
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          double gradMag = sobel ? gradient.sobel(x, y, z) : gradient.centralDifference(x, y, z);
+          numerator += static_cast<double>(iPtr[row * dims[0] + x]) * gradMag;
+          denominator += gradMag;
+        }
+      }
+    });
   }
 
-  float threshold = numerator / denominator;
+  float threshold = static_cast<float>(sums.first / sums.second);
 
-  for(size_t i = 0; i < numTuples; i++)
-  {
-    if(iPtr[i] < threshold)
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numTuples);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t i = range.min(); i < range.max(); i++)
     {
-      mask[i] = false;
+      mask[i] = !(iPtr[i] < threshold);
     }
-    else
-    {
-      mask[i] = true;
-    }
-  }
+  });
 }
 
 // -----------------------------------------------------------------------------
@@ -206,7 +420,15 @@ void RobustAutomaticThreshold::execute()
 
   // float threshold = 0.0f;
 
-  EXECUTE_FUNCTION_TEMPLATE_NO_BOOL(DataArray, this, findThreshold, m_InputArrayPtr.lock(), m_InputArrayPtr.lock(), m_GradientMagnitudePtr.lock(), m_FeatureIdsPtr.lock());
+  ImageGeom::Pointer image;
+  if(m_GradientMethod != k_GradientArray)
+  {
+    DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getInputArrayPath().getDataContainerName());
+    image = m->getGeometryAs<ImageGeom>();
+  }
+
+  EXECUTE_FUNCTION_TEMPLATE_NO_BOOL(DataArray, this, findThreshold, m_InputArrayPtr.lock(), m_InputArrayPtr.lock(), m_GradientMagnitudePtr.lock(), m_FeatureIdsPtr.lock(), m_GradientMethod,
+                                    image);
 }
 
 // -----------------------------------------------------------------------------
@@ -345,3 +567,15 @@ DataArrayPath RobustAutomaticThreshold::getGradientMagnitudeArrayPath() const
 {
   return m_GradientMagnitudeArrayPath;
 }
+
+// -----------------------------------------------------------------------------
+void RobustAutomaticThreshold::setGradientMethod(int32_t value)
+{
+  m_GradientMethod = value;
+}
+
+// -----------------------------------------------------------------------------
+int32_t RobustAutomaticThreshold::getGradientMethod() const
+{
+  return m_GradientMethod;
+}
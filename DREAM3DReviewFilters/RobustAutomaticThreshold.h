@@ -61,6 +61,7 @@ class DREAM3DReview_EXPORT RobustAutomaticThreshold : public AbstractFilter
   PYB11_PROPERTY(DataArrayPath InputArrayPath READ getInputArrayPath WRITE setInputArrayPath)
   PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
   PYB11_PROPERTY(DataArrayPath GradientMagnitudeArrayPath READ getGradientMagnitudeArrayPath WRITE setGradientMagnitudeArrayPath)
+  PYB11_PROPERTY(int GradientMethod READ getGradientMethod WRITE setGradientMethod)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -118,6 +119,17 @@ public:
   DataArrayPath getGradientMagnitudeArrayPath() const;
   Q_PROPERTY(DataArrayPath GradientMagnitudeArrayPath READ getGradientMagnitudeArrayPath WRITE setGradientMagnitudeArrayPath)
 
+  /**
+   * @brief Setter property for GradientMethod
+   */
+  void setGradientMethod(int32_t value);
+  /**
+   * @brief Getter property for GradientMethod
+   * @return Value of GradientMethod
+   */
+  int32_t getGradientMethod() const;
+  Q_PROPERTY(int GradientMethod READ getGradientMethod WRITE setGradientMethod)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -203,6 +215,7 @@ private:
   DataArrayPath m_InputArrayPath = {"", "", ""};
   DataArrayPath m_FeatureIdsArrayPath = {"", "", "Mask"};
   DataArrayPath m_GradientMagnitudeArrayPath = {"", "", ""};
+  int32_t m_GradientMethod = {0};
 
 public:
   RobustAutomaticThreshold(const RobustAutomaticThreshold&) = delete;            // Copy Constructor Not Implemented
@@ -34,8 +34,13 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "SteinerCompact.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <fstream>
+#include <numeric>
 
+#include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
@@ -43,6 +48,7 @@
 
 #include "SIMPLib/SIMPLibVersion.h"
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/Common/ScopedFileMonitor.hpp"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
@@ -55,11 +61,18 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
-#include "SIMPLib/Math/SIMPLibRandom.h"
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/CounterRng.hpp"
+
+namespace
+{
+// Random lines evaluated per direction and parallel round
+constexpr uint64_t k_LinesPerRound = 64;
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -119,6 +132,10 @@ void SteinerCompact::setupFilterParameters()
   linkedProps << "TxtFileName";
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Text Output As .txt", TxtOutput, FilterParameter::Category::Parameter, SteinerCompact, linkedProps));
   parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("Output Text File", TxtFileName, FilterParameter::Category::Parameter, SteinerCompact, "*.txt", "Text"));
+  linkedProps.clear();
+  linkedProps << "SeedValue";
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Seed for Random Generation", UseSeed, FilterParameter::Category::Parameter, SteinerCompact, linkedProps));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Seed Value", SeedValue, FilterParameter::Category::Parameter, SteinerCompact));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -142,6 +159,8 @@ void SteinerCompact::readFilterParameters(AbstractFilterParametersReader* reader
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setPlane(reader->readValue("Plane", getPlane()));
   setSites(reader->readValue("Sites", getSites()));
+  setUseSeed(reader->readValue("UseSeed", getUseSeed()));
+  setSeedValue(reader->readValue("SeedValue", getSeedValue()));
   setVtkOutput(reader->readValue("VtkOutput", getVtkOutput()));
   setVtkFileName(reader->readString("VtkFileName", getVtkFileName()));
   setTxtOutput(reader->readValue("TxtOutput", getTxtOutput()));
@@ -205,19 +224,17 @@ void SteinerCompact::dataCheck()
 // rose of intersections (counts numbers of intersections of randomly placed lines at fixed directions with grain boundaries)
 void SteinerCompact::rose_of_intersections(std::vector<std::vector<float>>& ROI)
 {
-  float line[3];
   float rectangle[4];
-  float xintersections[2];
-  float yintersections[2];
-  float xdif, ydif;
   int64_t progressInt = 0;
 
-  static float rndm;
   static float zero = 0.000001f;
 
   uint64_t directions = ROI[1].size();
+  size_t numPhases = ROI.size();
 
-  SIMPL_RANDOMNG_NEW();
+  // every line draws its random numbers from its own stream keyed by (seed, direction, line), so the result only
+  // depends on the seed and not on how the lines are distributed over the threads
+  uint64_t seed = m_UseSeed ? static_cast<uint64_t>(m_SeedValue) : static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch());
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
@@ -267,64 +284,109 @@ void SteinerCompact::rose_of_intersections(std::vector<std::vector<float>>& ROI)
   rectangle[2] = dims[0] * res[0];
   rectangle[3] = dims[1] * res[1];
 
-  std::vector<float> numofintersections(ROI.size(), 0);
-  std::vector<float> meanROI(ROI.size(), 0);
-
-  float length = 0;
-  int64_t z = 0;
-  float alpha = 0;
-
-  for(int32_t i = 0; i < directions; i++)
+  // the line is represented as line[0]*x+line[1]*y+line[2]=0, line[2] is set for each random line
+  std::vector<std::array<float, 2>> normals(directions);
+  for(uint64_t i = 0; i < directions; i++)
   {
-    progressInt = (static_cast<float>(i) / static_cast<float>(directions)) * 100.0f;
-    QString ss = QObject::tr("Evaluate random intersections || %1% Complete").arg(progressInt);
-    notifyStatusMessage(ss);
-
-    alpha = (static_cast<float>(i) + 0.5f) * SIMPLib::Constants::k_PiD / static_cast<float>(directions);
-    // alpha = (static_cast<float>(i)) * SIMPLib::Constants::k_Pi / directions;
-
-    // the line is represented as line[0]*x+line[1]*y+line[2]=0;
+    float alpha = (static_cast<float>(i) + 0.5f) * SIMPLib::Constants::k_PiD / static_cast<float>(directions);
     if(fabs(alpha - SIMPLib::Constants::k_PiD / 2) < zero)
     {
-      line[0] = 1.0f;
-      line[1] = 0.0f;
+      normals[i] = {1.0f, 0.0f};
     }
     else
     {
-      line[0] = -tan(alpha);
-      line[1] = 1.0f;
+      normals[i] = {-tanf(alpha), 1.0f};
     }
 
-    for(int32_t phase = 1; phase < ROI.size(); phase++)
+    for(size_t phase = 1; phase < numPhases; phase++)
     {
       ROI[phase][i] = 0;
     }
+  }
+
+  // Lines are sampled in rounds of k_LinesPerRound lines for every direction that has not reached the total length
+  // yet. The rounds are evaluated in parallel and then accumulated in line order, stopping at the same line the
+  // serial sampling would stop at, so the surplus lines of the last round are simply dropped.
+  std::vector<float> length(directions, 0.0f);
+  std::vector<uint64_t> linesDrawn(directions, 0);
+  std::vector<uint64_t> active(directions);
+  std::iota(active.begin(), active.end(), 0);
 
-    length = 0.0f;
+  std::vector<float> lineLengths;
+  std::vector<float> lineIntersections;
 
-    while(length < totlength)
+  while(!active.empty())
+  {
+    if(getCancel())
     {
-      float random_point_x = static_cast<float>(rg.genrand_res53()) * static_cast<float>(dims[0]) * res[0];
-      float random_point_y = static_cast<float>(rg.genrand_res53()) * static_cast<float>(dims[1]) * res[1];
-      line[2] = -random_point_x * line[0] - random_point_y * line[1];
+      return;
+    }
 
-      if(line_rectangle_intersections(xintersections, yintersections, rectangle, line) == 2)
+    progressInt = (static_cast<float>(directions - active.size()) / static_cast<float>(directions)) * 100.0f;
+    QString ss = QObject::tr("Evaluate random intersections || %1% Complete").arg(progressInt);
+    notifyStatusMessage(ss);
+
+    lineLengths.assign(active.size() * k_LinesPerRound, 0.0f);
+    lineIntersections.assign(lineLengths.size() * numPhases, 0.0f);
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, lineLengths.size());
+    dataAlg.execute([&](const SIMPLRange& range) {
+      LineScratch scratch;
+      float line[3];
+      float xintersections[2];
+      float yintersections[2];
+      for(size_t t = range.min(); t < range.max(); t++)
+      {
+        uint64_t direction = active[t / k_LinesPerRound];
+        uint64_t lineIndex = linesDrawn[direction] + t % k_LinesPerRound;
+        CounterRng rng(CounterRng::mix(seed + CounterRng::mix(direction)) ^ CounterRng::mix(lineIndex));
+
+        line[0] = normals[direction][0];
+        line[1] = normals[direction][1];
+        float random_point_x = static_cast<float>(rng.uniformReal()) * static_cast<float>(dims[0]) * res[0];
+        float random_point_y = static_cast<float>(rng.uniformReal()) * static_cast<float>(dims[1]) * res[1];
+        line[2] = -random_point_x * line[0] - random_point_y * line[1];
+
+        if(line_rectangle_intersections(xintersections, yintersections, rectangle, line) == 2)
+        {
+          float xdif = xintersections[1] - xintersections[0];
+          float ydif = yintersections[1] - yintersections[0];
+          int64_t z = std::min(static_cast<int64_t>(rng.uniformReal() * static_cast<double>(dims[2])), dims[2] - 1);
+          find_intersections(line, z, dims, res.data(), scratch, lineIntersections.data() + t * numPhases);
+          lineLengths[t] = sqrtf(xdif * xdif + ydif * ydif);
+        }
+      }
+    });
+
+    std::vector<uint64_t> unfinished;
+    for(size_t a = 0; a < active.size(); a++)
+    {
+      uint64_t i = active[a];
+      for(uint64_t l = 0; l < k_LinesPerRound && length[i] < totlength; l++)
       {
-        xdif = xintersections[1] - xintersections[0];
-        ydif = yintersections[1] - yintersections[0];
-        rndm = static_cast<float>(rg.genrand_res53());
-        z = static_cast<int64_t>(trunc(rndm * dims[2] * res[2]));
-        for(int32_t phase = 1; phase < ROI.size(); phase++)
+        size_t t = a * k_LinesPerRound + l;
+        for(size_t phase = 1; phase < numPhases; phase++)
         {
-          find_intersections(line, z, dims, res.data(), numofintersections);
-          ROI[phase][i] += numofintersections[phase];
+          ROI[phase][i] += lineIntersections[t * numPhases + phase];
         }
-        length += sqrt(xdif * xdif + ydif * ydif);
+        length[i] += lineLengths[t];
+      }
+      linesDrawn[i] += k_LinesPerRound;
+      if(length[i] < totlength)
+      {
+        unfinished.push_back(i);
       }
     }
-    for(int32_t phase = 1; phase < ROI.size(); phase++)
+    active.swap(unfinished);
+  }
+
+  std::vector<float> meanROI(numPhases, 0);
+  for(uint64_t i = 0; i < directions; i++)
+  {
+    for(size_t phase = 1; phase < numPhases; phase++)
     {
-      ROI[phase][i] /= length;
+      ROI[phase][i] /= length[i];
       meanROI[phase] += ROI[phase][i] / static_cast<float>(directions);
     }
   }
@@ -345,18 +407,24 @@ void SteinerCompact::rose_of_intersections(std::vector<std::vector<float>>& ROI)
 //
 // -----------------------------------------------------------------------------
 // count the number of intersections of given line with grain boundaries
-void SteinerCompact::find_intersections(float line[3], int64_t z, int64_t dims[3], float res[3], std::vector<float>& numofintersections)
+void SteinerCompact::find_intersections(float line[3], int64_t z, int64_t dims[3], float res[3], LineScratch& scratch, float* numofintersections)
 {
-  std::vector<int64_t> xvoxels;
-  std::vector<int64_t> yvoxels;
+  std::vector<int64_t>& xvoxels = scratch.xvoxels;
+  std::vector<int64_t>& yvoxels = scratch.yvoxels;
+
+  std::vector<float>& xcoor0 = scratch.xcoor0;
+  std::vector<float>& xcoor1 = scratch.xcoor1;
+  std::vector<float>& ycoor0 = scratch.ycoor0;
+  std::vector<float>& ycoor1 = scratch.ycoor1;
 
-  std::vector<float> xcoor0;
-  std::vector<float> xcoor1;
-  std::vector<float> ycoor0;
-  std::vector<float> ycoor1;
+  xvoxels.clear();
+  yvoxels.clear();
+  xcoor0.clear();
+  xcoor1.clear();
+  ycoor0.clear();
+  ycoor1.clear();
 
   size_t numfeatures = m_FeatureIdsPtr.lock()->getNumberOfTuples();
-  std::vector<uint64_t> bound;
   float rectangle[4];
   float xintersections[2];
   float yintersections[2];
@@ -458,7 +526,8 @@ void SteinerCompact::find_intersections(float line[3], int64_t z, int64_t dims[3
   //    this should diminish the influence of voxelation on the shape of Steiner compact
   //    (intersections occur more frequently for specific directions in voxelated data)
 
-  std::vector<uint64_t> interfaces;
+  std::vector<uint64_t>& interfaces = scratch.interfaces;
+  interfaces.clear();
   bool penalization;
   float squaredlength;
   uint64_t g0 = 0, g1 = 0, g2 = 0;
@@ -467,8 +536,6 @@ void SteinerCompact::find_intersections(float line[3], int64_t z, int64_t dims[3
 
   float smooth = 0.25f;
 
-  numofintersections.assign(numofintersections.size(), 0);
-
   for(int64_t i = 0; i < static_cast<int64_t>(xvoxels.size()) - 1; i++)
   {
     if(m_Plane == 0)
@@ -1073,6 +1140,10 @@ void SteinerCompact::execute()
 
   // find number of intersections per unit length of test lines in all directions
   rose_of_intersections(ROI);
+  if(getCancel())
+  {
+    return;
+  }
 
   // write the Steiner compact to vtk or txt file
   if(m_VtkOutput || m_TxtOutput)
@@ -1314,3 +1385,27 @@ int SteinerCompact::getSites() const
 {
   return m_Sites;
 }
+
+// -----------------------------------------------------------------------------
+void SteinerCompact::setUseSeed(bool value)
+{
+  m_UseSeed = value;
+}
+
+// -----------------------------------------------------------------------------
+bool SteinerCompact::getUseSeed() const
+{
+  return m_UseSeed;
+}
+
+// -----------------------------------------------------------------------------
+void SteinerCompact::setSeedValue(int value)
+{
+  m_SeedValue = value;
+}
+
+// -----------------------------------------------------------------------------
+int SteinerCompact::getSeedValue() const
+{
+  return m_SeedValue;
+}
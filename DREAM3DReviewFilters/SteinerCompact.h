@@ -36,6 +36,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -63,6 +64,8 @@ class DREAM3DReview_EXPORT SteinerCompact : public AbstractFilter
   PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
   PYB11_PROPERTY(int Plane READ getPlane WRITE setPlane)
   PYB11_PROPERTY(int Sites READ getSites WRITE setSites)
+  PYB11_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+  PYB11_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -195,6 +198,28 @@ public:
   int getSites() const;
   Q_PROPERTY(int Sites READ getSites WRITE setSites)
 
+  /**
+   * @brief Setter property for UseSeed
+   */
+  void setUseSeed(bool value);
+  /**
+   * @brief Getter property for UseSeed
+   * @return Value of UseSeed
+   */
+  bool getUseSeed() const;
+  Q_PROPERTY(bool UseSeed READ getUseSeed WRITE setUseSeed)
+
+  /**
+   * @brief Setter property for SeedValue
+   */
+  void setSeedValue(int value);
+  /**
+   * @brief Getter property for SeedValue
+   * @return Value of SeedValue
+   */
+  int getSeedValue() const;
+  Q_PROPERTY(int SeedValue READ getSeedValue WRITE setSeedValue)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -256,6 +281,21 @@ public:
   void execute() override;
 
 protected:
+  /**
+   * @brief The LineScratch struct holds the buffers find_intersections fills for one line, so that a thread
+   * can reuse them across all the lines it samples
+   */
+  struct LineScratch
+  {
+    std::vector<int64_t> xvoxels;
+    std::vector<int64_t> yvoxels;
+    std::vector<float> xcoor0;
+    std::vector<float> xcoor1;
+    std::vector<float> ycoor0;
+    std::vector<float> ycoor1;
+    std::vector<uint64_t> interfaces;
+  };
+
   SteinerCompact();
   /**
    * @brief dataCheck Checks for the appropriate parameter values and availability of arrays
@@ -273,9 +313,10 @@ protected:
   virtual void rose_of_intersections(std::vector<std::vector<float>>& ROI);
 
   /**
-   * @brief find_intersections Counts the number of intersections of given line with grain boundaries
+   * @brief find_intersections Counts the number of intersections of given line with grain boundaries per phase; it
+   * only reads filter state and may be called concurrently with distinct scratch buffers
    */
-  virtual void find_intersections(float line[3], int64_t z, int64_t dims[3], float res[3], std::vector<float>& numofintersections);
+  virtual void find_intersections(float line[3], int64_t z, int64_t dims[3], float res[3], LineScratch& scratch, float* numofintersections);
 
   /**
    * @brief line_rectangle_intersections Finds the intersections of the line (line[0] * x + line[1] * y + line[2] = 0) with the rectangle (x1, y1, x2, y2)
@@ -319,6 +360,8 @@ private:
   DataArrayPath m_CellPhasesArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases};
   int m_Plane = {0};
   int m_Sites = {1};
+  bool m_UseSeed = {false};
+  int m_SeedValue = {5489};
 
 public:
   SteinerCompact(const SteinerCompact&) = delete;            // Copy Constructor Not Implemented
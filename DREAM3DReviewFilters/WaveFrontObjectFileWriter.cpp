@@ -35,18 +35,133 @@
 #include <QtCore/QDir>
 #include <QtCore/QFileInfo>
 
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <numeric>
+#include <type_traits>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLRange.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataContainerSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "DREAM3DReview/DREAM3DReviewConstants.h"
 #include "DREAM3DReview/DREAM3DReviewVersion.h"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/ParallelHelpers.hpp"
+
+namespace
+{
+constexpr size_t k_LinesPerChunk = 8192;
+constexpr size_t k_ChunksPerBatch = 32;
+constexpr size_t k_MaxNumberLength = 24;
+constexpr size_t k_MaxVertexLineLength = 2 + 3 * (k_MaxNumberLength + 1);
+constexpr size_t k_MaxFaceLineLength = 2 + 3 * (2 * k_MaxNumberLength + 3);
+
+// -----------------------------------------------------------------------------
+template <typename T>
+inline char* appendNumber(char* cursor, T value)
+{
+  if constexpr(std::is_floating_point<T>::value)
+  {
+    // Floating point std::to_chars is missing from several supported standard libraries. "%g" writes the
+    // 6 significant digits of the std::ostream default; the decimal point is forced to '.' since snprintf
+    // follows the C locale, which the application may have changed
+    int length = std::snprintf(cursor, k_MaxNumberLength, "%g", static_cast<double>(value));
+    char* end = cursor + std::min(std::max(length, 0), static_cast<int>(k_MaxNumberLength) - 1);
+    std::replace(cursor, end, ',', '.');
+    return end;
+  }
+  else
+  {
+    return std::to_chars(cursor, cursor + k_MaxNumberLength, value).ptr;
+  }
+}
+
+// -----------------------------------------------------------------------------
+inline char* appendText(char* cursor, const char* text, size_t length)
+{
+  std::memcpy(cursor, text, length);
+  return cursor + length;
+}
+
+/**
+ * @brief The ChunkedLineWriter class formats a run of lines in parallel, one fixed-size chunk of lines
+ * per task, into byte buffers that are then written to the stream in order. Batches of chunks are
+ * reused so memory stays bounded regardless of mesh size.
+ */
+class ChunkedLineWriter
+{
+public:
+  ChunkedLineWriter(std::ofstream& outFile, size_t maxLineLength)
+  : m_OutFile(outFile)
+  , m_Buffers(k_ChunksPerBatch, std::vector<char>(k_LinesPerChunk * maxLineLength))
+  , m_Lengths(k_ChunksPerBatch, 0)
+  {
+  }
+
+  /**
+   * @brief write Writes count lines; formatLine(i, cursor) must write line i at cursor and return the
+   * new end of the buffer
+   * @param count
+   * @param formatLine
+   * @return false if the stream failed
+   */
+  template <typename Formatter>
+  bool write(size_t count, const Formatter& formatLine)
+  {
+    const size_t linesPerBatch = k_LinesPerChunk * k_ChunksPerBatch;
+    for(size_t batchStart = 0; batchStart < count; batchStart += linesPerBatch)
+    {
+      const size_t batchEnd = std::min(count, batchStart + linesPerBatch);
+      const size_t numChunks = (batchEnd - batchStart + k_LinesPerChunk - 1) / k_LinesPerChunk;
+
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, numChunks);
+      dataAlg.execute([&](const SIMPLRange& range) {
+        for(size_t c = range.min(); c < range.max(); c++)
+        {
+          const size_t lineStart = batchStart + c * k_LinesPerChunk;
+          const size_t lineEnd = std::min(batchEnd, lineStart + k_LinesPerChunk);
+          char* begin = m_Buffers[c].data();
+          char* cursor = begin;
+          for(size_t i = lineStart; i < lineEnd; i++)
+          {
+            cursor = formatLine(i, cursor);
+          }
+          m_Lengths[c] = static_cast<size_t>(cursor - begin);
+        }
+      });
+
+      for(size_t c = 0; c < numChunks; c++)
+      {
+        m_OutFile.write(m_Buffers[c].data(), static_cast<std::streamsize>(m_Lengths[c]));
+      }
+      if(!m_OutFile)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  std::ofstream& m_OutFile;
+  std::vector<std::vector<char>> m_Buffers;
+  std::vector<size_t> m_Lengths;
+};
+} // namespace
 
 // -----------------------------------------------------------------------------
 //
@@ -85,6 +200,13 @@ void WaveFrontObjectFileWriter::setupFilterParameters()
   req.dcGeometryTypes = IGeometry::Types(1, IGeometry::Type::Triangle);
   parameters.push_back(SIMPL_NEW_DC_SELECTION_FP("Triangle Geometry", TriangleGeometry, FilterParameter::Category::RequiredArray, WaveFrontObjectFileWriter, req));
 
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Write Vertex Normals", WriteVertexNormals, FilterParameter::Category::Parameter, WaveFrontObjectFileWriter));
+  QStringList linkedProps("FaceGroupIdsArrayPath");
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Split Faces into Groups", WriteFaceGroups, FilterParameter::Category::Parameter, WaveFrontObjectFileWriter, linkedProps));
+  DataArraySelectionFilterParameter::RequirementType dasReq =
+      DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, SIMPL::Defaults::AnyComponentSize, AttributeMatrix::Type::Face, IGeometry::Type::Triangle);
+  parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Face Group Ids", FaceGroupIdsArrayPath, FilterParameter::Category::RequiredArray, WaveFrontObjectFileWriter, dasReq));
+
   setFilterParameters(parameters);
 }
 
@@ -109,6 +231,20 @@ void WaveFrontObjectFileWriter::dataCheck()
   {
     return;
   }
+
+  if(getWriteFaceGroups())
+  {
+    m_FaceGroupIdsPtr = getDataContainerArray()->getPrereqIDataArrayFromPath<Int32ArrayType, AbstractFilter>(this, getFaceGroupIdsArrayPath());
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+    if(m_FaceGroupIdsPtr.lock()->getNumberOfTuples() != triangleGeom->getNumberOfTris())
+    {
+      QString ss = QObject::tr("The Face Group Ids array has %1 tuples but the Triangle Geometry has %2 faces").arg(m_FaceGroupIdsPtr.lock()->getNumberOfTuples()).arg(triangleGeom->getNumberOfTris());
+      setErrorCondition(-2001, ss);
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -141,7 +277,7 @@ void WaveFrontObjectFileWriter::execute()
   SharedVertexList::Pointer vertices = triangleGeom->getVertices();
   size_t numberOfVertices = triangleGeom->getNumberOfVertices();
 
-  std::ofstream outFile(getOutputWaveFrontFile().toStdString().c_str());
+  std::ofstream outFile(getOutputWaveFrontFile().toStdString().c_str(), std::ios_base::out | std::ios_base::binary);
   if(!outFile.is_open())
   {
     QString ss = QObject::tr("Could not open output file %1 for writing.").arg(getOutputWaveFrontFile());
@@ -149,32 +285,162 @@ void WaveFrontObjectFileWriter::execute()
     return;
   }
 
+  float* vertPtr = vertices->getPointer(0);
+  MeshIndexType* triPtr = triangles->getPointer(0);
+  ChunkedLineWriter vertexWriter(outFile, k_MaxVertexLineLength);
+
   outFile << "# Vertices\n";
 
   // Dump the vertices
-  for(size_t i = 0; i < numberOfVertices; i++)
+  bool success = vertexWriter.write(numberOfVertices, [vertPtr](size_t i, char* cursor) {
+    cursor = appendText(cursor, "v ", 2);
+    cursor = appendNumber(cursor, vertPtr[3 * i + 0]);
+    *cursor++ = ' ';
+    cursor = appendNumber(cursor, vertPtr[3 * i + 1]);
+    *cursor++ = ' ';
+    cursor = appendNumber(cursor, vertPtr[3 * i + 2]);
+    *cursor++ = '\n';
+    return cursor;
+  });
+
+  std::vector<float> normals;
+  if(success && m_WriteVertexNormals)
   {
-    float c0 = vertices->getComponent(i, 0);
-    float c1 = vertices->getComponent(i, 1);
-    float c2 = vertices->getComponent(i, 2);
+    notifyStatusMessage("Computing Vertex Normals...");
+    normals = computeVertexNormals(triangleGeom);
+
+    outFile << "\n# Vertex Normals\n";
+    const float* normalPtr = normals.data();
+    success = vertexWriter.write(numberOfVertices, [normalPtr](size_t i, char* cursor) {
+      cursor = appendText(cursor, "vn ", 3);
+      cursor = appendNumber(cursor, normalPtr[3 * i + 0]);
+      *cursor++ = ' ';
+      cursor = appendNumber(cursor, normalPtr[3 * i + 1]);
+      *cursor++ = ' ';
+      cursor = appendNumber(cursor, normalPtr[3 * i + 2]);
+      *cursor++ = '\n';
+      return cursor;
+    });
+  }
 
-    outFile << "v " << c0 << " " << c1 << " " << c2 << "\n";
+  // Faces are written either in storage order or, when splitting into groups, in the order given by
+  // a parallel sort on (group id, face index)
+  std::vector<MeshIndexType> faceOrder;
+  std::vector<MeshIndexType> groupOffsets = {0, numberOfTriangles};
+  std::vector<int32_t> groupIds;
+  if(success && m_WriteFaceGroups)
+  {
+    Int32ArrayType::Pointer faceGroupIds = m_FaceGroupIdsPtr.lock();
+    const int32_t* groupPtr = faceGroupIds->getPointer(0);
+    const size_t numComps = faceGroupIds->getNumberOfComponents();
+    faceOrder.resize(numberOfTriangles);
+    std::iota(faceOrder.begin(), faceOrder.end(), 0);
+    ParallelHelpers::sort(faceOrder.begin(), faceOrder.end(), [groupPtr, numComps](MeshIndexType a, MeshIndexType b) {
+      return groupPtr[numComps * a] < groupPtr[numComps * b] || (groupPtr[numComps * a] == groupPtr[numComps * b] && a < b);
+    });
+
+    groupOffsets.clear();
+    for(MeshIndexType i = 0; i < numberOfTriangles; i++)
+    {
+      int32_t groupId = groupPtr[numComps * faceOrder[i]];
+      if(i == 0 || groupId != groupIds.back())
+      {
+        groupIds.push_back(groupId);
+        groupOffsets.push_back(i);
+      }
+    }
+    groupOffsets.push_back(numberOfTriangles);
   }
 
-  outFile << "\n# Faces\n";
+  if(success)
+  {
+    outFile << "\n# Faces\n";
+  }
 
-  // Dump the triangle faces
-  for(size_t i = 0; i < numberOfTriangles; i++)
+  // Dump the triangle faces; the vertex values that make up the face must be 1-based
+  ChunkedLineWriter faceWriter(outFile, k_MaxFaceLineLength);
+  const bool writeNormals = m_WriteVertexNormals;
+  const MeshIndexType* orderPtr = faceOrder.empty() ? nullptr : faceOrder.data();
+  for(size_t g = 0; success && g + 1 < groupOffsets.size(); g++)
   {
-    size_t c0 = triangles->getComponent(i, 0);
-    size_t c1 = triangles->getComponent(i, 1);
-    size_t c2 = triangles->getComponent(i, 2);
+    if(!groupIds.empty())
+    {
+      outFile << "g Group_" << groupIds[g] << "\n";
+    }
+
+    const MeshIndexType groupStart = groupOffsets[g];
+    success = faceWriter.write(groupOffsets[g + 1] - groupStart, [=](size_t i, char* cursor) {
+      MeshIndexType face = (nullptr != orderPtr) ? orderPtr[groupStart + i] : groupStart + i;
+      *cursor++ = 'f';
+      for(size_t j = 0; j < 3; j++)
+      {
+        *cursor++ = ' ';
+        cursor = appendNumber(cursor, triPtr[3 * face + j] + 1);
+        if(writeNormals)
+        {
+          cursor = appendText(cursor, "//", 2);
+          cursor = appendNumber(cursor, triPtr[3 * face + j] + 1);
+        }
+      }
+      *cursor++ = '\n';
+      return cursor;
+    });
+  }
 
-    // These vertex values that make up the face must be 1-based
-    outFile << "f " << c0 + 1 << " " << c1 + 1 << " " << c2 + 1 << "\n";
+  if(!success)
+  {
+    QString ss = QObject::tr("Error writing to output file %1").arg(getOutputWaveFrontFile());
+    setErrorCondition(-2002, ss);
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<float> WaveFrontObjectFileWriter::computeVertexNormals(const TriangleGeom::Pointer& triangleGeom)
+{
+  // Area weighted average of the normals of the faces around each vertex, gathered per vertex so
+  // that vertices can be processed independently
+  triangleGeom->findElementsContainingVert();
+  ElementDynamicList::Pointer trisContainingVert = triangleGeom->getElementsContainingVert();
+  const float* vertPtr = triangleGeom->getVertexPointer(0);
+  const MeshIndexType* triPtr = triangleGeom->getTriPointer(0);
+  MeshIndexType numVerts = triangleGeom->getNumberOfVertices();
+  std::vector<float> normals(3 * numVerts, 0.0f);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numVerts);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t v = range.min(); v < range.max(); v++)
+    {
+      double normal[3] = {0.0, 0.0, 0.0};
+      uint16_t numTris = trisContainingVert->getNumberOfElements(v);
+      MeshIndexType* trisAtVert = trisContainingVert->getElementListPointer(v);
+      for(uint16_t t = 0; t < numTris; t++)
+      {
+        const float* a = vertPtr + 3 * triPtr[3 * trisAtVert[t] + 0];
+        const float* b = vertPtr + 3 * triPtr[3 * trisAtVert[t] + 1];
+        const float* c = vertPtr + 3 * triPtr[3 * trisAtVert[t] + 2];
+        double ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        double ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        normal[0] += ab[1] * ac[2] - ab[2] * ac[1];
+        normal[1] += ab[2] * ac[0] - ab[0] * ac[2];
+        normal[2] += ab[0] * ac[1] - ab[1] * ac[0];
+      }
+      double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+      if(length > 0.0)
+      {
+        for(size_t d = 0; d < 3; d++)
+        {
+          normals[3 * v + d] = static_cast<float>(normal[d] / length);
+        }
+      }
+    }
+  });
+
+  return normals;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -299,3 +565,39 @@ DataArrayPath WaveFrontObjectFileWriter::getTriangleGeometry() const
 {
   return m_TriangleGeometry;
 }
+
+// -----------------------------------------------------------------------------
+void WaveFrontObjectFileWriter::setWriteVertexNormals(bool value)
+{
+  m_WriteVertexNormals = value;
+}
+
+// -----------------------------------------------------------------------------
+bool WaveFrontObjectFileWriter::getWriteVertexNormals() const
+{
+  return m_WriteVertexNormals;
+}
+
+// -----------------------------------------------------------------------------
+void WaveFrontObjectFileWriter::setWriteFaceGroups(bool value)
+{
+  m_WriteFaceGroups = value;
+}
+
+// -----------------------------------------------------------------------------
+bool WaveFrontObjectFileWriter::getWriteFaceGroups() const
+{
+  return m_WriteFaceGroups;
+}
+
+// -----------------------------------------------------------------------------
+void WaveFrontObjectFileWriter::setFaceGroupIdsArrayPath(const DataArrayPath& value)
+{
+  m_FaceGroupIdsArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath WaveFrontObjectFileWriter::getFaceGroupIdsArrayPath() const
+{
+  return m_FaceGroupIdsArrayPath;
+}
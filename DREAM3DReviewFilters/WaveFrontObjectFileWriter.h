@@ -34,6 +34,7 @@
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
 
 #include "DREAM3DReview/DREAM3DReviewPlugin.h"
 
@@ -51,6 +52,9 @@ class DREAM3DReview_EXPORT WaveFrontObjectFileWriter : public AbstractFilter
   PYB11_FILTER_NEW_MACRO(WaveFrontObjectFileWriter)
   PYB11_PROPERTY(QString OutputWaveFrontFile READ getOutputWaveFrontFile WRITE setOutputWaveFrontFile)
   PYB11_PROPERTY(DataArrayPath TriangleGeometry READ getTriangleGeometry WRITE setTriangleGeometry)
+  PYB11_PROPERTY(bool WriteVertexNormals READ getWriteVertexNormals WRITE setWriteVertexNormals)
+  PYB11_PROPERTY(bool WriteFaceGroups READ getWriteFaceGroups WRITE setWriteFaceGroups)
+  PYB11_PROPERTY(DataArrayPath FaceGroupIdsArrayPath READ getFaceGroupIdsArrayPath WRITE setFaceGroupIdsArrayPath)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -98,6 +102,39 @@ public:
   DataArrayPath getTriangleGeometry() const;
   Q_PROPERTY(DataArrayPath TriangleGeometry READ getTriangleGeometry WRITE setTriangleGeometry)
 
+  /**
+   * @brief Setter property for WriteVertexNormals
+   */
+  void setWriteVertexNormals(bool value);
+  /**
+   * @brief Getter property for WriteVertexNormals
+   * @return Value of WriteVertexNormals
+   */
+  bool getWriteVertexNormals() const;
+  Q_PROPERTY(bool WriteVertexNormals READ getWriteVertexNormals WRITE setWriteVertexNormals)
+
+  /**
+   * @brief Setter property for WriteFaceGroups
+   */
+  void setWriteFaceGroups(bool value);
+  /**
+   * @brief Getter property for WriteFaceGroups
+   * @return Value of WriteFaceGroups
+   */
+  bool getWriteFaceGroups() const;
+  Q_PROPERTY(bool WriteFaceGroups READ getWriteFaceGroups WRITE setWriteFaceGroups)
+
+  /**
+   * @brief Setter property for FaceGroupIdsArrayPath
+   */
+  void setFaceGroupIdsArrayPath(const DataArrayPath& value);
+  /**
+   * @brief Getter property for FaceGroupIdsArrayPath
+   * @return Value of FaceGroupIdsArrayPath
+   */
+  DataArrayPath getFaceGroupIdsArrayPath() const;
+  Q_PROPERTY(DataArrayPath FaceGroupIdsArrayPath READ getFaceGroupIdsArrayPath WRITE setFaceGroupIdsArrayPath)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -166,9 +203,21 @@ protected:
    */
   void initialize();
 
+  /**
+   * @brief computeVertexNormals Computes area weighted, unit length normals for every vertex
+   * @param triangleGeom
+   * @return Interleaved x, y, z normal components
+   */
+  std::vector<float> computeVertexNormals(const TriangleGeom::Pointer& triangleGeom);
+
 private:
+  std::weak_ptr<Int32ArrayType> m_FaceGroupIdsPtr;
+
   QString m_OutputWaveFrontFile = {};
   DataArrayPath m_TriangleGeometry = {};
+  bool m_WriteVertexNormals = false;
+  bool m_WriteFaceGroups = false;
+  DataArrayPath m_FaceGroupIdsArrayPath = {SIMPL::Defaults::TriangleDataContainerName, SIMPL::Defaults::FaceAttributeMatrixName, SIMPL::FaceData::SurfaceMeshFaceLabels};
 
 public:
   WaveFrontObjectFileWriter(const WaveFrontObjectFileWriter&) = delete;            // Copy Constructor Not Implemented
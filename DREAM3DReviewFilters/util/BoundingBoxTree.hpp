@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The BoundingBoxTree class is a bounding volume hierarchy over a list of axis aligned boxes. Queries
+ * return the smallest box index whose box contains a point and that passes a caller supplied exact test, so
+ * the same tree serves both plain boxes and shapes that are only bounded by their box. Every node stores the
+ * smallest box index below it, which lets a query skip subtrees that cannot improve on the box already found.
+ * The tree is immutable once built, so it may be queried concurrently.
+ */
+class BoundingBoxTree
+{
+public:
+  struct Box
+  {
+    float min[3];
+    float max[3];
+  };
+
+  explicit BoundingBoxTree(std::vector<Box> boxes)
+  : m_Boxes(std::move(boxes))
+  {
+    m_Order.resize(m_Boxes.size());
+    std::iota(m_Order.begin(), m_Order.end(), 0);
+    if(!m_Order.empty())
+    {
+      m_Nodes.emplace_back();
+      build(0, 0, m_Order.size());
+    }
+  }
+
+  ~BoundingBoxTree() = default;
+
+  BoundingBoxTree(const BoundingBoxTree&) = delete;
+  BoundingBoxTree(BoundingBoxTree&&) = delete;
+  BoundingBoxTree& operator=(const BoundingBoxTree&) = delete;
+  BoundingBoxTree& operator=(BoundingBoxTree&&) = delete;
+
+  /**
+   * @brief size
+   * @return Number of boxes in the tree
+   */
+  size_t size() const
+  {
+    return m_Boxes.size();
+  }
+
+  /**
+   * @brief getBox
+   * @param index
+   * @return Box with the given index
+   */
+  const Box& getBox(size_t index) const
+  {
+    return m_Boxes[index];
+  }
+
+  /**
+   * @brief findFirstBox Returns the smallest index of a box that contains the point (boundary included) and
+   * for which accept(index) returns true, or -1 if there is none
+   * @param x
+   * @param y
+   * @param z
+   * @param accept Exact containment test called with a box index
+   * @return
+   */
+  template <typename Predicate>
+  int64_t findFirstBox(float x, float y, float z, Predicate accept) const
+  {
+    int64_t best = -1;
+    if(m_Nodes.empty())
+    {
+      return best;
+    }
+    const float point[3] = {x, y, z};
+    int32_t stack[k_MaxDepth];
+    int32_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while(stackSize > 0)
+    {
+      const Node& node = m_Nodes[stack[--stackSize]];
+      if((best >= 0 && node.minBox >= best) || !contains(node.bounds, point))
+      {
+        continue;
+      }
+      if(node.count > 0)
+      {
+        for(int32_t i = node.start; i < node.start + node.count; i++)
+        {
+          int64_t box = m_Order[i];
+          if((best < 0 || box < best) && contains(m_Boxes[box], point) && accept(static_cast<size_t>(box)))
+          {
+            best = box;
+          }
+        }
+        continue;
+      }
+      // Visit the child holding the smaller box index first so the pruning bound tightens early
+      int32_t first = node.start;
+      int32_t second = node.start + 1;
+      if(m_Nodes[second].minBox < m_Nodes[first].minBox)
+      {
+        std::swap(first, second);
+      }
+      stack[stackSize++] = second;
+      stack[stackSize++] = first;
+    }
+    return best;
+  }
+
+private:
+  static constexpr size_t k_LeafSize = 4;
+  static constexpr int32_t k_MaxDepth = 128;
+
+  // Leaves have count > 0 and hold m_Order[start, start + count); inner nodes have count == 0 and their
+  // two children stored next to each other at start and start + 1
+  struct Node
+  {
+    Box bounds;
+    int32_t start = 0;
+    int32_t count = 0;
+    int64_t minBox = 0;
+  };
+
+  std::vector<Box> m_Boxes;
+  std::vector<int64_t> m_Order;
+  std::vector<Node> m_Nodes;
+
+  static bool contains(const Box& box, const float point[3])
+  {
+    return point[0] >= box.min[0] && point[0] <= box.max[0] && point[1] >= box.min[1] && point[1] <= box.max[1] && point[2] >= box.min[2] && point[2] <= box.max[2];
+  }
+
+  static Box emptyBox()
+  {
+    const float lowest = std::numeric_limits<float>::lowest();
+    const float largest = std::numeric_limits<float>::max();
+    return {{largest, largest, largest}, {lowest, lowest, lowest}};
+  }
+
+  void build(size_t nodeIndex, size_t begin, size_t end)
+  {
+    Node node;
+    node.bounds = emptyBox();
+    node.minBox = std::numeric_limits<int64_t>::max();
+    Box centers = emptyBox();
+    for(size_t i = begin; i < end; i++)
+    {
+      const Box& box = m_Boxes[m_Order[i]];
+      for(size_t d = 0; d < 3; d++)
+      {
+        node.bounds.min[d] = std::min(node.bounds.min[d], box.min[d]);
+        node.bounds.max[d] = std::max(node.bounds.max[d], box.max[d]);
+        float center = 0.5f * (box.min[d] + box.max[d]);
+        centers.min[d] = std::min(centers.min[d], center);
+        centers.max[d] = std::max(centers.max[d], center);
+      }
+      node.minBox = std::min(node.minBox, m_Order[i]);
+    }
+
+    if(end - begin <= k_LeafSize)
+    {
+      node.start = static_cast<int32_t>(begin);
+      node.count = static_cast<int32_t>(end - begin);
+      m_Nodes[nodeIndex] = node;
+      return;
+    }
+
+    // Median split along the longest axis of the box centers
+    size_t axis = 0;
+    for(size_t d = 1; d < 3; d++)
+    {
+      if(centers.max[d] - centers.min[d] > centers.max[axis] - centers.min[axis])
+      {
+        axis = d;
+      }
+    }
+    size_t middle = begin + (end - begin) / 2;
+    std::nth_element(m_Order.begin() + begin, m_Order.begin() + middle, m_Order.begin() + end, [this, axis](int64_t lhs, int64_t rhs) {
+      return m_Boxes[lhs].min[axis] + m_Boxes[lhs].max[axis] < m_Boxes[rhs].min[axis] + m_Boxes[rhs].max[axis];
+    });
+
+    size_t children = m_Nodes.size();
+    m_Nodes.emplace_back();
+    m_Nodes.emplace_back();
+    build(children, begin, middle);
+    build(children + 1, middle, end);
+    node.start = static_cast<int32_t>(children);
+    node.count = 0;
+    m_Nodes[nodeIndex] = node;
+  }
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief The CounterRng class is a counter based random number generator: every value is a hash of a key and a
+ * running counter. Keying one generator per unit of work (e.g. by seed, pass and element) gives every unit its own
+ * stream, so threads share no generator state and results do not depend on how work is scheduled across threads.
+ */
+class CounterRng
+{
+public:
+  explicit CounterRng(uint64_t key)
+  : m_Key(key)
+  {
+  }
+
+  /**
+   * @brief mix The splitmix64 finalizer, also useful to derive keys from several integers
+   * @param z
+   * @return
+   */
+  static uint64_t mix(uint64_t z)
+  {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  /**
+   * @brief next
+   * @return Next 64 random bits of the stream
+   */
+  uint64_t next()
+  {
+    m_Counter++;
+    return mix(m_Key + m_Counter * 0x9E3779B97F4A7C15ULL);
+  }
+
+  /**
+   * @brief uniformIndex
+   * @param n
+   * @return Uniform integer in [0, n)
+   */
+  size_t uniformIndex(size_t n)
+  {
+    return static_cast<size_t>(((next() >> 32) * n) >> 32);
+  }
+
+  /**
+   * @brief uniformReal
+   * @return Uniform real in [0, 1)
+   */
+  double uniformReal()
+  {
+    return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+private:
+  uint64_t m_Key;
+  uint64_t m_Counter = 0;
+};
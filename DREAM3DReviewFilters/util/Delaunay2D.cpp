@@ -1,14 +1,88 @@
 #include "Delaunay2D.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include <Eigen/Dense>
 
 #include "SIMPLib/Math/MatrixMath.h"
 
+namespace
+{
+constexpr uint32_t k_HilbertOrder = 16;
+constexpr size_t k_MinRoundSize = 64;
+constexpr size_t k_PointsPerBucket = 4;
+constexpr uint32_t k_InsertionSeed = 5489u;
+
+// -----------------------------------------------------------------------------
+uint64_t hilbertIndex(uint32_t x, uint32_t y)
+{
+  uint64_t d = 0;
+  for(uint32_t s = 1u << (k_HilbertOrder - 1); s > 0; s >>= 1)
+  {
+    uint32_t rx = (x & s) > 0 ? 1 : 0;
+    uint32_t ry = (y & s) > 0 ? 1 : 0;
+    d += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+    if(ry == 0)
+    {
+      if(rx == 1)
+      {
+        x = ~x;
+        y = ~y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return d;
+}
+
+/**
+ * @brief findInsertionOrder Computes a biased randomized insertion order (BRIO): the points are
+ * shuffled and split into rounds of doubling size, and each round is sorted along a Hilbert curve.
+ * Consecutive insertions are then spatially close, which keeps the point location walks short,
+ * while the randomized rounds avoid the worst cases of a purely sorted order.
+ * @param vertices
+ * @param numVerts
+ * @param bounds
+ * @return
+ */
+std::vector<int64_t> findInsertionOrder(const TriMesh::VertexCoordList& vertices, size_t numVerts, const double bounds[6])
+{
+  std::vector<int64_t> order(numVerts);
+  std::iota(order.begin(), order.end(), 0);
+  std::mt19937 generator(k_InsertionSeed);
+  std::shuffle(order.begin(), order.end(), generator);
+
+  const double maxCoord = static_cast<double>((1u << k_HilbertOrder) - 1);
+  const double scaleX = (bounds[1] > bounds[0]) ? maxCoord / (bounds[1] - bounds[0]) : 0.0;
+  const double scaleY = (bounds[3] > bounds[2]) ? maxCoord / (bounds[3] - bounds[2]) : 0.0;
+  std::vector<uint64_t> keys(numVerts);
+  for(size_t v = 0; v < numVerts; v++)
+  {
+    uint32_t hx = static_cast<uint32_t>((vertices.x[v] - bounds[0]) * scaleX);
+    uint32_t hy = static_cast<uint32_t>((vertices.y[v] - bounds[2]) * scaleY);
+    keys[v] = hilbertIndex(hx, hy);
+  }
+
+  auto byKey = [&keys](int64_t a, int64_t b) { return keys[a] < keys[b]; };
+  size_t end = numVerts;
+  while(end > k_MinRoundSize)
+  {
+    size_t start = end / 2;
+    std::sort(order.begin() + start, order.begin() + end, byKey);
+    end = start;
+  }
+  std::sort(order.begin(), order.begin() + end, byKey);
+
+  return order;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 Delaunay2D::Delaunay2D(TriMesh::VertexCoordList vertices, double offset, double tolerance, double alpha, Observable* observable)
-: m_Vertices(vertices)
+: m_Vertices(std::move(vertices))
 , m_Offset(offset)
 , m_Tolerance(tolerance)
 , m_Alpha(alpha)
@@ -36,6 +110,7 @@ void Delaunay2D::initialize()
 
   m_NumDuplicatePoints = 0;
   m_NumDegeneracies = 0;
+  m_WalkGenerator.seed(k_InsertionSeed);
 
   m_Delaunay = TriMesh::NullPointer();
 }
@@ -54,21 +129,14 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
 
   /* Eigen::Transform<double, 3, Eigen::Affine> transform = */ findProjectionPlane();
 
-  TriMesh::VertexCoordList projectedVertices(m_Vertices);
-
   auto numVerts = m_Vertices.size();
 
-  for(size_t v = 0; v < numVerts; v++)
-  {
-    Eigen::Vector3d point(m_Vertices[v][0], m_Vertices[v][1], m_Vertices[v][2]);
-    // Eigen::Vector3d transformedPoint = transform * point;
-    // projectedVertices[v][0] = transformedPoint(0);
-    // projectedVertices[v][1] = transformedPoint(1);
-    // projectedVertices[v][2] = transformedPoint(2);
-    projectedVertices[v][0] = point(0);
-    projectedVertices[v][1] = point(1);
-    projectedVertices[v][2] = point(2);
-  }
+  // The 8 bounding points are appended after the input vertices
+  TriMesh::VertexCoordList projectedVertices;
+  projectedVertices.reserve(numVerts + 8);
+  projectedVertices.x.assign(m_Vertices.x.begin(), m_Vertices.x.end());
+  projectedVertices.y.assign(m_Vertices.y.begin(), m_Vertices.y.end());
+  projectedVertices.z.assign(m_Vertices.z.begin(), m_Vertices.z.end());
 
   findPointBounds(projectedVertices);
 
@@ -96,16 +164,18 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
     x[0] = center[0] + radius * cos(ptId * 45.0 * SIMPLib::Constants::k_PiOver180D);
     x[1] = center[1] + radius * sin(ptId * 45.0 * SIMPLib::Constants::k_PiOver180D);
     x[2] = center[2];
-    projectedVertices.emplace_back(std::initializer_list<float>{float(x[0]), float(x[1]), float(x[2])});
+    projectedVertices.push_back(float(x[0]), float(x[1]), float(x[2]));
   }
 
-  m_Delaunay = TriMesh::New(projectedVertices);
+  m_Delaunay = TriMesh::New(std::move(projectedVertices));
   m_Delaunay->addTriangle(numVerts + 0, numVerts + 1, numVerts + 2);
   m_Delaunay->addTriangle(numVerts + 2, numVerts + 3, numVerts + 4);
   m_Delaunay->addTriangle(numVerts + 4, numVerts + 5, numVerts + 6);
   m_Delaunay->addTriangle(numVerts + 6, numVerts + 7, numVerts + 0);
   m_Delaunay->addTriangle(numVerts + 0, numVerts + 2, numVerts + 6);
   m_Delaunay->addTriangle(numVerts + 2, numVerts + 4, numVerts + 6);
+  m_Delaunay->buildTriangleLinks();
+  const TriMesh::VertexCoordList& points = m_Delaunay->getVertices();
 
   int64_t nei[3];
   int64_t neiPts[3];
@@ -117,16 +187,45 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
 
   tri[0] = 0;
 
+  // Points are inserted in BRIO order, so each walk normally starts from the triangle created for the
+  // previous point. A coarse grid remembers the last point inserted into each bucket and is used as a
+  // jump start whenever it is closer than the previous point, e.g. at the start of a new round.
+  std::vector<int64_t> insertionOrder = findInsertionOrder(points, numVerts, m_PointBounds);
+  const size_t bucketDim = std::max<size_t>(1, static_cast<size_t>(std::sqrt(static_cast<double>(numVerts) / k_PointsPerBucket)));
+  const double bucketScaleX = (m_PointBounds[1] > m_PointBounds[0]) ? bucketDim / (m_PointBounds[1] - m_PointBounds[0]) : 0.0;
+  const double bucketScaleY = (m_PointBounds[3] > m_PointBounds[2]) ? bucketDim / (m_PointBounds[3] - m_PointBounds[2]) : 0.0;
+  std::vector<int64_t> buckets(bucketDim * bucketDim, -1);
+  int64_t lastTri = 0;
+  int64_t lastPoint = -1;
+
   int64_t progIncrement = static_cast<int64_t>(numVerts / 100);
   int64_t prog = 1;
   int64_t progressInt = 0;
   int64_t counter = 0;
 
-  for(int64_t ptId = 0; ptId < int64_t(numVerts); ptId++)
+  for(int64_t ptId : insertionOrder)
   {
-    x[0] = projectedVertices[ptId][0];
-    x[1] = projectedVertices[ptId][1];
-    x[2] = projectedVertices[ptId][2];
+    x[0] = points.x[ptId];
+    x[1] = points.y[ptId];
+    x[2] = points.z[ptId];
+
+    size_t bucketX = std::min(bucketDim - 1, static_cast<size_t>((x[0] - m_PointBounds[0]) * bucketScaleX));
+    size_t bucketY = std::min(bucketDim - 1, static_cast<size_t>((x[1] - m_PointBounds[2]) * bucketScaleY));
+    int64_t& bucket = buckets[bucketY * bucketDim + bucketX];
+
+    tri[0] = lastTri;
+    if(bucket >= 0 && bucket != lastPoint)
+    {
+      auto distance2 = [&x, &points](int64_t v) {
+        double dx = points.x[v] - x[0];
+        double dy = points.y[v] - x[1];
+        return dx * dx + dy * dy;
+      };
+      if(lastPoint < 0 || distance2(bucket) < distance2(lastPoint))
+      {
+        tri[0] = m_Delaunay->getVertexTriangle(bucket);
+      }
+    }
 
     nei[0] = (-1); // where we are coming from...nowhere initially
 
@@ -140,9 +239,7 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
         nodes[0][0] = ptId;
         nodes[0][1] = pts[0];
         nodes[0][2] = pts[1];
-        m_Delaunay->removeLinkFromTriangle(pts[2], tri[0]);
         m_Delaunay->replaceTriangleVertices(nodes[0][0], nodes[0][1], nodes[0][2], tri[0]);
-        m_Delaunay->addLinkToTriangle(ptId, tri[0]);
 
         nodes[1][0] = ptId;
         nodes[1][1] = pts[1];
@@ -153,6 +250,7 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
         nodes[2][1] = pts[2];
         nodes[2][2] = pts[0];
         tri[2] = m_Delaunay->addTriangle(nodes[2][0], nodes[2][1], nodes[2][2]);
+        m_Delaunay->relinkTriangles(tri, 3);
 
         // Check edge neighbors for Delaunay criterion. If not satisfied, flip
         // edge diagonal. (This is done recursively.)
@@ -177,9 +275,6 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
           }
         }
 
-        m_Delaunay->removeLinkFromTriangle(nei[2], tri[0]);
-        m_Delaunay->removeLinkFromTriangle(nei[2], nei[0]);
-
         nodes[0][0] = ptId;
         nodes[0][1] = p2;
         nodes[0][2] = nei[1];
@@ -190,9 +285,6 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
         nodes[1][2] = nei[1];
         m_Delaunay->replaceTriangleVertices(nodes[1][0], nodes[1][1], nodes[1][2], nei[0]);
 
-        m_Delaunay->addLinkToTriangle(ptId, tri[0]);
-        m_Delaunay->addLinkToTriangle(ptId, nei[0]);
-
         tri[1] = nei[0];
 
         nodes[2][0] = ptId;
@@ -204,6 +296,7 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
         nodes[3][1] = p1;
         nodes[3][2] = nei[2];
         tri[3] = m_Delaunay->addTriangle(nodes[3][0], nodes[3][1], nodes[3][2]);
+        m_Delaunay->relinkTriangles(tri, 4);
 
         // Check edge neighbors for Delaunay criterion.
         for(size_t i = 0; i < 4; i++)
@@ -211,12 +304,11 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
           checkEdge(ptId, x, nodes[i][1], nodes[i][2], tri[i], true);
         }
       }
-    } // if triangle found
 
-    else
-    {
-      tri[0] = 0; // no triangle found
-    }
+      lastTri = m_Delaunay->getVertexTriangle(ptId);
+      lastPoint = ptId;
+      bucket = ptId;
+    } // if triangle found
 
     if(counter > prog)
     {
@@ -229,10 +321,11 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
   } // for all points
 
   std::vector<int64_t> triUse(m_Delaunay->getNumberOfTriangles(), 1);
+  std::vector<int64_t> neighborTris;
 
   for(int64_t ptId = numVerts; ptId < int64_t((numVerts + 8)); ptId++)
   {
-    std::vector<int64_t> neighborTris = m_Delaunay->getTrianglesToVertex(ptId);
+    m_Delaunay->getTrianglesToVertex(ptId, neighborTris);
     for(auto&& neighbor : neighborTris)
     {
       triUse[neighbor] = 0;
@@ -371,19 +464,9 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
   //}
   ////alpha end
 
-  fixupBoundaryTriangles(numVerts, projectedVertices, triUse);
-
-  // Remove the 8 bounding triangle vertices
-  TriMesh::VertexList delVerts = m_Delaunay->getVertices();
-  for(size_t i = numVerts; i < 8; i++)
-  {
-    delVerts.pop_back();
-  }
-
-  // std::vector<int64_t> vertsToRemove(8);
-  // std::iota(vertsToRemove.begin(), vertsToRemove.end(), numVerts);
-  // m_Delaunay->removeVertices(vertsToRemove);
+  fixupBoundaryTriangles(numVerts, triUse);
 
+  // The 8 bounding vertices are dropped; they are the last vertices and only used by removed triangles
   size_t numGoodTris = 0;
 
   for(size_t i = 0; i < triUse.size(); i++)
@@ -394,44 +477,31 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
     }
   }
 
-  std::vector<std::vector<float>> untransformedVerts;
-  for(auto i = 0; i < numVerts; i++)
-  {
-    untransformedVerts.push_back(delVerts[i].vert);
-  }
-
-  SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(untransformedVerts.size());
+  SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(numVerts);
   TriangleGeom::Pointer triangles = TriangleGeom::CreateGeometry(numGoodTris, vertices, SIMPL::Geometry::TriangleGeometry);
   float* vertPtr = triangles->getVertexPointer(0);
   size_t* triPtr = triangles->getTriPointer(0);
 
-  TriMesh::TriList triList = m_Delaunay->getTriangles();
+  const TriMesh::TriList& triList = m_Delaunay->getTriangles();
 
   size_t triIter = 0;
-  int64_t triVerts[3];
 
-  for(auto i = 0; i < triList.size(); i++)
+  for(size_t i = 0; i < triUse.size(); i++)
   {
     if(triUse[i])
     {
-      m_Delaunay->getTriangleVertices(i, triVerts);
-      triPtr[3 * triIter + 0] = triVerts[0];
-      triPtr[3 * triIter + 1] = triVerts[1];
-      triPtr[3 * triIter + 2] = triVerts[2];
+      triPtr[3 * triIter + 0] = triList[3 * i + 0];
+      triPtr[3 * triIter + 1] = triList[3 * i + 1];
+      triPtr[3 * triIter + 2] = triList[3 * i + 2];
       triIter++;
     }
   }
 
-  for(auto i = 0; i < untransformedVerts.size(); i++)
+  for(size_t i = 0; i < numVerts; i++)
   {
-    Eigen::Vector3d point(untransformedVerts[i][0], untransformedVerts[i][1], untransformedVerts[i][2]);
-    // Eigen::Vector3d transformedPoint = transform.inverse() * point;
-    // vertPtr[3 * i + 0] = transformedPoint(0);
-    // vertPtr[3 * i + 1] = transformedPoint(1);
-    // vertPtr[3 * i + 2] = transformedPoint(2);
-    vertPtr[3 * i + 0] = point(0);
-    vertPtr[3 * i + 1] = point(1);
-    vertPtr[3 * i + 2] = point(2);
+    vertPtr[3 * i + 0] = points.x[i];
+    vertPtr[3 * i + 1] = points.y[i];
+    vertPtr[3 * i + 2] = points.z[i];
   }
 
   return triangles;
@@ -442,86 +512,109 @@ TriangleGeom::Pointer Delaunay2D::triangulate()
 // -----------------------------------------------------------------------------
 int64_t Delaunay2D::findTriangle(double x[3], int64_t tri, double tol, int64_t nei[3], int64_t pts[3])
 {
-  int i, j, ir, ic, inside, i2, i3;
+  int i, j, ir, ic, i2, i3;
   int64_t newNei;
-  double p[3][3], n[2], vp[2], vx[2], dp, minProj;
-
-  m_Delaunay->getTriangleVertices(tri, pts);
-  m_Delaunay->getVertexCoordinates(pts[0], p[0]);
-  m_Delaunay->getVertexCoordinates(pts[1], p[1]);
-  m_Delaunay->getVertexCoordinates(pts[2], p[2]);
+  int64_t fromEdge[2] = {-1, -1};
+  double p[3][3], n[2], vp[2], vx[2], dp;
 
-  srand(tri);
-  ir = rand() % 3;
   const double del2D_tolerance = 1.0e-014;
+  const int64_t maxSteps = m_Delaunay->getNumberOfTriangles();
 
-  for(inside = 1, minProj = del2D_tolerance, ic = 0; ic < 3; ic++)
+  // Remembering stochastic walk: the edges of each triangle are tested starting from a random one,
+  // the walk steps across the first edge that separates the triangle from the point, and the edge
+  // that was just crossed is never tested again
+  for(int64_t step = 0; step <= maxSteps; step++)
   {
-    i = (ir + ic) % 3;
-    i2 = (i + 1) % 3;
-    i3 = (i + 2) % 3;
-
-    // create a 2D edge normal to define a "half-space"; evaluate points (i.e.,
-    // candidate point and other triangle vertex not on this edge).
-    n[0] = -(p[i2][1] - p[i][1]);
-    n[1] = p[i2][0] - p[i][0];
-    Normalize2x1(n);
-
-    // compute local vectors
-    for(j = 0; j < 2; j++)
-    {
-      vp[j] = p[i3][j] - p[i][j];
-      vx[j] = x[j] - p[i][j];
-    }
+    m_Delaunay->getTriangleVertices(tri, pts);
+    m_Delaunay->getVertexCoordinates(pts[0], p[0]);
+    m_Delaunay->getVertexCoordinates(pts[1], p[1]);
+    m_Delaunay->getVertexCoordinates(pts[2], p[2]);
 
     // check for duplicate point
-    Normalize2x1(vp);
-    if(Normalize2x1(vx) <= tol)
+    for(i = 0; i < 3; i++)
     {
-      m_NumDuplicatePoints++;
-      return -1;
+      vx[0] = x[0] - p[i][0];
+      vx[1] = x[1] - p[i][1];
+      if(Normalize2x1(vx) <= tol)
+      {
+        m_NumDuplicatePoints++;
+        return -1;
+      }
     }
 
-    // see if two points are in opposite half spaces
-    dp = Dot2D(n, vx) * (Dot2D(n, vp) < 0 ? -1.0 : 1.0);
-    if(dp < del2D_tolerance)
+    ir = static_cast<int>(m_WalkGenerator() % 3);
+    int onEdge = -1;
+    int outside = -1;
+
+    for(ic = 0; ic < 3; ic++)
     {
-      if(dp < minProj) // track edge most orthogonal to point direction
+      i = (ir + ic) % 3;
+      i2 = (i + 1) % 3;
+      i3 = (i + 2) % 3;
+
+      if((pts[i] == fromEdge[0] && pts[i2] == fromEdge[1]) || (pts[i] == fromEdge[1] && pts[i2] == fromEdge[0]))
       {
-        inside = 0;
-        nei[1] = pts[i];
-        nei[2] = pts[i2];
-        minProj = dp;
+        continue;
       }
-    } // outside this edge
-  }   // for each edge
 
-  if(inside) // all edges have tested positive
-  {
-    nei[0] = (-1);
-    return tri;
-  }
+      // create a 2D edge normal to define a "half-space"; evaluate points (i.e.,
+      // candidate point and other triangle vertex not on this edge).
+      n[0] = -(p[i2][1] - p[i][1]);
+      n[1] = p[i2][0] - p[i][0];
+      Normalize2x1(n);
 
-  else if(!inside && (fabs(minProj) < del2D_tolerance)) // on edge
-  {
-    nei[0] = m_Delaunay->getTriangleEdgeNeighbor(nei[1], nei[2], tri);
-    return tri;
-  }
+      // compute local vectors
+      for(j = 0; j < 2; j++)
+      {
+        vp[j] = p[i3][j] - p[i][j];
+        vx[j] = x[j] - p[i][j];
+      }
+      Normalize2x1(vp);
+      Normalize2x1(vx);
 
-  else // walk towards point
-  {
-    newNei = m_Delaunay->getTriangleEdgeNeighbor(nei[1], nei[2], tri);
-    if(newNei == nei[0])
+      // see if two points are in opposite half spaces
+      dp = Dot2D(n, vx) * (Dot2D(n, vp) < 0 ? -1.0 : 1.0);
+      if(dp <= -del2D_tolerance)
+      {
+        outside = i;
+        break;
+      }
+      if(dp < del2D_tolerance)
+      {
+        onEdge = i;
+      }
+    } // for each edge
+
+    if(outside < 0 && onEdge < 0) // all edges have tested positive
+    {
+      nei[0] = (-1);
+      return tri;
+    }
+
+    if(outside < 0) // on edge
     {
-      m_NumDegeneracies++;
-      return -1;
+      nei[1] = pts[onEdge];
+      nei[2] = pts[(onEdge + 1) % 3];
+      nei[0] = m_Delaunay->getTriangleEdgeNeighbor(nei[1], nei[2], tri);
+      return tri;
     }
-    else
+
+    // walk towards point
+    nei[1] = pts[outside];
+    nei[2] = pts[(outside + 1) % 3];
+    newNei = m_Delaunay->getTriangleEdgeNeighbor(nei[1], nei[2], tri);
+    if(newNei < 0)
     {
-      nei[0] = tri;
-      return findTriangle(x, newNei, tol, nei, pts);
+      break;
     }
+    nei[0] = tri;
+    fromEdge[0] = nei[1];
+    fromEdge[1] = nei[2];
+    tri = newNei;
   }
+
+  m_NumDegeneracies++;
+  return -1;
 }
 
 // -----------------------------------------------------------------------------
@@ -550,13 +643,10 @@ void Delaunay2D::checkEdge(int64_t point, double x[3], int64_t p1, int64_t p2, i
     // see whether point is in circumcircle
     if(inCircumcircle(x3, x, x1, x2))
     { // swap diagonal
-      m_Delaunay->removeLinkFromTriangle(p1, tri);
-      m_Delaunay->removeLinkFromTriangle(p2, neighbor);
-      m_Delaunay->addLinkToTriangle(point, neighbor);
-      m_Delaunay->addLinkToTriangle(oppositeVert, tri);
-
       m_Delaunay->replaceTriangleVertices(point, oppositeVert, p2, tri);
       m_Delaunay->replaceTriangleVertices(point, p1, oppositeVert, neighbor);
+      int64_t flipped[2] = {tri, neighbor};
+      m_Delaunay->relinkTriangles(flipped, 2);
 
       if(recursive)
       {
@@ -571,10 +661,11 @@ void Delaunay2D::checkEdge(int64_t point, double x[3], int64_t p1, int64_t p2, i
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void Delaunay2D::findPointBounds(TriMesh::VertexCoordList& vertices)
+void Delaunay2D::findPointBounds(const TriMesh::VertexCoordList& vertices)
 {
-  for(auto&& vert : vertices)
+  for(size_t v = 0; v < vertices.size(); v++)
   {
+    const float vert[3] = {vertices.x[v], vertices.y[v], vertices.z[v]};
     if(vert[0] < m_PointBounds[0])
     {
       m_PointBounds[0] = static_cast<double>(vert[0]);
@@ -605,7 +696,7 @@ void Delaunay2D::findPointBounds(TriMesh::VertexCoordList& vertices)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void Delaunay2D::fixupBoundaryTriangles(int64_t numVerts, TriMesh::VertexCoordList& points, std::vector<int64_t>& triUse)
+void Delaunay2D::fixupBoundaryTriangles(int64_t numVerts, std::vector<int64_t>& triUse)
 {
   bool isConnected;
   int64_t numSwaps = 0;
@@ -618,12 +709,13 @@ void Delaunay2D::fixupBoundaryTriangles(int64_t numVerts, TriMesh::VertexCoordLi
   int64_t swapPts[3];
   double n1[3];
   double n2[3];
+  std::vector<int64_t> neighbors;
 
   for(int64_t ptId = 0; ptId < numVerts; ptId++)
   {
     // check if point is only connected to triangles scheduled for
     // removal
-    std::vector<int64_t> neighbors = m_Delaunay->getTrianglesToVertex(ptId);
+    m_Delaunay->getTrianglesToVertex(ptId, neighbors);
     auto ncells = neighbors.size();
 
     isConnected = false;
@@ -683,6 +775,10 @@ void Delaunay2D::fixupBoundaryTriangles(int64_t numVerts, TriMesh::VertexCoordLi
       }
 
       int64_t tri2 = m_Delaunay->getTriangleEdgeNeighbor(p1, p2, tri1);
+      if(tri2 < 0)
+      {
+        continue;
+      }
 
       // get the 3 points of the neighbor triangle
       m_Delaunay->getTriangleVertices(tri2, neiPts);
@@ -725,13 +821,10 @@ void Delaunay2D::fixupBoundaryTriangles(int64_t numVerts, TriMesh::VertexCoordLi
       // swap edge [p1 p2] and diagonal [ptId p3]
 
       // it's ok to swap the diagonal
-      m_Delaunay->removeLinkFromTriangle(p1, tri2);
-      m_Delaunay->removeLinkFromTriangle(p2, tri1);
-      m_Delaunay->addLinkToTriangle(ptId, tri2);
-      m_Delaunay->addLinkToTriangle(p3, tri1);
-
       m_Delaunay->replaceTriangleVertices(pts[0], pts[1], pts[2], tri1);
       m_Delaunay->replaceTriangleVertices(swapPts[0], swapPts[1], swapPts[2], tri2);
+      int64_t swapped[2] = {tri1, tri2};
+      m_Delaunay->relinkTriangles(swapped, 2);
 
       triUse[tri1] = (p1 < numVerts && p3 < numVerts);
       triUse[tri2] = (p3 < numVerts && p2 < numVerts);
@@ -900,8 +993,9 @@ Eigen::Transform<double, 3, Eigen::Affine> Delaunay2D::findProjectionPlane()
 
   const double tolerance = 1.0e-03;
 
-  for(auto&& vert : m_Vertices)
+  for(size_t i = 0; i < numVertices; i++)
   {
+    const double vert[3] = {m_Vertices.x[i], m_Vertices.y[i], m_Vertices.z[i]};
     v[0] += vert[0] * vert[2];
     v[1] += vert[1] * vert[2];
     v[2] += vert[2];
@@ -975,7 +1069,7 @@ void Delaunay2D::setVertices(const TriMesh::VertexCoordList& value)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-TriMesh::VertexCoordList Delaunay2D::getVertices() const
+const TriMesh::VertexCoordList& Delaunay2D::getVertices() const
 {
   return m_Vertices;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <random>
+
 #include <Eigen/Geometry>
 
 #include "SIMPLib/Geometry/TriangleGeom.h"
@@ -23,7 +25,7 @@ public:
 
   static Pointer New(TriMesh::VertexCoordList vertices, double offset, double tolerance, double alpha, Observable* observable = nullptr)
   {
-    Pointer sharedPtr(new Delaunay2D(vertices, offset, tolerance, alpha, observable));
+    Pointer sharedPtr(new Delaunay2D(std::move(vertices), offset, tolerance, alpha, observable));
     return sharedPtr;
   }
 
@@ -36,7 +38,7 @@ public:
    * @brief Getter property for Vertices
    * @return Value of Vertices
    */
-  TriMesh::VertexCoordList getVertices() const;
+  const TriMesh::VertexCoordList& getVertices() const;
 
   /**
    * @brief Setter property for Offset
@@ -122,6 +124,7 @@ private:
   TriMesh::Pointer m_Delaunay;
   size_t m_NumDuplicatePoints;
   size_t m_NumDegeneracies;
+  std::minstd_rand m_WalkGenerator;
 
   void initialize();
 
@@ -129,9 +132,9 @@ private:
 
   void checkEdge(int64_t point, double x[3], int64_t p1, int64_t p2, int64_t tri, bool recursive);
 
-  void findPointBounds(TriMesh::VertexCoordList& vertices);
+  void findPointBounds(const TriMesh::VertexCoordList& vertices);
 
-  void fixupBoundaryTriangles(int64_t numVerts, TriMesh::VertexCoordList& points, std::vector<int64_t>& triUse);
+  void fixupBoundaryTriangles(int64_t numVerts, std::vector<int64_t>& triUse);
 
   double circumcircle(double a[2], double b[2], double c[2], double center[2]);
 
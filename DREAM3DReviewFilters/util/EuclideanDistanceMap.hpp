@@ -0,0 +1,180 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+/**
+ * @brief The EuclideanDistanceMap class computes the exact Euclidean distance, in physical units, from every voxel of
+ * an ImageGeom to the nearest seed voxel. Seeds are the voxels that belong to a Feature and hold a distance of 0 on
+ * input. On output voxels of no Feature (Id <= 0) hold 0 and voxels that no seed reaches hold -1. The squared
+ * distances are separable, so they are found with one lower envelope of parabolas pass per axis (Felzenszwalb and
+ * Huttenlocher), each threaded over the lines along that axis.
+ */
+class EuclideanDistanceMap
+{
+public:
+  EuclideanDistanceMap(ImageGeom::Pointer image, const int32_t* featureIds, float* distances)
+  : m_Image(std::move(image))
+  , m_FeatureIds(featureIds)
+  , m_Distances(distances)
+  {
+  }
+
+  ~EuclideanDistanceMap() = default;
+
+  void operator()() const
+  {
+    SizeVec3Type udims = m_Image->getDimensions();
+    FloatVec3Type spacing = m_Image->getSpacing();
+    size_t totalPoints = m_Image->getNumberOfElements();
+
+    const double infinity = std::numeric_limits<double>::infinity();
+    std::vector<double> squaredDistances(totalPoints, infinity);
+    for(size_t a = 0; a < totalPoints; ++a)
+    {
+      if(m_FeatureIds[a] > 0 && m_Distances[a] == 0.0f)
+      {
+        squaredDistances[a] = 0.0;
+      }
+    }
+
+    // Lines along x, y and z, given as the stride between the voxels of a line and the number of lines
+    std::array<size_t, 3> strides = {1, udims[0], udims[0] * udims[1]};
+    for(size_t axis = 0; axis < 3; axis++)
+    {
+      size_t numLines = totalPoints / udims[axis];
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, numLines);
+      dataAlg.execute([&](const SIMPLRange& range) {
+        LineTransform transform(udims[axis], static_cast<double>(spacing[axis]));
+        for(size_t line = range.min(); line < range.max(); line++)
+        {
+          // Offset of the first voxel of the line: lines along y and z start at every voxel of the planes below them
+          size_t first = 0;
+          if(axis == 0)
+          {
+            first = line * udims[0];
+          }
+          else if(axis == 1)
+          {
+            first = (line / udims[0]) * strides[2] + line % udims[0];
+          }
+          else
+          {
+            first = line;
+          }
+          transform(squaredDistances.data() + first, strides[axis]);
+        }
+      });
+    }
+
+    for(size_t a = 0; a < totalPoints; ++a)
+    {
+      if(m_FeatureIds[a] <= 0)
+      {
+        m_Distances[a] = 0.0f;
+      }
+      else if(squaredDistances[a] == infinity)
+      {
+        m_Distances[a] = -1.0f;
+      }
+      else
+      {
+        m_Distances[a] = static_cast<float>(std::sqrt(squaredDistances[a]));
+      }
+    }
+  }
+
+private:
+  /**
+   * @brief The LineTransform class replaces the squared distances f along one line by min over q of
+   * ((p - q) * spacing)^2 + f(q), from the lower envelope of the parabolas rooted at the reached voxels
+   */
+  class LineTransform
+  {
+  public:
+    LineTransform(size_t numPoints, double spacing)
+    : m_Spacing(spacing)
+    , m_Values(numPoints)
+    , m_Roots(numPoints)
+    , m_Bounds(numPoints + 1)
+    {
+    }
+
+    void operator()(double* line, size_t stride)
+    {
+      size_t numPoints = m_Values.size();
+      for(size_t p = 0; p < numPoints; p++)
+      {
+        m_Values[p] = line[p * stride];
+      }
+
+      // m_Roots[0..k] are the parabolas of the envelope, parabola j being lowest between m_Bounds[j] and m_Bounds[j + 1]
+      const double infinity = std::numeric_limits<double>::infinity();
+      int64_t k = -1;
+      for(size_t q = 0; q < numPoints; q++)
+      {
+        if(m_Values[q] == infinity)
+        {
+          continue;
+        }
+        double position = static_cast<double>(q) * m_Spacing;
+        double bound = -infinity;
+        while(k >= 0)
+        {
+          double root = static_cast<double>(m_Roots[k]) * m_Spacing;
+          bound = ((m_Values[q] + position * position) - (m_Values[m_Roots[k]] + root * root)) / (2.0 * (position - root));
+          if(bound > m_Bounds[k])
+          {
+            break;
+          }
+          k--;
+        }
+        if(k < 0)
+        {
+          bound = -infinity;
+        }
+        k++;
+        m_Roots[k] = q;
+        m_Bounds[k] = bound;
+        m_Bounds[k + 1] = infinity;
+      }
+      if(k < 0)
+      {
+        return;
+      }
+
+      size_t j = 0;
+      for(size_t p = 0; p < numPoints; p++)
+      {
+        double position = static_cast<double>(p) * m_Spacing;
+        while(m_Bounds[j + 1] < position)
+        {
+          j++;
+        }
+        double offset = position - static_cast<double>(m_Roots[j]) * m_Spacing;
+        line[p * stride] = offset * offset + m_Values[m_Roots[j]];
+      }
+    }
+
+  private:
+    double m_Spacing;
+    std::vector<double> m_Values;
+    std::vector<size_t> m_Roots;
+    std::vector<double> m_Bounds;
+  };
+
+  ImageGeom::Pointer m_Image;
+  const int32_t* m_FeatureIds;
+  float* m_Distances;
+};
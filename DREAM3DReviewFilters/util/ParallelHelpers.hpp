@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_sort.h>
+#endif
+
+/**
+ * @brief The ParallelHelpers namespace collects small data-parallel building blocks (sorting and
+ * prefix sums) that several filters use to replace hash based bookkeeping with dense index arrays.
+ * Each helper falls back to a serial implementation when SIMPL is built without TBB.
+ */
+namespace ParallelHelpers
+{
+// -----------------------------------------------------------------------------
+template <typename RandomIt, typename Compare>
+void sort(RandomIt first, RandomIt last, Compare comp)
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_sort(first, last, comp);
+#else
+  std::sort(first, last, comp);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+template <typename RandomIt>
+void sort(RandomIt first, RandomIt last)
+{
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_sort(first, last);
+#else
+  std::sort(first, last);
+#endif
+}
+
+/**
+ * @brief exclusiveScan Replaces values[i] with the sum of values[0, i) and returns the total. The
+ * scan is computed block-wise: per-block sums in parallel, a short serial scan over the block sums,
+ * then a parallel pass that rebases every block.
+ * @param values
+ * @param count
+ * @return Sum of all input values
+ */
+template <typename T>
+T exclusiveScan(T* values, size_t count)
+{
+  if(count == 0)
+  {
+    return T(0);
+  }
+
+  const size_t blockSize = 1 << 16;
+  const size_t numBlocks = (count + blockSize - 1) / blockSize;
+  std::vector<T> blockSums(numBlocks, T(0));
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numBlocks);
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t b = range.min(); b < range.max(); b++)
+    {
+      const size_t end = std::min(count, (b + 1) * blockSize);
+      T sum = T(0);
+      for(size_t i = b * blockSize; i < end; i++)
+      {
+        T value = values[i];
+        values[i] = sum;
+        sum += value;
+      }
+      blockSums[b] = sum;
+    }
+  });
+
+  T total = T(0);
+  for(size_t b = 0; b < numBlocks; b++)
+  {
+    T value = blockSums[b];
+    blockSums[b] = total;
+    total += value;
+  }
+
+  dataAlg.execute([&](const SIMPLRange& range) {
+    for(size_t b = range.min(); b < range.max(); b++)
+    {
+      const T offset = blockSums[b];
+      if(offset == T(0))
+      {
+        continue;
+      }
+      const size_t end = std::min(count, (b + 1) * blockSize);
+      for(size_t i = b * blockSize; i < end; i++)
+      {
+        values[i] += offset;
+      }
+    }
+  });
+
+  return total;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+T exclusiveScan(std::vector<T>& values)
+{
+  return exclusiveScan(values.data(), values.size());
+}
+} // namespace ParallelHelpers
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The QuantileSketch class summarises a stream of values in a KLL sketch (Karnin, Lang and Liberty) so that
+ * quantiles can be estimated without keeping the values. Level h holds values that each stand for 2^h inputs; a
+ * full level is sorted and every other value is promoted to the next level. With a size parameter k the sketch keeps
+ * about 3k values and the rank error of a quantile is around 1.7/k of the number of values. Sketches of separate parts
+ * of a stream can be merged. Compactions alternate between keeping the even and the odd positions instead of flipping
+ * a coin, so the result only depends on the order of the values and merges.
+ */
+class QuantileSketch
+{
+public:
+  explicit QuantileSketch(size_t k)
+  : m_K(std::max(k, static_cast<size_t>(8)))
+  {
+    addLevel();
+  }
+
+  /**
+   * @brief add Adds one value to the sketch
+   * @param value
+   */
+  void add(double value)
+  {
+    m_Levels[0].push_back(value);
+    m_Count++;
+    m_Size++;
+    if(m_Size >= m_Capacity)
+    {
+      compress();
+    }
+  }
+
+  /**
+   * @brief merge Adds all values summarised by another sketch to this one
+   * @param other
+   */
+  void merge(const QuantileSketch& other)
+  {
+    while(m_Levels.size() < other.m_Levels.size())
+    {
+      addLevel();
+    }
+    for(size_t level = 0; level < other.m_Levels.size(); level++)
+    {
+      appendLevel(level, other.m_Levels[level].begin(), other.m_Levels[level].end());
+    }
+    m_Count += other.m_Count;
+    while(m_Size >= m_Capacity)
+    {
+      compress();
+    }
+  }
+
+  /**
+   * @brief count
+   * @return Number of values added to the sketch, including those of merged sketches
+   */
+  size_t count() const
+  {
+    return m_Count;
+  }
+
+  /**
+   * @brief quantile Estimates the q quantile (0 <= q <= 1) by linear interpolation between the values of the two
+   * closest ranks; exact as long as no level has been compacted. Returns 0 for an empty sketch.
+   * @param q
+   * @return
+   */
+  double quantile(double q) const
+  {
+    if(m_Count == 0)
+    {
+      return 0.0;
+    }
+    std::vector<std::pair<double, size_t>> weighted;
+    weighted.reserve(m_Size);
+    for(size_t level = 0; level < m_Levels.size(); level++)
+    {
+      for(double value : m_Levels[level])
+      {
+        weighted.emplace_back(value, static_cast<size_t>(1) << level);
+      }
+    }
+    std::sort(weighted.begin(), weighted.end());
+
+    double position = std::min(std::max(q, 0.0), 1.0) * static_cast<double>(m_Count - 1);
+    size_t lowerRank = static_cast<size_t>(std::floor(position));
+    size_t upperRank = std::min(lowerRank + 1, m_Count - 1);
+    double lower = valueAtRank(weighted, lowerRank);
+    double upper = valueAtRank(weighted, upperRank);
+    return lower + (upper - lower) * (position - static_cast<double>(lowerRank));
+  }
+
+private:
+  static constexpr size_t k_MinLevelCapacity = 8;
+
+  size_t m_K;
+  size_t m_Count = 0;
+  size_t m_Size = 0;
+  size_t m_Capacity = 0;
+  std::vector<std::vector<double>> m_Levels;
+  std::vector<size_t> m_LevelCapacities;
+  std::vector<size_t> m_Compactions;
+  std::vector<double> m_Promoted;
+
+  // Every weighted value covers the next 'weight' ranks; the total weight of the sketch equals m_Count
+  static double valueAtRank(const std::vector<std::pair<double, size_t>>& weighted, size_t rank)
+  {
+    size_t covered = 0;
+    for(const auto& entry : weighted)
+    {
+      covered += entry.second;
+      if(covered > rank)
+      {
+        return entry.first;
+      }
+    }
+    return weighted.back().first;
+  }
+
+  // Levels above the first are kept sorted, so their compaction only has to merge
+  template <typename Iterator>
+  void appendLevel(size_t level, Iterator begin, Iterator end)
+  {
+    std::vector<double>& values = m_Levels[level];
+    size_t middle = values.size();
+    values.insert(values.end(), begin, end);
+    m_Size += values.size() - middle;
+    if(level > 0)
+    {
+      std::inplace_merge(values.begin(), values.begin() + middle, values.end());
+    }
+  }
+
+  // Levels further below the top get geometrically smaller, down to k_MinLevelCapacity values
+  void addLevel()
+  {
+    m_Levels.emplace_back();
+    m_Compactions.push_back(0);
+    m_LevelCapacities.resize(m_Levels.size());
+    m_Capacity = 0;
+    for(size_t level = 0; level < m_Levels.size(); level++)
+    {
+      size_t depth = m_Levels.size() - 1 - level;
+      double capacity = std::ceil(static_cast<double>(m_K) * std::pow(2.0 / 3.0, static_cast<double>(depth)));
+      m_LevelCapacities[level] = std::max(k_MinLevelCapacity, static_cast<size_t>(capacity));
+      m_Capacity += m_LevelCapacities[level];
+    }
+  }
+
+  // Compacts the lowest level that is full
+  void compress()
+  {
+    for(size_t level = 0; level < m_Levels.size(); level++)
+    {
+      std::vector<double>& values = m_Levels[level];
+      if(values.size() < m_LevelCapacities[level])
+      {
+        continue;
+      }
+      if(level + 1 == m_Levels.size())
+      {
+        addLevel();
+      }
+      std::vector<double>& current = m_Levels[level];
+      if(level == 0)
+      {
+        std::sort(current.begin(), current.end());
+      }
+      // An odd value out stays behind, so only pairs are compacted
+      size_t begin = current.size() % 2;
+      size_t offset = m_Compactions[level]++ % 2;
+      m_Promoted.clear();
+      for(size_t i = begin + offset; i < current.size(); i += 2)
+      {
+        m_Promoted.push_back(current[i]);
+      }
+      m_Size -= current.size() - begin;
+      current.resize(begin);
+      appendLevel(level + 1, m_Promoted.begin(), m_Promoted.end());
+      return;
+    }
+  }
+};
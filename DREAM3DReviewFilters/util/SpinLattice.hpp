@@ -0,0 +1,616 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "SIMPLib/Common/SIMPLRange.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/util/CounterRng.hpp"
+
+/**
+ * @brief The SpinLattice class runs the Monte Carlo sweeps of the Potts model on the Feature Ids of an ImageGeom.
+ * Spins are updated in place; sites with a Feature Id of 0 or a false mask value never flip. Every flip trial draws
+ * from a CounterRng keyed by the seed, the sweep and the site, so a given seed produces the same spins for any
+ * thread count and in both the full and the kinetic (boundary sites only) mode.
+ */
+class SpinLattice
+{
+public:
+  static constexpr double k_Boltzmann = 1.38064852e-23;
+  static constexpr size_t k_MaxNeighbors = 26;
+
+  using Neighborhood = std::array<std::array<int8_t, 3>, k_MaxNeighbors>;
+  using NeighborList = std::array<size_t, k_MaxNeighbors>;
+
+  enum class Dimension : uint8_t
+  {
+    Two,
+    Three
+  };
+
+  SpinLattice(ImageGeom::Pointer image, double temperature, bool periodic, bool kinetic, int32_t* fIds, bool* mask, uint64_t seed)
+  : image_(std::move(image))
+  , temperature_(temperature)
+  , periodic_(periodic)
+  , kinetic_(kinetic)
+  , fIds_(fIds)
+  , mask_(mask)
+  , seed_(seed)
+  {
+    initialize();
+  }
+
+  virtual ~SpinLattice() = default;
+
+  /**
+   * @brief sweep Performs one Monte Carlo step: one flip attempt on every active site. Sites are visited in
+   * checkerboard color classes chosen so that no two sites of the same class are neighbors; all sites of a
+   * class can therefore be updated in parallel without changing each other's energies. In kinetic mode only
+   * the boundary sites of each class are visited; every other site would reject the flip anyway, so both modes
+   * produce the same result.
+   * @return Number of accepted flips
+   */
+  size_t sweep()
+  {
+    std::atomic<size_t> flips(0);
+    const uint64_t sweepKey = CounterRng::mix(seed_ + CounterRng::mix(sweep_++));
+    size_t color = 0;
+    for(const std::vector<size_t>& zs : classes_[2])
+    {
+      for(const std::vector<size_t>& ys : classes_[1])
+      {
+        for(const std::vector<size_t>& xs : classes_[0])
+        {
+          if(kinetic_)
+          {
+            flips += sweep_boundary_sites(color++, sweepKey);
+            continue;
+          }
+          if(zs.empty() || ys.empty() || xs.empty())
+          {
+            continue;
+          }
+          ParallelDataAlgorithm dataAlg;
+          dataAlg.setRange(0, ys.size() * zs.size());
+          dataAlg.execute([&](const SIMPLRange& range) {
+            size_t localFlips = 0;
+            for(size_t row = range.min(); row < range.max(); row++)
+            {
+              size_t y = ys[row % ys.size()];
+              size_t z = zs[row / ys.size()];
+              size_t rowStart = (z * dims_[1] + y) * dims_[0];
+              for(size_t x : xs)
+              {
+                size_t index = rowStart + x;
+                if(fIds_[index] == 0 || (mask_ != nullptr && !mask_[index]))
+                {
+                  continue;
+                }
+                CounterRng rng(sweepKey ^ CounterRng::mix(index));
+                if(attempt_flip(index, x, y, z, rng))
+                {
+                  localFlips++;
+                }
+              }
+            }
+            flips += localFlips;
+          });
+        }
+      }
+    }
+    total_flips_ += flips;
+    return flips;
+  }
+
+  bool attempt_flip(size_t index, size_t x, size_t y, size_t z, CounterRng& rng) const
+  {
+    int32_t spin = fIds_[index];
+    NeighborList neighbors;
+    size_t numNeighbors = valid_neighbor_query(index, x, y, z, neighbors);
+
+    size_t same = 0;
+    for(size_t i = 0; i < numNeighbors; i++)
+    {
+      if(fIds_[neighbors[i]] == spin)
+      {
+        same++;
+      }
+    }
+
+    if(same == numNeighbors)
+    {
+      return false;
+    }
+
+    int32_t candidate = fIds_[neighbors[rng.uniformIndex(numNeighbors)]];
+
+    if(candidate == 0 || candidate == spin)
+    {
+      return false;
+    }
+
+    // Half the change in the number of unlike neighbors
+    size_t sameCandidate = 0;
+    for(size_t i = 0; i < numNeighbors; i++)
+    {
+      if(fIds_[neighbors[i]] == candidate)
+      {
+        sameCandidate++;
+      }
+    }
+    double dE = 0.5 * (static_cast<double>(same) - static_cast<double>(sameCandidate));
+    if(dE <= 0.0 || rng.uniformReal() < std::exp(-dE / kT_))
+    {
+      fIds_[index] = candidate;
+      return true;
+    }
+    return false;
+  }
+
+  size_t total_flips()
+  {
+    return total_flips_;
+  }
+
+  /**
+   * @brief sweep_boundary_sites Attempts a flip on every boundary site of one color. Accepted flips update the
+   * cached unlike neighbor counts of the neighbors, and neighbors that just became boundary sites are queued
+   * on the list of their own color. Sites of the swept color that are no longer on a boundary are dropped from
+   * its list afterwards.
+   * @return Number of accepted flips
+   */
+  size_t sweep_boundary_sites(size_t color, uint64_t sweepKey)
+  {
+    std::vector<size_t>& sites = boundary_sites_[color];
+    std::atomic<size_t> flips(0);
+    std::vector<size_t> newSites;
+    std::mutex newSitesMutex;
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, sites.size());
+    dataAlg.execute([&](const SIMPLRange& range) {
+      size_t localFlips = 0;
+      std::vector<size_t> localNewSites;
+      for(size_t i = range.min(); i < range.max(); i++)
+      {
+        size_t index = sites[i];
+        if(unlike_[index].load(std::memory_order_relaxed) == 0)
+        {
+          continue;
+        }
+        CounterRng rng(sweepKey ^ CounterRng::mix(index));
+        if(attempt_boundary_flip(index, rng, localNewSites))
+        {
+          localFlips++;
+        }
+      }
+      flips += localFlips;
+      if(!localNewSites.empty())
+      {
+        std::lock_guard<std::mutex> lock(newSitesMutex);
+        newSites.insert(newSites.end(), localNewSites.begin(), localNewSites.end());
+      }
+    });
+
+    // Sites of this color cannot change while other colors are swept, so interior sites can be dropped now
+    auto interior = [this](size_t index) {
+      if(unlike_[index].load(std::memory_order_relaxed) != 0)
+      {
+        return false;
+      }
+      queued_[index].store(0, std::memory_order_relaxed);
+      return true;
+    };
+    sites.erase(std::remove_if(sites.begin(), sites.end(), interior), sites.end());
+
+    for(size_t index : newSites)
+    {
+      boundary_sites_[site_color(index)].push_back(index);
+    }
+    return flips;
+  }
+
+  Dimension dimension()
+  {
+    return dim_type_;
+  }
+
+  /**
+   * @brief unlike_count Kinetic mode only
+   * @param index
+   * @return Cached number of neighbors of the site whose spin differs from its own
+   */
+  size_t unlike_count(size_t index) const
+  {
+    return unlike_[index].load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief queued Kinetic mode only
+   * @param index
+   * @return Whether the site is on the boundary site list of its color
+   */
+  bool queued(size_t index) const
+  {
+    return queued_[index].load(std::memory_order_relaxed) != 0;
+  }
+
+private:
+  /**
+   * @brief attempt_boundary_flip Same trial as attempt_flip, but the like neighbor count of the current spin
+   * comes from the cached unlike neighbor count, which is kept up to date for every neighbor on acceptance
+   */
+  bool attempt_boundary_flip(size_t index, CounterRng& rng, std::vector<size_t>& newSites)
+  {
+    size_t x = index % dims_[0];
+    size_t y = (index / dims_[0]) % dims_[1];
+    size_t z = index / (dims_[0] * dims_[1]);
+    int32_t spin = fIds_[index];
+    NeighborList neighbors;
+    size_t numNeighbors = valid_neighbor_query(index, x, y, z, neighbors);
+    size_t same = numNeighbors - unlike_[index].load(std::memory_order_relaxed);
+
+    int32_t candidate = fIds_[neighbors[rng.uniformIndex(numNeighbors)]];
+
+    if(candidate == 0 || candidate == spin)
+    {
+      return false;
+    }
+
+    size_t sameCandidate = 0;
+    for(size_t i = 0; i < numNeighbors; i++)
+    {
+      if(fIds_[neighbors[i]] == candidate)
+      {
+        sameCandidate++;
+      }
+    }
+    double dE = 0.5 * (static_cast<double>(same) - static_cast<double>(sameCandidate));
+    if(dE > 0.0 && rng.uniformReal() >= std::exp(-dE / kT_))
+    {
+      return false;
+    }
+
+    fIds_[index] = candidate;
+    unlike_[index].store(static_cast<uint8_t>(numNeighbors - sameCandidate), std::memory_order_relaxed);
+    for(size_t i = 0; i < numNeighbors; i++)
+    {
+      size_t neigh = neighbors[i];
+      int32_t n = fIds_[neigh];
+      if(n == 0)
+      {
+        continue;
+      }
+      if(n == spin)
+      {
+        // The neighbor gained an unlike neighbor; queue it if it was not on a boundary before
+        if(unlike_[neigh].fetch_add(1, std::memory_order_relaxed) == 0 && queued_[neigh].exchange(1, std::memory_order_relaxed) == 0)
+        {
+          newSites.push_back(neigh);
+        }
+      }
+      else if(n == candidate)
+      {
+        unlike_[neigh].fetch_sub(1, std::memory_order_relaxed);
+      }
+    }
+    return true;
+  }
+
+  size_t site_color(size_t index) const
+  {
+    size_t x = index % dims_[0];
+    size_t y = (index / dims_[0]) % dims_[1];
+    size_t z = index / (dims_[0] * dims_[1]);
+    return site_class_[0][x] + classes_[0].size() * (site_class_[1][y] + classes_[1].size() * site_class_[2][z]);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Counts the unlike neighbors of every active site and queues the boundary sites by color
+  void initialize_boundary_sites()
+  {
+    size_t numSites = dims_[0] * dims_[1] * dims_[2];
+    unlike_ = std::vector<std::atomic<uint8_t>>(numSites);
+    queued_ = std::vector<std::atomic<uint8_t>>(numSites);
+    boundary_sites_.assign(classes_[0].size() * classes_[1].size() * classes_[2].size(), {});
+
+    std::vector<size_t> sites;
+    std::mutex sitesMutex;
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, dims_[1] * dims_[2]);
+    dataAlg.execute([&](const SIMPLRange& range) {
+      std::vector<size_t> localSites;
+      NeighborList neighbors;
+      for(size_t row = range.min(); row < range.max(); row++)
+      {
+        size_t y = row % dims_[1];
+        size_t z = row / dims_[1];
+        for(size_t x = 0; x < dims_[0]; x++)
+        {
+          size_t index = row * dims_[0] + x;
+          unlike_[index].store(0, std::memory_order_relaxed);
+          queued_[index].store(0, std::memory_order_relaxed);
+          int32_t spin = fIds_[index];
+          if(spin == 0 || (mask_ != nullptr && !mask_[index]))
+          {
+            continue;
+          }
+          size_t numNeighbors = valid_neighbor_query(index, x, y, z, neighbors);
+          uint8_t unlike = 0;
+          for(size_t i = 0; i < numNeighbors; i++)
+          {
+            if(fIds_[neighbors[i]] != spin)
+            {
+              unlike++;
+            }
+          }
+          unlike_[index].store(unlike, std::memory_order_relaxed);
+          if(unlike > 0)
+          {
+            queued_[index].store(1, std::memory_order_relaxed);
+            localSites.push_back(index);
+          }
+        }
+      }
+      std::lock_guard<std::mutex> lock(sitesMutex);
+      sites.insert(sites.end(), localSites.begin(), localSites.end());
+    });
+
+    for(size_t index : sites)
+    {
+      boundary_sites_[site_color(index)].push_back(index);
+    }
+  }
+
+  size_t valid_neighbor_query(size_t index, size_t x, size_t y, size_t z, NeighborList& neighbors) const
+  {
+    size_t count = 0;
+
+    // Sites away from the faces of the volume use the precomputed linear offsets
+    bool interior = x > 0 && x + 1 < dims_[0] && y > 0 && y + 1 < dims_[1] && (dim_type_ == Dimension::Two || (z > 0 && z + 1 < dims_[2]));
+    if(interior)
+    {
+      for(size_t i = 0; i < neighborhood_size_; i++)
+      {
+        size_t neigh = static_cast<size_t>(static_cast<int64_t>(index) + neighbor_offsets_[i]);
+        if(mask_ == nullptr || mask_[neigh])
+        {
+          neighbors[count++] = neigh;
+        }
+      }
+      return count;
+    }
+
+    for(size_t i = 0; i < neighborhood_size_; i++)
+    {
+      const std::array<int8_t, 3>& neighbor = neighborhood_[i];
+      size_t neigh = 0;
+      if(periodic_)
+      {
+        size_t modx = apply_modular_operation(x, neighbor[0], dims_[0]);
+        size_t mody = apply_modular_operation(y, neighbor[1], dims_[1]);
+        size_t modz = apply_modular_operation(z, neighbor[2], dims_[2]);
+        neigh = neighbor_index(modx, mody, modz);
+      }
+      else
+      {
+        int64_t modx = static_cast<int64_t>(x) + neighbor[0];
+        int64_t mody = static_cast<int64_t>(y) + neighbor[1];
+        int64_t modz = static_cast<int64_t>(z) + neighbor[2];
+        if(modx < 0 || modx >= static_cast<int64_t>(dims_[0]) || mody < 0 || mody >= static_cast<int64_t>(dims_[1]) || modz < 0 || modz >= static_cast<int64_t>(dims_[2]))
+        {
+          continue;
+        }
+        neigh = neighbor_index(modx, mody, modz);
+      }
+      if(mask_ == nullptr || mask_[neigh])
+      {
+        neighbors[count++] = neigh;
+      }
+    }
+    return count;
+  }
+
+  size_t modular_subtraction(size_t a, size_t b, size_t m) const
+  {
+    if(a >= b)
+    {
+      return a - b;
+    }
+
+    return m - b + a;
+  }
+
+  size_t modular_addition(size_t a, size_t b, size_t m) const
+  {
+    if(b == 0)
+    {
+      return a;
+    }
+    b = m - b;
+    if(a >= b)
+    {
+      return a - b;
+    }
+
+    return m - b + a;
+  }
+
+  size_t apply_modular_operation(size_t a, int8_t b, size_t m) const
+  {
+    if(b < 0)
+    {
+      b *= -1;
+      // size_t c = static_cast<size_t>(b);
+      return modular_subtraction(a, b, m);
+    }
+
+    return modular_addition(a, b, m);
+  }
+
+  template <typename T>
+  size_t neighbor_index(T x, T y, T z) const
+  {
+    size_t neigh = 0;
+    switch(dim_type_)
+    {
+    case Dimension::Two: {
+      neigh = (y * dims_[0]) + (x);
+      break;
+    }
+    case Dimension::Three: {
+      neigh = (z * dims_[1] * dims_[0]) + (y * dims_[0]) + (x);
+      break;
+    }
+    default: {
+      break;
+    }
+    }
+    return neigh;
+  }
+
+  // -----------------------------------------------------------------------------
+  void initialize()
+  {
+    determine_dimensionality();
+    generate_neighborhood();
+    generate_color_classes();
+    if(kinetic_)
+    {
+      initialize_boundary_sites();
+    }
+    kT_ = k_Boltzmann * temperature_;
+    total_flips_ = 0;
+    sweep_ = 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  void determine_dimensionality()
+  {
+    SizeVec3Type dims = image_->getDimensions();
+    dims_[0] = dims[0];
+    dims_[1] = dims[1];
+    dims_[2] = dims[2];
+
+    if(std::count(std::begin(dims_), std::end(dims_), 1) > 1)
+    {
+      throw std::range_error("PotssModel::SpinLattice total dims > 1");
+    }
+
+    dim_type_ = Dimension::Three;
+
+    for(auto&& dim : dims_)
+    {
+      if(dim == 1)
+      {
+        dim_type_ = Dimension::Two;
+      }
+    }
+
+    if(dim_type_ == Dimension::Two)
+    {
+      if(dims_[0] == 1)
+      {
+        dims_[0] = dims_[1];
+        dims_[1] = dims_[2];
+        dims_[2] = 1;
+      }
+      else if(dims_[1] == 1)
+      {
+        dims_[1] = dims_[2];
+        dims_[2] = 1;
+      }
+    }
+  }
+
+  void generate_neighborhood()
+  {
+    switch(dim_type_)
+    {
+    case Dimension::Two: {
+      neighborhood_ = {{{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0}}};
+      neighborhood_size_ = 8;
+      break;
+    }
+    case Dimension::Three: {
+      neighborhood_ = {{{1, 0, 0},   {-1, 0, 0}, {0, 1, 0},  {0, -1, 0},  {0, 0, 1},   {0, 0, -1},  {1, 1, 0},   {-1, 1, 0},  {1, -1, 0},
+                        {-1, -1, 0}, {1, 0, 1},  {1, 0, -1}, {-1, 0, 1},  {-1, 0, -1}, {0, 1, 1},   {0, 1, -1},  {0, -1, 1},  {0, -1, -1},
+                        {1, 1, 1},   {1, 1, -1}, {1, -1, 1}, {1, -1, -1}, {-1, 1, 1},  {-1, 1, -1}, {-1, -1, 1}, {-1, -1, -1}}};
+      neighborhood_size_ = 26;
+      break;
+    }
+    default: {
+      break;
+    }
+    }
+
+    const int64_t strideY = static_cast<int64_t>(dims_[0]);
+    const int64_t strideZ = static_cast<int64_t>(dims_[0] * dims_[1]);
+    for(size_t i = 0; i < neighborhood_size_; i++)
+    {
+      neighbor_offsets_[i] = neighborhood_[i][0] + neighborhood_[i][1] * strideY + neighborhood_[i][2] * strideZ;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Splits every axis into classes so that coordinates one step apart never share a class: even and odd
+  // coordinates, plus a third class for the last coordinate when a periodic axis has odd length and would
+  // otherwise wrap an even coordinate onto an even coordinate. The color of a site is its class on each axis,
+  // giving 4 (2D) or 8 (3D) colors in the common case.
+  void generate_color_classes()
+  {
+    for(size_t d = 0; d < 3; d++)
+    {
+      classes_[d].clear();
+      site_class_[d].clear();
+      if(dims_[d] == 1)
+      {
+        classes_[d].resize(1);
+        classes_[d][0].push_back(0);
+        site_class_[d].push_back(0);
+        continue;
+      }
+      bool oddWrap = periodic_ && (dims_[d] % 2 == 1);
+      classes_[d].resize(oddWrap ? 3 : 2);
+      site_class_[d].resize(dims_[d]);
+      for(size_t c = 0; c < dims_[d]; c++)
+      {
+        size_t colorClass = (oddWrap && c == dims_[d] - 1) ? 2 : c % 2;
+        classes_[d][colorClass].push_back(c);
+        site_class_[d][c] = static_cast<uint8_t>(colorClass);
+      }
+    }
+  }
+
+  ImageGeom::Pointer image_;
+  double temperature_;
+  double kT_{};
+  bool periodic_;
+  bool kinetic_;
+  Neighborhood neighborhood_{};
+  size_t neighborhood_size_ = 0;
+  std::array<int64_t, k_MaxNeighbors> neighbor_offsets_{};
+  std::vector<std::vector<size_t>> classes_[3];
+  std::vector<uint8_t> site_class_[3];
+  // Kinetic mode only: unlike neighbor count per site, whether a site is queued, and the queued sites by color
+  std::vector<std::atomic<uint8_t>> unlike_;
+  std::vector<std::atomic<uint8_t>> queued_;
+  std::vector<std::vector<size_t>> boundary_sites_;
+  int32_t* fIds_;
+  bool* mask_;
+  size_t dims_[3]{};
+  Dimension dim_type_;
+  size_t total_flips_{};
+  uint64_t sweep_{};
+  uint64_t seed_;
+};
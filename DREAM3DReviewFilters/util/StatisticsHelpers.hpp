@@ -2,34 +2,14 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <numeric>
 #include <type_traits>
 #include <vector>
 
 namespace StatisticsHelpers
 {
-// -----------------------------------------------------------------------------
-template <template <typename, typename...> class C, typename T, typename... Ts>
-T findMin(const C<T, Ts...>& source)
-{
-  if(source.empty())
-  {
-    return static_cast<T>(0);
-  }
-  return (*std::min_element(std::cbegin(source), std::cend(source)));
-}
-
-// -----------------------------------------------------------------------------
-template <template <typename, typename...> class C, typename T, typename... Ts>
-T findMax(const C<T, Ts...>& source)
-{
-  if(source.empty())
-  {
-    return static_cast<T>(0);
-  }
-  return (*std::max_element(std::cbegin(source), std::cend(source)));
-}
-
 // -----------------------------------------------------------------------------
 template <class Container>
 auto computeSum(const Container& source)
@@ -53,94 +33,94 @@ auto computeSum(const Container& source)
 }
 
 // -----------------------------------------------------------------------------
-template <template <typename, typename...> class C, typename T, typename... Ts>
-float findMean(const C<T, Ts...>& source)
-{
-  if(source.empty())
-  {
-    return 0.0f;
-  }
-  float sum = static_cast<float>(computeSum(source));
-
-  return sum / static_cast<float>(source.size());
-}
+/**
+ * @brief Type used to accumulate sums, matching computeSum
+ */
+template <typename T>
+using SumType = typename std::conditional<std::is_floating_point<T>::value, double, typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type>::type;
 
 // -----------------------------------------------------------------------------
-template <template <typename, typename...> class C, typename... Ts>
-bool findMean(const C<bool, Ts...>& source)
+/**
+ * @brief findQuantile Returns the q quantile (0 <= q <= 1) of the values in [begin, end), interpolating linearly
+ * between the two closest ranks. Partially reorders the range with std::nth_element instead of sorting it.
+ */
+template <typename V>
+double findQuantile(V* begin, V* end, double q)
 {
-  if(source.empty())
+  const size_t count = static_cast<size_t>(end - begin);
+  if(count == 0)
   {
-    return false;
+    return 0.0;
   }
-  size_t count = std::count(std::cbegin(source), std::cend(source), true);
-  return true ? count >= (source.size() - count) : false;
+  double position = q * static_cast<double>(count - 1);
+  size_t lowerRank = static_cast<size_t>(position);
+  V* lower = begin + lowerRank;
+  std::nth_element(begin, lower, end);
+  double value = static_cast<double>(*lower);
+  if(position > static_cast<double>(lowerRank))
+  {
+    // The next rank is the smallest value right of the lower one
+    double upper = static_cast<double>(*std::min_element(lower + 1, end));
+    value += (upper - value) * (position - static_cast<double>(lowerRank));
+  }
+  return value;
 }
 
 // -----------------------------------------------------------------------------
-template <template <typename, typename...> class C, typename T, typename... Ts>
-float findMedian(const C<T, Ts...>& source)
+/**
+ * @brief The RangeStatistics struct holds the statistics of a range of values; m2 is the sum of the squared
+ * deviations from the mean
+ */
+template <typename V, typename S>
+struct RangeStatistics
 {
-  // Need a copy, not a reference, since we will be sorting the input array
-  std::vector<T> tmpList{std::cbegin(source), std::cend(source)};
-  if(tmpList.empty())
-  {
-    return 0.0f;
-  }
-  std::sort(tmpList.begin(), tmpList.end());
-  float medVal = 0.0f;
-  if(tmpList.size() % 2 == 1)
-  {
-    size_t halfElements = static_cast<size_t>(std::floor(tmpList.size() / 2.0f));
-    medVal = tmpList[halfElements];
-  }
-  else
-  {
-    size_t idxLow = (tmpList.size() / 2) - 1;
-    size_t idxHigh = tmpList.size() / 2;
-    medVal = (tmpList[idxLow] + tmpList[idxHigh]) * 0.5f;
-  }
-  return medVal;
-}
+  size_t count = 0;
+  V minValue = V(0);
+  V maxValue = V(0);
+  S sum = 0;
+  double m2 = 0.0;
+  double median = 0.0;
+};
 
 // -----------------------------------------------------------------------------
-template <template <typename, typename...> class C, typename T, typename... Ts>
-float findStdDeviation(const C<T, Ts...>& source)
+/**
+ * @brief computeRangeStatistics Computes the count, extrema, sum and m2 of the values in [begin, end) in a single
+ * pass. If medianValues is not null it must point to the same count of values, which may be the input range itself,
+ * and the median is found by partially reordering them in place. T is the value type the sum is accumulated for and
+ * V the type the values are stored as.
+ */
+template <typename T, typename V>
+RangeStatistics<V, SumType<T>> computeRangeStatistics(const V* begin, const V* end, V* medianValues)
 {
-  if(source.empty())
+  RangeStatistics<V, SumType<T>> stats;
+  stats.count = static_cast<size_t>(end - begin);
+  if(stats.count == 0)
   {
-    return 0.0f;
+    return stats;
   }
-  std::vector<double> difference(source.size());
-  float sum = static_cast<float>(computeSum(source));
-  float mean = static_cast<double>(sum / source.size());
-  std::transform(std::cbegin(source), std::cend(source), std::begin(difference), [mean](float a) { return a - mean; });
-  float squaredSum = std::inner_product(std::cbegin(difference), std::cend(difference), std::cbegin(difference), 0.0f);
-  return std::sqrt(squaredSum / source.size());
-}
 
-// -----------------------------------------------------------------------------
-template <template <typename, typename...> class C, typename... Ts>
-bool findStdDeviation(const C<bool, Ts...>& source)
-{
-  if(source.empty())
+  stats.minValue = *begin;
+  stats.maxValue = *begin;
+  // Sums of the values shifted by the first one keep the cancellation in the variance small
+  const double shift = static_cast<double>(*begin);
+  double shiftedSum = 0.0;
+  double shiftedSquares = 0.0;
+  for(const V* value = begin; value != end; ++value)
   {
-    return false;
+    stats.minValue = std::min(stats.minValue, *value);
+    stats.maxValue = std::max(stats.maxValue, *value);
+    stats.sum += static_cast<SumType<T>>(*value);
+    double delta = static_cast<double>(*value) - shift;
+    shiftedSum += delta;
+    shiftedSquares += delta * delta;
   }
-  size_t count = std::count(std::cbegin(source), std::cend(source), true);
-  return true ? count >= (source.size() - count) : false;
-}
+  stats.m2 = std::max(shiftedSquares - shiftedSum * shiftedSum / static_cast<double>(stats.count), 0.0);
 
-// -----------------------------------------------------------------------------
-template <template <typename, typename...> class C, typename T, typename... Ts>
-double findSummation(const C<T, Ts...>& source)
-{
-  if(source.empty())
+  if(medianValues != nullptr)
   {
-    return 0.0f;
+    stats.median = findQuantile(medianValues, medianValues + stats.count, 0.5);
   }
-  float sum = static_cast<float>(computeSum(source));
-  return sum;
+  return stats;
 }
 } // namespace StatisticsHelpers
 
@@ -158,7 +138,7 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID35 = 35, // StdDev
   DataArrayID36 = 36, // Summation
   DataArrayID37 = 37, // Histogram
-  DataArrayID38 = 38, //
+  DataArrayID38 = 38, // Percentiles
   DataArrayID39 = 39, // StandardizedArray
   DataArrayID40 = 40, //
 };
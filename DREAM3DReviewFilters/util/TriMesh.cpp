@@ -1,11 +1,15 @@
 #include "TriMesh.h"
 
+#include <algorithm>
+#include <array>
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 TriMesh::TriMesh(VertexCoordList vertices)
+: m_Vertices(std::move(vertices))
+, m_VertexTriangles(m_Vertices.size(), -1)
 {
-  initialize(vertices);
 }
 
 // -----------------------------------------------------------------------------
@@ -16,210 +20,289 @@ TriMesh::~TriMesh() = default;
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void TriMesh::initialize(VertexCoordList& vertices)
+void TriMesh::buildTriangleLinks()
 {
-  m_Triangles = TriList();
-  m_Vertices = VertexList();
-  for(auto&& vert : vertices)
+  // Match edges by sorting (minVertex, maxVertex, triangle, edge) records instead of a per vertex
+  // triangle list
+  using EdgeRecord = std::array<int64_t, 4>;
+  int64_t numTris = getNumberOfTriangles();
+  std::vector<EdgeRecord> edges(3 * numTris);
+  for(int64_t t = 0; t < numTris; t++)
   {
-    m_Vertices.emplace_back(TriMeshPrimitives::Vertex(vert));
+    for(int64_t k = 0; k < 3; k++)
+    {
+      int64_t v0 = m_Triangles[3 * t + k];
+      int64_t v1 = m_Triangles[3 * t + (k + 1) % 3];
+      edges[3 * t + k] = {std::min(v0, v1), std::max(v0, v1), t, k};
+    }
   }
-}
+  std::sort(edges.begin(), edges.end());
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void TriMesh::buildTriangleLinks()
-{
-  for(auto&& vert : m_Vertices)
+  std::fill(m_Neighbors.begin(), m_Neighbors.end(), -1);
+  for(size_t i = 0; i + 1 < edges.size(); i++)
   {
-    vert.triangleLinks.clear();
+    if(edges[i][0] == edges[i + 1][0] && edges[i][1] == edges[i + 1][1])
+    {
+      m_Neighbors[3 * edges[i][2] + edges[i][3]] = edges[i + 1][2];
+      m_Neighbors[3 * edges[i + 1][2] + edges[i + 1][3]] = edges[i][2];
+      i++;
+    }
   }
 
-  for(auto t = 0; t < m_Triangles.size(); t++)
+  std::fill(m_VertexTriangles.begin(), m_VertexTriangles.end(), -1);
+  for(int64_t t = 0; t < numTris; t++)
   {
-    addLinkToTriangle(m_Triangles[t].vert0, t);
-    addLinkToTriangle(m_Triangles[t].vert1, t);
-    addLinkToTriangle(m_Triangles[t].vert2, t);
+    for(int64_t k = 0; k < 3; k++)
+    {
+      m_VertexTriangles[m_Triangles[3 * t + k]] = t;
+    }
   }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void TriMesh::addLinkToTriangle(int64_t vertex, int64_t triangle)
+void TriMesh::relinkTriangles(const int64_t* triangles, size_t numTriangles)
 {
-  m_Vertices[vertex].triangleLinks.push_back(triangle);
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void TriMesh::removeLinkFromTriangle(int64_t vertex, int64_t triangle)
-{
-  m_Vertices[vertex].triangleLinks.remove(triangle);
-}
+  auto isEdited = [triangles, numTriangles](int64_t tri) { return std::find(triangles, triangles + numTriangles, tri) != triangles + numTriangles; };
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-std::vector<int64_t> TriMesh::getTrianglesToVertex(int64_t vertex)
-{
-  std::vector<int64_t> triangles;
-  triangles.reserve(m_Vertices[vertex].triangleLinks.size());
-  std::copy(std::begin(m_Vertices[vertex].triangleLinks), std::end(m_Vertices[vertex].triangleLinks), std::back_inserter(triangles));
+  // The neighbor entries of the edited triangles still name the triangles that bordered the region
+  // before the edit; every triangle that can border it now is among those
+  std::vector<int64_t>& outer = m_RelinkScratch;
+  outer.clear();
+  for(size_t i = 0; i < numTriangles; i++)
+  {
+    for(int64_t k = 0; k < 3; k++)
+    {
+      int64_t neighbor = m_Neighbors[3 * triangles[i] + k];
+      if(neighbor >= 0 && !isEdited(neighbor) && std::find(outer.begin(), outer.end(), neighbor) == outer.end())
+      {
+        outer.push_back(neighbor);
+      }
+    }
+  }
 
-  return triangles;
+  for(size_t i = 0; i < numTriangles; i++)
+  {
+    int64_t tri = triangles[i];
+    for(int64_t k = 0; k < 3; k++)
+    {
+      int64_t v0 = m_Triangles[3 * tri + k];
+      int64_t v1 = m_Triangles[3 * tri + (k + 1) % 3];
+      int64_t neighbor = -1;
+      for(size_t j = 0; j < numTriangles && neighbor < 0; j++)
+      {
+        if(triangles[j] != tri && findEdge(v0, v1, triangles[j]) >= 0)
+        {
+          neighbor = triangles[j];
+        }
+      }
+      for(size_t j = 0; j < outer.size() && neighbor < 0; j++)
+      {
+        int32_t edge = findEdge(v0, v1, outer[j]);
+        if(edge >= 0)
+        {
+          neighbor = outer[j];
+          m_Neighbors[3 * outer[j] + edge] = tri;
+        }
+      }
+      m_Neighbors[3 * tri + k] = neighbor;
+      m_VertexTriangles[v0] = tri;
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int64_t TriMesh::getTriangleEdgeNeighbor(int64_t vertex0, int64_t vertex1, int64_t triangle)
+void TriMesh::getTrianglesToVertex(int64_t vertex, std::vector<int64_t>& triangles) const
 {
-  std::list<int64_t> vert0tris = m_Vertices[vertex0].triangleLinks;
-  std::list<int64_t> vert1tris = m_Vertices[vertex1].triangleLinks;
-  vert0tris.sort();
-  vert1tris.sort();
+  triangles.clear();
+  int64_t start = m_VertexTriangles[vertex];
+  if(start < 0)
+  {
+    return;
+  }
 
-  std::list<int64_t> sharedTriangles;
-  std::set_intersection(vert0tris.begin(), vert0tris.end(), vert1tris.begin(), vert1tris.end(), std::back_inserter(sharedTriangles));
+  // The two edges of a triangle that contain the vertex lead to the previous and the next triangle
+  // of its star
+  auto nextAroundVertex = [this, vertex](int64_t tri, int64_t previous) {
+    int64_t k = 0;
+    while(m_Triangles[3 * tri + k] != vertex)
+    {
+      k++;
+    }
+    int64_t leading = m_Neighbors[3 * tri + k];
+    int64_t trailing = m_Neighbors[3 * tri + (k + 2) % 3];
+    return (leading == previous) ? trailing : leading;
+  };
 
-  if(sharedTriangles.size() > 2)
+  int64_t previous = -2;
+  int64_t current = start;
+  while(true)
   {
-    return -1;
-  }                                 // non-manifold
-  sharedTriangles.remove(triangle); // remove the source triangle
-  if(sharedTriangles.empty())
-  {
-    return -1;
-  } // boundary
+    triangles.push_back(current);
+    int64_t next = nextAroundVertex(current, previous);
+    if(next == start)
+    {
+      return;
+    }
+    if(next < 0)
+    {
+      break;
+    }
+    previous = current;
+    current = next;
+  }
 
-  return (*sharedTriangles.begin());
+  // Hit the mesh boundary; collect the rest of the star in the other direction
+  previous = (triangles.size() > 1) ? triangles[1] : -1;
+  current = nextAroundVertex(start, previous);
+  previous = start;
+  while(current >= 0 && current != start)
+  {
+    triangles.push_back(current);
+    int64_t next = nextAroundVertex(current, previous);
+    previous = current;
+    current = next;
+  }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void TriMesh::replaceTriangleVertices(int64_t vertex0, int64_t vertex1, int64_t vertex2, int64_t triangle)
+int64_t TriMesh::getVertexTriangle(int64_t vertex) const
 {
-  m_Triangles[triangle].vert0 = vertex0;
-  m_Triangles[triangle].vert1 = vertex1;
-  m_Triangles[triangle].vert2 = vertex2;
-  m_Triangles[triangle].updateEdges();
+  return m_VertexTriangles[vertex];
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int64_t TriMesh::addTriangle(int64_t vertex0, int64_t vertex1, int64_t vertex2)
+int64_t TriMesh::getTriangleEdgeNeighbor(int64_t vertex0, int64_t vertex1, int64_t triangle) const
 {
-  m_Triangles.emplace_back(TriMeshPrimitives::Triangle(vertex0, vertex1, vertex2));
-  addLinkToTriangle(vertex0, m_Triangles.size() - 1);
-  addLinkToTriangle(vertex1, m_Triangles.size() - 1);
-  addLinkToTriangle(vertex2, m_Triangles.size() - 1);
-
-  return (m_Triangles.size() - 1);
+  int32_t edge = findEdge(vertex0, vertex1, triangle);
+  if(edge < 0)
+  {
+    return -1;
+  }
+  return m_Neighbors[3 * triangle + edge];
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void TriMesh::removeVertices(std::vector<int64_t> vertices)
+void TriMesh::replaceTriangleVertices(int64_t vertex0, int64_t vertex1, int64_t vertex2, int64_t triangle)
 {
-  for(auto&& index : vertices)
-  {
-    VertexList::iterator iter = m_Vertices.begin() + index;
-    m_Vertices.erase(iter);
-  }
+  m_Triangles[3 * triangle + 0] = vertex0;
+  m_Triangles[3 * triangle + 1] = vertex1;
+  m_Triangles[3 * triangle + 2] = vertex2;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void TriMesh::removeTriangles(std::vector<int64_t> triangles)
+int64_t TriMesh::addTriangle(int64_t vertex0, int64_t vertex1, int64_t vertex2)
 {
-  for(auto&& index : triangles)
-  {
-    TriList::iterator iter = m_Triangles.begin() + index;
-    m_Triangles.erase(iter);
-  }
+  m_Triangles.push_back(vertex0);
+  m_Triangles.push_back(vertex1);
+  m_Triangles.push_back(vertex2);
+  m_Neighbors.insert(m_Neighbors.end(), 3, -1);
+
+  return getNumberOfTriangles() - 1;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void TriMesh::getTriangleVertices(int64_t triangle, int64_t vertices[3])
+void TriMesh::getTriangleVertices(int64_t triangle, int64_t vertices[3]) const
 {
-  vertices[0] = m_Triangles[triangle].vert0;
-  vertices[1] = m_Triangles[triangle].vert1;
-  vertices[2] = m_Triangles[triangle].vert2;
+  vertices[0] = m_Triangles[3 * triangle + 0];
+  vertices[1] = m_Triangles[3 * triangle + 1];
+  vertices[2] = m_Triangles[3 * triangle + 2];
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void TriMesh::getVertexCoordinates(int64_t vertex, float coordinates[3])
+void TriMesh::getVertexCoordinates(int64_t vertex, float coordinates[3]) const
 {
-  coordinates[0] = m_Vertices[vertex].vert[0];
-  coordinates[1] = m_Vertices[vertex].vert[1];
-  coordinates[2] = m_Vertices[vertex].vert[2];
+  coordinates[0] = m_Vertices.x[vertex];
+  coordinates[1] = m_Vertices.y[vertex];
+  coordinates[2] = m_Vertices.z[vertex];
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void TriMesh::getVertexCoordinates(int64_t vertex, double coordinates[3])
+void TriMesh::getVertexCoordinates(int64_t vertex, double coordinates[3]) const
 {
-  coordinates[0] = static_cast<double>(m_Vertices[vertex].vert[0]);
-  coordinates[1] = static_cast<double>(m_Vertices[vertex].vert[1]);
-  coordinates[2] = static_cast<double>(m_Vertices[vertex].vert[2]);
+  coordinates[0] = static_cast<double>(m_Vertices.x[vertex]);
+  coordinates[1] = static_cast<double>(m_Vertices.y[vertex]);
+  coordinates[2] = static_cast<double>(m_Vertices.z[vertex]);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int64_t TriMesh::getOppositeVertex(int64_t vertex0, int64_t vertex1, int64_t triangle)
+int64_t TriMesh::getOppositeVertex(int64_t vertex0, int64_t vertex1, int64_t triangle) const
 {
-  TriMeshPrimitives::Edge edge(vertex0, vertex1);
-  return (m_Triangles[triangle].getOppositeVertex(edge));
+  int32_t edge = findEdge(vertex0, vertex1, triangle);
+  if(edge < 0)
+  {
+    return -1;
+  }
+  return m_Triangles[3 * triangle + (edge + 2) % 3];
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int64_t TriMesh::getNumberOfTriangles()
+int64_t TriMesh::getNumberOfTriangles() const
 {
-  return (static_cast<int64_t>(m_Triangles.size()));
+  return static_cast<int64_t>(m_Triangles.size() / 3);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-TriangleGeom::Pointer TriMesh::convertToTriangleGeometry()
+TriangleGeom::Pointer TriMesh::convertToTriangleGeometry() const
 {
   SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(m_Vertices.size());
-  TriangleGeom::Pointer triangles = TriangleGeom::CreateGeometry(m_Triangles.size(), vertices, SIMPL::Geometry::TriangleGeometry);
+  TriangleGeom::Pointer triangles = TriangleGeom::CreateGeometry(getNumberOfTriangles(), vertices, SIMPL::Geometry::TriangleGeometry);
   float* verts = triangles->getVertexPointer(0);
-  size_t* tris = triangles->getTriPointer(0);
+  MeshIndexType* tris = triangles->getTriPointer(0);
 
-  for(auto i = 0; i < m_Vertices.size(); i++)
+  for(size_t i = 0; i < m_Vertices.size(); i++)
   {
-    verts[3 * i + 0] = m_Vertices[i].vert[0];
-    verts[3 * i + 1] = m_Vertices[i].vert[1];
-    verts[3 * i + 2] = m_Vertices[i].vert[2];
+    verts[3 * i + 0] = m_Vertices.x[i];
+    verts[3 * i + 1] = m_Vertices.y[i];
+    verts[3 * i + 2] = m_Vertices.z[i];
   }
 
-  for(auto i = 0; i < m_Triangles.size(); i++)
-  {
-    tris[3 * i + 0] = m_Triangles[i].vert0;
-    tris[3 * i + 1] = m_Triangles[i].vert1;
-    tris[3 * i + 2] = m_Triangles[i].vert2;
-  }
+  std::copy(m_Triangles.begin(), m_Triangles.end(), tris);
 
   return triangles;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t TriMesh::findEdge(int64_t vertex0, int64_t vertex1, int64_t triangle) const
+{
+  const int64_t* verts = m_Triangles.data() + 3 * triangle;
+  for(int32_t k = 0; k < 3; k++)
+  {
+    int64_t v0 = verts[k];
+    int64_t v1 = verts[(k + 1) % 3];
+    if((v0 == vertex0 && v1 == vertex1) || (v0 == vertex1 && v1 == vertex0))
+    {
+      return k;
+    }
+  }
+  return -1;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
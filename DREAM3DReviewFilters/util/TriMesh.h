@@ -5,7 +5,11 @@
 #include "DREAM3DReviewFilters/util/TriMeshPrimitives.hpp"
 
 /**
- * @brief The TriMesh class
+ * @brief The TriMesh class is a mutable triangle mesh used by the Delaunay triangulation. Vertex
+ * coordinates are stored as a structure of arrays, and connectivity is stored flat: three vertex ids
+ * and three edge neighbors per triangle, plus one incident triangle per vertex. Edge neighbor k of a
+ * triangle is the triangle across its edge (k, k + 1). Triangles are edited in place; callers that
+ * replace or add triangles re-establish the adjacency with relinkTriangles().
  */
 class TriMesh
 {
@@ -19,64 +23,78 @@ public:
 
   virtual ~TriMesh();
 
-  typedef std::vector<std::vector<float>> VertexCoordList;
-  typedef std::vector<TriMeshPrimitives::Vertex> VertexList;
-  typedef std::vector<TriMeshPrimitives::Triangle> TriList;
+  using VertexCoordList = TriMeshPrimitives::VertexCoordinates;
+  using TriList = std::vector<int64_t>;
 
   static Pointer New(VertexCoordList vertices)
   {
-    Pointer sharedPtr(new TriMesh(vertices));
+    Pointer sharedPtr(new TriMesh(std::move(vertices)));
     return sharedPtr;
   }
 
-  VertexList getVertices()
+  const VertexCoordList& getVertices() const
   {
     return m_Vertices;
   }
 
-  TriList getTriangles()
+  const TriList& getTriangles() const
   {
     return m_Triangles;
   }
 
+  /**
+   * @brief buildTriangleLinks Rebuilds the edge neighbors and vertex to triangle links of the whole mesh
+   */
   void buildTriangleLinks();
 
-  void addLinkToTriangle(int64_t vertex, int64_t triangle);
+  /**
+   * @brief relinkTriangles Re-establishes the edge neighbors between the given triangles and the
+   * triangles that bordered them before their vertices were replaced. Every triangle that was edited
+   * or added by a local operation (split, flip) must be passed in one call.
+   * @param triangles
+   * @param numTriangles
+   */
+  void relinkTriangles(const int64_t* triangles, size_t numTriangles);
 
-  void removeLinkFromTriangle(int64_t vertex, int64_t triangle);
+  /**
+   * @brief getTrianglesToVertex Fills triangles with the triangles that use vertex, walking around
+   * the vertex through the edge neighbors
+   * @param vertex
+   * @param triangles
+   */
+  void getTrianglesToVertex(int64_t vertex, std::vector<int64_t>& triangles) const;
 
-  std::vector<int64_t> getTrianglesToVertex(int64_t vertex);
+  int64_t getVertexTriangle(int64_t vertex) const;
 
-  int64_t getTriangleEdgeNeighbor(int64_t vertex0, int64_t vertex1, int64_t triangle);
+  int64_t getTriangleEdgeNeighbor(int64_t vertex0, int64_t vertex1, int64_t triangle) const;
 
   void replaceTriangleVertices(int64_t vertex0, int64_t vertex1, int64_t vertex2, int64_t triangle);
 
   int64_t addTriangle(int64_t vertex0, int64_t vertex1, int64_t vertex2);
 
-  void removeVertices(std::vector<int64_t> vertices);
+  void getTriangleVertices(int64_t triangle, int64_t vertices[3]) const;
 
-  void removeTriangles(std::vector<int64_t> triangles);
+  void getVertexCoordinates(int64_t vertex, float coordinates[3]) const;
 
-  void getTriangleVertices(int64_t triangle, int64_t vertices[3]);
+  void getVertexCoordinates(int64_t vertex, double coordinates[3]) const;
 
-  void getVertexCoordinates(int64_t vertex, float coordinates[3]);
+  int64_t getOppositeVertex(int64_t vertex0, int64_t vertex1, int64_t triangle) const;
 
-  void getVertexCoordinates(int64_t vertex, double coordinates[3]);
+  int64_t getNumberOfTriangles() const;
 
-  int64_t getOppositeVertex(int64_t vertex0, int64_t vertex1, int64_t triangle);
-
-  int64_t getNumberOfTriangles();
-
-  TriangleGeom::Pointer convertToTriangleGeometry();
+  TriangleGeom::Pointer convertToTriangleGeometry() const;
 
 protected:
   explicit TriMesh(VertexCoordList vertices);
 
 private:
-  VertexList m_Vertices;
+  VertexCoordList m_Vertices;
   TriList m_Triangles;
+  TriList m_Neighbors;
+  std::vector<int64_t> m_VertexTriangles;
+  std::vector<int64_t> m_RelinkScratch;
 
-  void initialize(VertexCoordList& vertices);
+  int32_t findEdge(int64_t vertex0, int64_t vertex1, int64_t triangle) const;
 
   TriMesh(const TriMesh&) = delete;        // Copy Constructor Not Implemented
   void operator=(const TriMesh&) = delete; // Operator '=' Not Implemented
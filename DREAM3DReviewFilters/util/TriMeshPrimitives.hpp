@@ -1,98 +1,67 @@
 #pragma once
 
-#include <list>
 #include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 
 namespace TriMeshPrimitives
 {
-class Vertex
+/**
+ * @brief The VertexCoordinates class stores vertex coordinates as a structure of arrays, so a list
+ * of n vertices costs three allocations instead of one per vertex.
+ */
+class VertexCoordinates
 {
 public:
-  Vertex(const std::vector<float>& vert)
-  : vert(vert)
+  VertexCoordinates() = default;
+
+  explicit VertexCoordinates(size_t numVertices)
+  : x(numVertices, 0.0f)
+  , y(numVertices, 0.0f)
+  , z(numVertices, 0.0f)
   {
   }
 
-  std::vector<float> vert;
-  std::list<int64_t> triangleLinks;
-};
-
-inline bool operator==(const Vertex& vert0, const Vertex& vert1)
-{
-  return (vert0.vert == vert1.vert);
-}
-
-class Edge
-{
-public:
-  Edge(const int64_t& vert0, const int64_t& vert1)
-  : vert0(vert0)
-  , vert1(vert1)
+  size_t size() const
   {
+    return x.size();
   }
 
-  int64_t vert0;
-  int64_t vert1;
-};
-
-inline bool operator==(const Edge& edge0, const Edge& edge1)
-{
-  return (edge0.vert0 == edge1.vert0 && edge0.vert1 == edge1.vert1) || (edge0.vert0 == edge1.vert1 && edge0.vert1 == edge1.vert0);
-}
+  bool empty() const
+  {
+    return x.empty();
+  }
 
-class Triangle
-{
-public:
-  Triangle(const int64_t& vert0, const int64_t& vert1, const int64_t& vert2)
-  : vert0(vert0)
-  , vert1(vert1)
-  , vert2(vert2)
-  , edge0(vert0, vert1)
-  , edge1(vert1, vert2)
-  , edge2(vert2, vert0)
+  void reserve(size_t numVertices)
   {
+    x.reserve(numVertices);
+    y.reserve(numVertices);
+    z.reserve(numVertices);
   }
 
-  int64_t vert0;
-  int64_t vert1;
-  int64_t vert2;
-  Edge edge0;
-  Edge edge1;
-  Edge edge2;
+  void resize(size_t numVertices)
+  {
+    x.resize(numVertices, 0.0f);
+    y.resize(numVertices, 0.0f);
+    z.resize(numVertices, 0.0f);
+  }
 
-  int64_t getOppositeVertex(Edge& edge)
+  void push_back(float xCoord, float yCoord, float zCoord)
   {
-    if(edge == edge0)
-    {
-      return vert2;
-    }
-    else if(edge == edge1)
-    {
-      return vert0;
-    }
-    else if(edge == edge2)
-    {
-      return vert1;
-    }
-    else
-    {
-      return -1;
-    }
+    x.push_back(xCoord);
+    y.push_back(yCoord);
+    z.push_back(zCoord);
   }
 
-  void updateEdges()
+  void setCoordinates(size_t vertex, float xCoord, float yCoord, float zCoord)
   {
-    edge0 = Edge(vert0, vert1);
-    edge1 = Edge(vert1, vert2);
-    edge2 = Edge(vert2, vert0);
+    x[vertex] = xCoord;
+    y[vertex] = yCoord;
+    z[vertex] = zCoord;
   }
-};
 
-inline bool operator==(const Triangle& tri0, const Triangle& tri1)
-{
-  return (tri0.vert0 == tri1.vert0 || tri0.vert0 == tri1.vert1 || tri0.vert0 == tri1.vert2) && (tri0.vert1 == tri1.vert0 || tri0.vert1 == tri1.vert1 || tri0.vert1 == tri1.vert2) &&
-         (tri0.vert2 == tri1.vert0 || tri0.vert2 == tri1.vert1 || tri0.vert2 == tri1.vert2);
-}
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+};
 } // namespace TriMeshPrimitives
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The UnionFind class is a disjoint-set forest over the dense index range [0, size). Both
+ * find() and unite() may be called concurrently from several threads: roots are linked with a
+ * compare-and-swap, always from the larger index to the smaller one, and paths are compressed by
+ * halving. Once all unions are done the root of every set is its smallest member, so labels do not
+ * depend on thread scheduling.
+ */
+template <typename T = size_t>
+class UnionFind
+{
+public:
+  explicit UnionFind(size_t size)
+  : m_Parents(size)
+  {
+    for(size_t i = 0; i < size; i++)
+    {
+      m_Parents[i].store(static_cast<T>(i), std::memory_order_relaxed);
+    }
+  }
+
+  ~UnionFind() = default;
+
+  UnionFind(const UnionFind&) = delete;
+  UnionFind(UnionFind&&) = delete;
+  UnionFind& operator=(const UnionFind&) = delete;
+  UnionFind& operator=(UnionFind&&) = delete;
+
+  /**
+   * @brief size
+   * @return Number of elements in the forest
+   */
+  size_t size() const
+  {
+    return m_Parents.size();
+  }
+
+  /**
+   * @brief find Returns the current root of the set containing x
+   * @param x
+   * @return
+   */
+  T find(T x)
+  {
+    while(true)
+    {
+      T parent = m_Parents[x].load(std::memory_order_relaxed);
+      if(parent == x)
+      {
+        return x;
+      }
+      T grandParent = m_Parents[parent].load(std::memory_order_relaxed);
+      if(parent != grandParent)
+      {
+        m_Parents[x].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+      }
+      x = grandParent;
+    }
+  }
+
+  /**
+   * @brief unite Merges the sets containing a and b
+   * @param a
+   * @param b
+   */
+  void unite(T a, T b)
+  {
+    while(true)
+    {
+      a = find(a);
+      b = find(b);
+      if(a == b)
+      {
+        return;
+      }
+      if(a < b)
+      {
+        std::swap(a, b);
+      }
+      T expected = a;
+      if(m_Parents[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel))
+      {
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief isRoot Returns true if x is the representative of its set. Only meaningful once all
+   * unions have completed.
+   * @param x
+   * @return
+   */
+  bool isRoot(T x) const
+  {
+    return m_Parents[x].load(std::memory_order_relaxed) == x;
+  }
+
+private:
+  std::vector<std::atomic<T>> m_Parents;
+};
@@ -31,6 +31,11 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QString>
@@ -45,6 +50,7 @@
 #include "SIMPLib/Filtering/FilterManager.h"
 #include "SIMPLib/Filtering/FilterPipeline.h"
 #include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Plugin/ISIMPLibPlugin.h"
 #include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
 
@@ -52,6 +58,8 @@
 
 #include "DREAM3DReviewTestFileLocations.h"
 
+#include "DREAM3DReview/DREAM3DReviewFilters/util/EuclideanDistanceMap.hpp"
+
 class EstablishFoamMorphologyTest
 {
   // These values are dependant on the prebuilt example pipeline for this filter. If the names of any of the Data Structure
@@ -61,6 +69,8 @@ class EstablishFoamMorphologyTest
   const QString k_CellFeatureData2 = {"CellFeatureData2"};
   const QString k_Centroids = {"Centroids"};
   const QString k_Phases2 = {"Phases2"};
+  const SizeVec3Type k_Dims = {13, 9, 7};
+  const FloatVec3Type k_Spacing = {0.5f, 1.25f, 2.0f};
 
 public:
   EstablishFoamMorphologyTest() = default;
@@ -95,6 +105,93 @@ public:
     return 0;
   }
 
+  // -----------------------------------------------------------------------------
+  // Compares the distance map of a few seed voxels against a brute force nearest seed search. Seeds are voxels of
+  // a Feature with a distance of 0; every other voxel starts at -1, as find_euclideandistmap leaves them.
+  // -----------------------------------------------------------------------------
+  int checkDistanceMap(const ImageGeom::Pointer& image, const std::vector<int32_t>& featureIds, const std::vector<size_t>& seeds)
+  {
+    size_t totalPoints = image->getNumberOfElements();
+    std::vector<float> distances(totalPoints, -1.0f);
+    for(size_t seed : seeds)
+    {
+      distances[seed] = 0.0f;
+    }
+    EuclideanDistanceMap(image, featureIds.data(), distances.data())();
+
+    for(size_t a = 0; a < totalPoints; a++)
+    {
+      if(featureIds[a] <= 0)
+      {
+        DREAM3D_REQUIRE_EQUAL(distances[a], 0.0f)
+        continue;
+      }
+      size_t x = a % k_Dims[0];
+      size_t y = (a / k_Dims[0]) % k_Dims[1];
+      size_t z = a / (k_Dims[0] * k_Dims[1]);
+      double nearest = std::numeric_limits<double>::infinity();
+      for(size_t seed : seeds)
+      {
+        if(featureIds[seed] <= 0)
+        {
+          continue;
+        }
+        double dx = (static_cast<double>(seed % k_Dims[0]) - static_cast<double>(x)) * k_Spacing[0];
+        double dy = (static_cast<double>((seed / k_Dims[0]) % k_Dims[1]) - static_cast<double>(y)) * k_Spacing[1];
+        double dz = (static_cast<double>(seed / (k_Dims[0] * k_Dims[1])) - static_cast<double>(z)) * k_Spacing[2];
+        nearest = std::min(nearest, std::sqrt(dx * dx + dy * dy + dz * dz));
+      }
+      if(nearest == std::numeric_limits<double>::infinity())
+      {
+        DREAM3D_REQUIRE_EQUAL(distances[a], -1.0f)
+        continue;
+      }
+      DREAM3D_REQUIRE(std::fabs(static_cast<double>(distances[a]) - nearest) <= 1.0E-5 * std::max(1.0, nearest))
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestEuclideanDistanceMap()
+  {
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(k_Dims);
+    image->setSpacing(k_Spacing);
+    size_t totalPoints = image->getNumberOfElements();
+
+    // One Feature, with a plane of Id 0 at the far x face and a few scattered voxels of Id -1
+    std::vector<int32_t> featureIds(totalPoints, 1);
+    for(size_t a = 0; a < totalPoints; a++)
+    {
+      if(a % k_Dims[0] == k_Dims[0] - 1)
+      {
+        featureIds[a] = 0;
+      }
+    }
+    featureIds[17] = -1;
+    featureIds[301] = -1;
+    featureIds[600] = -1;
+    DREAM3D_REQUIRE_EQUAL(featureIds[25], 0)
+
+    // Grain boundary map: several seeds, plus a voxel of Id 0 holding a distance of 0 that must not act as a seed
+    std::vector<size_t> gbSeeds = {0, 44, 210, 333, 517, 815, 25};
+    int err = checkDistanceMap(image, featureIds, gbSeeds);
+    DREAM3D_REQUIRED(err, ==, EXIT_SUCCESS)
+
+    // Triple junction map: two seeds in opposite corners
+    std::vector<size_t> tjSeeds = {0, totalPoints - 2};
+    err = checkDistanceMap(image, featureIds, tjSeeds);
+    DREAM3D_REQUIRED(err, ==, EXIT_SUCCESS)
+
+    // Quadruple point map: no seeds, so every voxel of a Feature is unreached
+    err = checkDistanceMap(image, featureIds, {});
+    DREAM3D_REQUIRED(err, ==, EXIT_SUCCESS)
+
+    return EXIT_SUCCESS;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -172,6 +269,8 @@ public:
 
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
+    DREAM3D_REGISTER_TEST(TestEuclideanDistanceMap())
+
     DREAM3D_REGISTER_TEST(TestEstablishFoamMorphologyTest())
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
@@ -0,0 +1,193 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReviewTestFileLocations.h"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/FindArrayStatistics.h"
+
+class FindArrayStatisticsTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_AttributeMatrixName = {"CellData"};
+  const QString k_StatisticsMatrixName = {"Statistics"};
+  const QString k_DataArrayName = {"Data"};
+  const size_t k_NumTuples = 200000;
+
+public:
+  FindArrayStatisticsTest() = default;
+  ~FindArrayStatisticsTest() = default;
+  FindArrayStatisticsTest(const FindArrayStatisticsTest&) = delete;            // Copy Constructor
+  FindArrayStatisticsTest(FindArrayStatisticsTest&&) = delete;                 // Move Constructor
+  FindArrayStatisticsTest& operator=(const FindArrayStatisticsTest&) = delete; // Copy Assignment
+  FindArrayStatisticsTest& operator=(FindArrayStatisticsTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    std::vector<size_t> tupleDims = {k_NumTuples};
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tupleDims, k_AttributeMatrixName, AttributeMatrix::Type::Generic);
+    dc->addOrReplaceAttributeMatrix(am);
+    tupleDims = {1};
+    AttributeMatrix::Pointer statsAm = AttributeMatrix::New(tupleDims, k_StatisticsMatrixName, AttributeMatrix::Type::Generic);
+    dc->addOrReplaceAttributeMatrix(statsAm);
+
+    // Skewed pseudo random values with many repeats
+    Int32ArrayType::Pointer data = Int32ArrayType::CreateArray(k_NumTuples, k_DataArrayName, true);
+    for(size_t i = 0; i < k_NumTuples; i++)
+    {
+      int32_t value = static_cast<int32_t>((i * 7919) % 10007);
+      data->setValue(i, value * value / 1000 - 20000);
+    }
+    am->addOrReplaceAttributeArray(data);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  FindArrayStatistics::Pointer createFilter(const DataContainerArray::Pointer& dca)
+  {
+    FindArrayStatistics::Pointer filter = FindArrayStatistics::New();
+    filter->setDataContainerArray(dca);
+    filter->setSelectedArrayPath({k_DataContainerName, k_AttributeMatrixName, k_DataArrayName});
+    filter->setDestinationAttributeMatrix({k_DataContainerName, k_StatisticsMatrixName, ""});
+    filter->setFindLength(true);
+    filter->setFindMin(true);
+    filter->setFindMax(true);
+    filter->setFindMean(true);
+    filter->setFindMedian(true);
+    filter->setFindStdDeviation(true);
+    filter->setFindSummation(true);
+    filter->setFindHistogram(true);
+    filter->setHistogramArrayName("Histogram");
+    filter->setUseFullRange(true);
+    filter->setNumBins(16);
+    filter->setFindPercentiles(true);
+    filter->setPercentiles("1, 10, 50, 90, 99");
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestPreflight()
+  {
+    FindArrayStatistics::Pointer filter = createFilter(createDataStructure());
+    filter->setPercentiles("5, 101");
+    filter->preflight();
+    int32_t err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, ==, -11004)
+
+    filter = createFilter(createDataStructure());
+    filter->setUseStreamingStatistics(true);
+    filter->setQuantileSketchSize(4);
+    filter->preflight();
+    err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, ==, -11005)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestStreamingStatistics()
+  {
+    DataContainerArray::Pointer exactDca = createDataStructure();
+    FindArrayStatistics::Pointer filter = createFilter(exactDca);
+    filter->execute();
+    int32_t err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    const int32_t sketchSize = 200;
+    DataContainerArray::Pointer streamingDca = createDataStructure();
+    filter = createFilter(streamingDca);
+    filter->setUseStreamingStatistics(true);
+    filter->setQuantileSketchSize(sketchSize);
+    filter->execute();
+    err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    AttributeMatrix::Pointer exactAm = exactDca->getAttributeMatrix({k_DataContainerName, k_StatisticsMatrixName, ""});
+    AttributeMatrix::Pointer streamingAm = streamingDca->getAttributeMatrix({k_DataContainerName, k_StatisticsMatrixName, ""});
+
+    DREAM3D_REQUIRE_EQUAL(exactAm->getAttributeArrayAs<MeshIndexArrayType>("Length")->getValue(0), streamingAm->getAttributeArrayAs<MeshIndexArrayType>("Length")->getValue(0))
+    DREAM3D_REQUIRE_EQUAL(exactAm->getAttributeArrayAs<Int32ArrayType>("Minimum")->getValue(0), streamingAm->getAttributeArrayAs<Int32ArrayType>("Minimum")->getValue(0))
+    DREAM3D_REQUIRE_EQUAL(exactAm->getAttributeArrayAs<Int32ArrayType>("Maximum")->getValue(0), streamingAm->getAttributeArrayAs<Int32ArrayType>("Maximum")->getValue(0))
+    for(const QString& name : QStringList{"Mean", "StandardDeviation", "Summation"})
+    {
+      float exact = exactAm->getAttributeArrayAs<FloatArrayType>(name)->getValue(0);
+      float streaming = streamingAm->getAttributeArrayAs<FloatArrayType>(name)->getValue(0);
+      DREAM3D_REQUIRE(std::abs(exact - streaming) <= 1.0E-5f * std::max(std::abs(exact), 1.0f))
+    }
+    FloatArrayType::Pointer exactHistogram = exactAm->getAttributeArrayAs<FloatArrayType>("Histogram");
+    FloatArrayType::Pointer streamingHistogram = streamingAm->getAttributeArrayAs<FloatArrayType>("Histogram");
+    for(size_t bin = 0; bin < exactHistogram->getNumberOfComponents(); bin++)
+    {
+      DREAM3D_REQUIRE_EQUAL(exactHistogram->getValue(bin), streamingHistogram->getValue(bin))
+    }
+
+    // Exact percentiles interpolate between the closest ranks; the streaming ones must lie within the rank error of the sketch
+    AttributeMatrix::Pointer am = exactDca->getAttributeMatrix({k_DataContainerName, k_AttributeMatrixName, ""});
+    Int32ArrayType& data = *(am->getAttributeArrayAs<Int32ArrayType>(k_DataArrayName));
+    std::vector<int32_t> sorted(data.begin(), data.end());
+    std::sort(sorted.begin(), sorted.end());
+
+    const std::vector<double> percentiles = {1.0, 10.0, 50.0, 90.0, 99.0};
+    const double maxRankError = 2.0 / sketchSize * static_cast<double>(k_NumTuples);
+    FloatArrayType::Pointer exactPercentiles = exactAm->getAttributeArrayAs<FloatArrayType>("Percentiles");
+    FloatArrayType::Pointer streamingPercentiles = streamingAm->getAttributeArrayAs<FloatArrayType>("Percentiles");
+    DREAM3D_REQUIRE_EQUAL(exactPercentiles->getNumberOfComponents(), percentiles.size())
+    for(size_t i = 0; i < percentiles.size(); i++)
+    {
+      double position = percentiles[i] / 100.0 * static_cast<double>(k_NumTuples - 1);
+      size_t lower = static_cast<size_t>(position);
+      double expected = sorted[lower] + (sorted[lower + 1] - sorted[lower]) * (position - static_cast<double>(lower));
+      DREAM3D_REQUIRE(std::abs(exactPercentiles->getValue(i) - expected) < 1.0E-3 * std::max(std::abs(expected), 1.0))
+
+      float estimate = streamingPercentiles->getValue(i);
+      double lowestRank = static_cast<double>(std::lower_bound(sorted.begin(), sorted.end(), static_cast<int32_t>(std::floor(estimate))) - sorted.begin());
+      double highestRank = static_cast<double>(std::upper_bound(sorted.begin(), sorted.end(), static_cast<int32_t>(std::ceil(estimate))) - sorted.begin());
+      DREAM3D_REQUIRE(lowestRank - maxRankError <= position && position <= highestRank + maxRankError)
+    }
+    float exactMedian = exactAm->getAttributeArrayAs<FloatArrayType>("Median")->getValue(0);
+    DREAM3D_REQUIRE_EQUAL(exactMedian, exactPercentiles->getValue(2))
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestPreflight())
+    DREAM3D_REGISTER_TEST(TestStreamingStatistics())
+  }
+
+private:
+};
@@ -0,0 +1,178 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReviewTestFileLocations.h"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/FindMovingWindowStatistics.h"
+
+class FindMovingWindowStatisticsTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_AttributeMatrixName = {"CellData"};
+  const QString k_DataArrayName = {"Data"};
+  const SizeVec3Type k_Dims = {7, 5, 4};
+
+public:
+  FindMovingWindowStatisticsTest() = default;
+  ~FindMovingWindowStatisticsTest() = default;
+  FindMovingWindowStatisticsTest(const FindMovingWindowStatisticsTest&) = delete;            // Copy Constructor
+  FindMovingWindowStatisticsTest(FindMovingWindowStatisticsTest&&) = delete;                 // Move Constructor
+  FindMovingWindowStatisticsTest& operator=(const FindMovingWindowStatisticsTest&) = delete; // Copy Assignment
+  FindMovingWindowStatisticsTest& operator=(FindMovingWindowStatisticsTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(k_Dims);
+    dc->setGeometry(image);
+
+    std::vector<size_t> tupleDims = {k_Dims[0], k_Dims[1], k_Dims[2]};
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tupleDims, k_AttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(am);
+
+    // Large offset plus a small pseudo random pattern, which stresses the cancellation in the variance
+    Int32ArrayType::Pointer data = Int32ArrayType::CreateArray(k_Dims[0] * k_Dims[1] * k_Dims[2], k_DataArrayName, true);
+    for(size_t i = 0; i < data->getNumberOfTuples(); i++)
+    {
+      data->setValue(i, 100000 + static_cast<int32_t>((i * 7919) % 61) - 30);
+    }
+    am->addOrReplaceAttributeArray(data);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestPreflight()
+  {
+    FindMovingWindowStatistics::Pointer filter = FindMovingWindowStatistics::New();
+    filter->setDataContainerArray(createDataStructure());
+    filter->setSelectedArrayPath({k_DataContainerName, k_AttributeMatrixName, k_DataArrayName});
+    filter->setWindowRadius({1, -1, 1});
+    filter->preflight();
+    int32_t err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, ==, -11000)
+
+    filter->setDataContainerArray(createDataStructure());
+    filter->setWindowRadius({1, 1, 1});
+    filter->setFindMean(false);
+    filter->setFindVariance(false);
+    filter->setFindMin(false);
+    filter->setFindMax(false);
+    filter->preflight();
+    err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, ==, -11001)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestWindowStatistics()
+  {
+    const IntVec3Type radius = {2, 1, 3};
+
+    DataContainerArray::Pointer dca = createDataStructure();
+    FindMovingWindowStatistics::Pointer filter = FindMovingWindowStatistics::New();
+    filter->setDataContainerArray(dca);
+    filter->setSelectedArrayPath({k_DataContainerName, k_AttributeMatrixName, k_DataArrayName});
+    filter->setWindowRadius(radius);
+    filter->setFindMean(true);
+    filter->setFindVariance(true);
+    filter->setFindMin(true);
+    filter->setFindMax(true);
+    filter->execute();
+    int32_t err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    AttributeMatrix::Pointer am = dca->getAttributeMatrix({k_DataContainerName, k_AttributeMatrixName, ""});
+    Int32ArrayType& data = *(am->getAttributeArrayAs<Int32ArrayType>(k_DataArrayName));
+    FloatArrayType& mean = *(am->getAttributeArrayAs<FloatArrayType>(filter->getMeanArrayName()));
+    FloatArrayType& variance = *(am->getAttributeArrayAs<FloatArrayType>(filter->getVarianceArrayName()));
+    FloatArrayType& minimum = *(am->getAttributeArrayAs<FloatArrayType>(filter->getMinimumArrayName()));
+    FloatArrayType& maximum = *(am->getAttributeArrayAs<FloatArrayType>(filter->getMaximumArrayName()));
+
+    // Compare against a direct evaluation over the window clipped to the image
+    const int64_t dims[3] = {static_cast<int64_t>(k_Dims[0]), static_cast<int64_t>(k_Dims[1]), static_cast<int64_t>(k_Dims[2])};
+    for(int64_t z = 0; z < dims[2]; z++)
+    {
+      for(int64_t y = 0; y < dims[1]; y++)
+      {
+        for(int64_t x = 0; x < dims[0]; x++)
+        {
+          std::vector<double> values;
+          for(int64_t k = std::max<int64_t>(z - radius[2], 0); k <= std::min<int64_t>(z + radius[2], dims[2] - 1); k++)
+          {
+            for(int64_t j = std::max<int64_t>(y - radius[1], 0); j <= std::min<int64_t>(y + radius[1], dims[1] - 1); j++)
+            {
+              for(int64_t i = std::max<int64_t>(x - radius[0], 0); i <= std::min<int64_t>(x + radius[0], dims[0] - 1); i++)
+              {
+                values.push_back(static_cast<double>(data[(k * dims[1] + j) * dims[0] + i]));
+              }
+            }
+          }
+          double sum = 0.0;
+          for(double value : values)
+          {
+            sum += value;
+          }
+          double avg = sum / static_cast<double>(values.size());
+          double var = 0.0;
+          for(double value : values)
+          {
+            var += (value - avg) * (value - avg);
+          }
+          var /= static_cast<double>(values.size());
+
+          size_t index = static_cast<size_t>((z * dims[1] + y) * dims[0] + x);
+          DREAM3D_REQUIRE(std::abs(mean[index] - avg) < 1.0E-2)
+          DREAM3D_REQUIRE(std::abs(variance[index] - var) < 1.0E-3 * std::max(var, 1.0))
+          DREAM3D_REQUIRE_EQUAL(minimum[index], static_cast<float>(*std::min_element(values.begin(), values.end())))
+          DREAM3D_REQUIRE_EQUAL(maximum[index], static_cast<float>(*std::max_element(values.begin(), values.end())))
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestPreflight())
+    DREAM3D_REGISTER_TEST(TestWindowStatistics())
+  }
+
+private:
+};
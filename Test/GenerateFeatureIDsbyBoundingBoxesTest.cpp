@@ -3,6 +3,10 @@
 // -----------------------------------------------------------------------------
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QFile>
 
@@ -15,6 +19,9 @@
 #include "SIMPLib/Filtering/FilterManager.h"
 #include "SIMPLib/Filtering/FilterPipeline.h"
 #include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/EdgeGeom.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/VertexGeom.h"
 #include "SIMPLib/Plugin/ISIMPLibPlugin.h"
 #include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
 
@@ -26,6 +33,25 @@
 
 class GenerateFeatureIDsbyBoundingBoxesTest
 {
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_ElementAttributeMatrixName = {"ElementData"};
+  const QString k_BoxAttributeMatrixName = {"BoxData"};
+  const QString k_FeatureAttributeMatrixName = {"FeatureData"};
+  const QString k_FeatureIdsArrayName = {"FeatureIds"};
+  const QString k_BoxCenterArrayName = {"BoxCenter"};
+  const QString k_BoxDimensionsArrayName = {"BoxDimensions"};
+  const QString k_BoxFeatureIdsArrayName = {"BoxFeatureIds"};
+  const SizeVec3Type k_Dims = {9, 7, 5};
+  const size_t k_NumPoints = {300};
+
+  // Overlapping boxes given as center, dimensions and feature id; the third box lies inside the first and
+  // must never win, while the second box only claims the cells that the first does not contain
+  const std::vector<std::array<float, 7>> k_Boxes = {
+      {2.0f, 2.0f, 1.5f, 3.0f, 3.0f, 3.0f, 5},
+      {3.5f, 2.5f, 1.0f, 4.0f, 4.0f, 2.0f, 7},
+      {2.0f, 2.0f, 1.5f, 1.0f, 1.0f, 1.5f, 9},
+      {6.25f, 5.0f, 3.0f, 2.5f, 3.0f, 6.0f, 11},
+  };
 
 public:
   GenerateFeatureIDsbyBoundingBoxesTest() = default;
@@ -36,28 +62,270 @@ public:
   GenerateFeatureIDsbyBoundingBoxesTest& operator=(GenerateFeatureIDsbyBoundingBoxesTest&&) = delete;      // Move Assignment
 
   // -----------------------------------------------------------------------------
-  DataContainerArray::Pointer createDataStructure()
+  // Deterministic scattered positions covering the boxes and some space around them
+  // -----------------------------------------------------------------------------
+  std::array<float, 3> pointPosition(size_t index) const
+  {
+    std::array<float, 3> pos = {0.0f, 0.0f, 0.0f};
+    pos[0] = -0.5f + 9.0f * static_cast<float>((index * 37) % 101) / 101.0f;
+    pos[1] = -0.5f + 7.5f * static_cast<float>((index * 53) % 89) / 89.0f;
+    pos[2] = -0.5f + 6.5f * static_cast<float>((index * 71) % 97) / 97.0f;
+    return pos;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Reference result: the feature id of the first box that strictly contains the position, else 0
+  // -----------------------------------------------------------------------------
+  int32_t bruteForceFeatureId(float x, float y, float z) const
+  {
+    const float pos[3] = {x, y, z};
+    for(const std::array<float, 7>& box : k_Boxes)
+    {
+      bool inside = true;
+      for(size_t d = 0; d < 3; d++)
+      {
+        float minValue = box[d] - box[3 + d] / 2.0;
+        float maxValue = box[d] + box[3 + d] / 2.0;
+        inside = inside && pos[d] > minValue && pos[d] < maxValue;
+      }
+      if(inside)
+      {
+        return static_cast<int32_t>(box[6]);
+      }
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  void addBoxes(const DataContainer::Pointer& dc)
+  {
+    std::vector<size_t> tupleDims = {k_Boxes.size()};
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tupleDims, k_BoxAttributeMatrixName, AttributeMatrix::Type::Generic);
+    dc->addOrReplaceAttributeMatrix(am);
+
+    std::vector<size_t> cDims = {3};
+    FloatArrayType::Pointer centers = FloatArrayType::CreateArray(tupleDims, cDims, k_BoxCenterArrayName, true);
+    FloatArrayType::Pointer dimensions = FloatArrayType::CreateArray(tupleDims, cDims, k_BoxDimensionsArrayName, true);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(k_Boxes.size(), k_BoxFeatureIdsArrayName, true);
+    for(size_t k = 0; k < k_Boxes.size(); k++)
+    {
+      for(size_t d = 0; d < 3; d++)
+      {
+        centers->setComponent(k, d, k_Boxes[k][d]);
+        dimensions->setComponent(k, d, k_Boxes[k][3 + d]);
+      }
+      featureIds->setValue(k, static_cast<int32_t>(k_Boxes[k][6]));
+    }
+    am->addOrReplaceAttributeArray(centers);
+    am->addOrReplaceAttributeArray(dimensions);
+    am->addOrReplaceAttributeArray(featureIds);
+  }
+
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createImageDataStructure()
   {
     DataContainerArray::Pointer dca = DataContainerArray::New();
-    DataContainer::Pointer dc = DataContainer::New("Test");
-    AttributeMatrix::Pointer am = AttributeMatrix::New({100}, "AM", AttributeMatrix::Type::Cell);
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(k_Dims);
+    image->setSpacing(0.75f, 1.0f, 1.25f);
+    image->setOrigin(-0.25f, 0.0f, -0.5f);
+    dc->setGeometry(image);
 
+    std::vector<size_t> tupleDims = {k_Dims[0], k_Dims[1], k_Dims[2]};
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tupleDims, k_ElementAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(am);
+    addBoxes(dc);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createVertexDataStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
     dca->addOrReplaceDataContainer(dc);
+
+    VertexGeom::Pointer vertex = VertexGeom::CreateGeometry(static_cast<int64_t>(k_NumPoints), SIMPL::Geometry::VertexGeometry);
+    float* vertices = vertex->getVertexPointer(0);
+    for(size_t i = 0; i < k_NumPoints; i++)
+    {
+      std::array<float, 3> pos = pointPosition(i);
+      std::copy(pos.begin(), pos.end(), vertices + 3 * i);
+    }
+    dc->setGeometry(vertex);
+
+    std::vector<size_t> tupleDims = {k_NumPoints};
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tupleDims, k_ElementAttributeMatrixName, AttributeMatrix::Type::Vertex);
     dc->addOrReplaceAttributeMatrix(am);
+    addBoxes(dc);
+
     return dca;
   }
 
   // -----------------------------------------------------------------------------
-  int TestGenerateFeatureIDsbyBoundingBoxesTest()
+  DataContainerArray::Pointer createEdgeDataStructure(size_t numTuples)
   {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
 
-    DataContainerArray::Pointer dca = createDataStructure();
+    // Every edge joins two consecutive scattered points
+    SharedVertexList::Pointer vertices = EdgeGeom::CreateSharedVertexList(static_cast<int64_t>(k_NumPoints));
+    EdgeGeom::Pointer edge = EdgeGeom::CreateGeometry(static_cast<int64_t>(k_NumPoints - 1), vertices, SIMPL::Geometry::EdgeGeometry);
+    float* vertex = edge->getVertexPointer(0);
+    for(size_t i = 0; i < k_NumPoints; i++)
+    {
+      std::array<float, 3> pos = pointPosition(i);
+      std::copy(pos.begin(), pos.end(), vertex + 3 * i);
+    }
+    MeshIndexType* edges = edge->getEdgePointer(0);
+    for(size_t i = 0; i + 1 < k_NumPoints; i++)
+    {
+      edges[2 * i] = i;
+      edges[2 * i + 1] = i + 1;
+    }
+    dc->setGeometry(edge);
+
+    std::vector<size_t> tupleDims = {numTuples};
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tupleDims, k_ElementAttributeMatrixName, AttributeMatrix::Type::Edge);
+    dc->addOrReplaceAttributeMatrix(am);
+    addBoxes(dc);
 
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  GenerateFeatureIDsbyBoundingBoxes::Pointer createFilter(const DataContainerArray::Pointer& dca)
+  {
     GenerateFeatureIDsbyBoundingBoxes::Pointer filter = GenerateFeatureIDsbyBoundingBoxes::New();
     filter->setDataContainerArray(dca);
+    filter->setFeatureIDsArrayPath({k_DataContainerName, k_ElementAttributeMatrixName, k_FeatureIdsArrayName});
+    filter->setFeatureAttributeMatrixArrayPath({k_DataContainerName, k_FeatureAttributeMatrixName, ""});
+    filter->setBoxCenterArrayPath({k_DataContainerName, k_BoxAttributeMatrixName, k_BoxCenterArrayName});
+    filter->setBoxDimensionsArrayPath({k_DataContainerName, k_BoxAttributeMatrixName, k_BoxDimensionsArrayName});
+    filter->setBoxFeatureIDsArrayPath({k_DataContainerName, k_BoxAttributeMatrixName, k_BoxFeatureIdsArrayName});
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  Int32ArrayType::Pointer getFeatureIds(const DataContainerArray::Pointer& dca)
+  {
+    return dca->getAttributeMatrix({k_DataContainerName, k_ElementAttributeMatrixName, ""})->getAttributeArrayAs<Int32ArrayType>(k_FeatureIdsArrayName);
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestPreflight()
+  {
+    // An Edge Attribute Matrix whose tuple count differs from the number of edges
+    GenerateFeatureIDsbyBoundingBoxes::Pointer filter = createFilter(createEdgeDataStructure(k_NumPoints));
     filter->preflight();
     int32_t err = filter->getErrorCode();
-    DREAM3D_REQUIRE_EQUAL(err, -999)
+    DREAM3D_REQUIRED(err, ==, -5556)
+
+    // An Edge Attribute Matrix in a Data Container without an Edge Geometry
+    DataContainerArray::Pointer dca = createEdgeDataStructure(k_NumPoints - 1);
+    dca->getDataContainer(k_DataContainerName)->setGeometry(VertexGeom::CreateGeometry(static_cast<int64_t>(k_NumPoints), SIMPL::Geometry::VertexGeometry));
+    filter = createFilter(dca);
+    filter->preflight();
+    err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, <, 0)
+
+    filter = createFilter(createEdgeDataStructure(k_NumPoints - 1));
+    filter->preflight();
+    err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestImage()
+  {
+    DataContainerArray::Pointer dca = createImageDataStructure();
+    GenerateFeatureIDsbyBoundingBoxes::Pointer filter = createFilter(dca);
+    filter->execute();
+    int32_t err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    Int32ArrayType& featureIds = *getFeatureIds(dca);
+    ImageGeom::Pointer image = dca->getDataContainer(k_DataContainerName)->getGeometryAs<ImageGeom>();
+    FloatVec3Type spacing = image->getSpacing();
+    FloatVec3Type origin = image->getOrigin();
+
+    std::vector<size_t> counts(12, 0);
+    for(size_t z = 0; z < k_Dims[2]; z++)
+    {
+      for(size_t y = 0; y < k_Dims[1]; y++)
+      {
+        for(size_t x = 0; x < k_Dims[0]; x++)
+        {
+          float px = origin[0] + spacing[0] * static_cast<float>(x);
+          float py = origin[1] + spacing[1] * static_cast<float>(y);
+          float pz = origin[2] + spacing[2] * static_cast<float>(z);
+          int32_t featureId = featureIds[(z * k_Dims[1] + y) * k_Dims[0] + x];
+          DREAM3D_REQUIRE_EQUAL(featureId, bruteForceFeatureId(px, py, pz))
+          counts[featureId]++;
+        }
+      }
+    }
+    DREAM3D_REQUIRE(counts[5] > 0)
+    DREAM3D_REQUIRE(counts[7] > 0)
+    DREAM3D_REQUIRE_EQUAL(counts[9], 0)
+    DREAM3D_REQUIRE(counts[11] > 0)
+    DREAM3D_REQUIRE(counts[0] > 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestVertex()
+  {
+    DataContainerArray::Pointer dca = createVertexDataStructure();
+    GenerateFeatureIDsbyBoundingBoxes::Pointer filter = createFilter(dca);
+    filter->execute();
+    int32_t err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    Int32ArrayType& featureIds = *getFeatureIds(dca);
+    std::vector<size_t> counts(12, 0);
+    for(size_t i = 0; i < k_NumPoints; i++)
+    {
+      std::array<float, 3> pos = pointPosition(i);
+      DREAM3D_REQUIRE_EQUAL(featureIds[i], bruteForceFeatureId(pos[0], pos[1], pos[2]))
+      counts[featureIds[i]]++;
+    }
+    DREAM3D_REQUIRE(counts[5] > 0)
+    DREAM3D_REQUIRE(counts[7] > 0)
+    DREAM3D_REQUIRE_EQUAL(counts[9], 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestEdge()
+  {
+    DataContainerArray::Pointer dca = createEdgeDataStructure(k_NumPoints - 1);
+    GenerateFeatureIDsbyBoundingBoxes::Pointer filter = createFilter(dca);
+    filter->execute();
+    int32_t err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    Int32ArrayType& featureIds = *getFeatureIds(dca);
+    std::vector<size_t> counts(12, 0);
+    for(size_t i = 0; i + 1 < k_NumPoints; i++)
+    {
+      std::array<float, 3> p0 = pointPosition(i);
+      std::array<float, 3> p1 = pointPosition(i + 1);
+      int32_t expected = bruteForceFeatureId(0.5f * (p0[0] + p1[0]), 0.5f * (p0[1] + p1[1]), 0.5f * (p0[2] + p1[2]));
+      DREAM3D_REQUIRE_EQUAL(featureIds[i], expected)
+      counts[featureIds[i]]++;
+    }
+    DREAM3D_REQUIRE(counts[5] > 0)
+    DREAM3D_REQUIRE_EQUAL(counts[9], 0)
 
     return EXIT_SUCCESS;
   }
@@ -67,6 +335,9 @@ public:
   {
     int err = EXIT_SUCCESS;
 
-    DREAM3D_REGISTER_TEST(TestGenerateFeatureIDsbyBoundingBoxesTest())
+    DREAM3D_REGISTER_TEST(TestPreflight())
+    DREAM3D_REGISTER_TEST(TestImage())
+    DREAM3D_REGISTER_TEST(TestVertex())
+    DREAM3D_REGISTER_TEST(TestEdge())
   }
 };
@@ -3,6 +3,11 @@
 // -----------------------------------------------------------------------------
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QFile>
 
@@ -15,6 +20,8 @@
 #include "SIMPLib/Filtering/FilterManager.h"
 #include "SIMPLib/Filtering/FilterPipeline.h"
 #include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/VertexGeom.h"
 #include "SIMPLib/Plugin/ISIMPLibPlugin.h"
 #include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
 
@@ -26,6 +33,26 @@
 
 class GenerateMaskFromSimpleShapesTest
 {
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_ElementAttributeMatrixName = {"ElementData"};
+  const QString k_ShapeAttributeMatrixName = {"ShapeData"};
+  const QString k_MaskArrayName = {"Mask"};
+  const QString k_CentersArrayName = {"Centers"};
+  const QString k_AxisLengthsArrayName = {"AxisLengths"};
+  const QString k_BoxDimensionsArrayName = {"BoxDimensions"};
+  const QString k_RadiiArrayName = {"Radii"};
+  const QString k_HeightsArrayName = {"Heights"};
+  const SizeVec3Type k_Dims = {11, 9, 7};
+  const FloatVec3Type k_Spacing = {0.5f, 0.75f, 1.0f};
+  const FloatVec3Type k_Origin = {-1.0f, -0.5f, 0.25f};
+  const size_t k_NumPoints = {250};
+
+  // The third shape of every kind extends past the image bounds
+  const std::vector<float> k_Centers = {1.0f, 2.0f, 2.0f, 3.2f, 4.1f, 4.6f, 0.1f, 4.8f, 5.9f};
+  const std::vector<float> k_AxisLengths = {1.6f, 1.2f, 2.1f, 1.0f, 1.9f, 1.3f, 2.2f, 0.8f, 1.4f};
+  const std::vector<float> k_BoxDimensions = {2.5f, 1.5f, 3.0f, 1.2f, 2.6f, 1.6f, 3.5f, 1.9f, 2.4f};
+  const std::vector<float> k_Radii = {1.3f, 0.9f, 1.7f};
+  const std::vector<float> k_Heights = {2.5f, 3.1f, 1.8f};
 
 public:
   GenerateMaskFromSimpleShapesTest() = default;
@@ -36,27 +63,235 @@ public:
   GenerateMaskFromSimpleShapesTest& operator=(GenerateMaskFromSimpleShapesTest&&) = delete;      // Move Assignment
 
   // -----------------------------------------------------------------------------
-  DataContainerArray::Pointer createDataStructure()
+  // Deterministic scattered positions covering the image bounds
+  // -----------------------------------------------------------------------------
+  std::array<float, 3> pointPosition(size_t index) const
   {
-    DataContainerArray::Pointer dca = DataContainerArray::New();
-    DataContainer::Pointer dc = DataContainer::New("Test");
-    AttributeMatrix::Pointer am = AttributeMatrix::New({100}, "AM", AttributeMatrix::Type::Cell);
+    std::array<float, 3> pos = {0.0f, 0.0f, 0.0f};
+    pos[0] = -1.0f + 5.5f * static_cast<float>((index * 37) % 101) / 101.0f;
+    pos[1] = -0.5f + 6.75f * static_cast<float>((index * 53) % 89) / 89.0f;
+    pos[2] = 0.25f + 7.0f * static_cast<float>((index * 71) % 97) / 97.0f;
+    return pos;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Reference containment test of one shape, written out directly from the shape definitions
+  // -----------------------------------------------------------------------------
+  bool isInsideShape(int shape, size_t k, float x, float y, float z) const
+  {
+    const float* center = k_Centers.data() + 3 * k;
+    if(shape == 0)
+    {
+      const float* axes = k_AxisLengths.data() + 3 * k;
+      float dx = center[0] - x;
+      float dy = center[1] - y;
+      float dz = center[2] - z;
+      return (dx * dx / (axes[0] * axes[0]) + dy * dy / (axes[1] * axes[1]) + dz * dz / (axes[2] * axes[2])) < 1;
+    }
+    if(shape == 1)
+    {
+      const float pos[3] = {x, y, z};
+      const float* boxDims = k_BoxDimensions.data() + 3 * k;
+      bool inside = true;
+      for(size_t d = 0; d < 3; d++)
+      {
+        float minValue = center[d] - boxDims[d] / 2.0;
+        float maxValue = center[d] + boxDims[d] / 2.0;
+        inside = inside && pos[d] < maxValue && pos[d] > minValue;
+      }
+      return inside;
+    }
+    float zmin = center[2] - k_Heights[k] / 2.0;
+    float zmax = center[2] + k_Heights[k] / 2.0;
+    return (std::sqrt((center[0] - x) * (center[0] - x) + (center[1] - y) * (center[1] - y)) < k_Radii[k]) && (z < zmax) && (z > zmin);
+  }
+
+  // -----------------------------------------------------------------------------
+  bool isInsideAnyShape(int shape, float x, float y, float z) const
+  {
+    for(size_t k = 0; k < k_Radii.size(); k++)
+    {
+      if(isInsideShape(shape, k, x, y, z))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // -----------------------------------------------------------------------------
+  void addShapes(const DataContainer::Pointer& dc)
+  {
+    std::vector<size_t> tupleDims = {k_Radii.size()};
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tupleDims, k_ShapeAttributeMatrixName, AttributeMatrix::Type::Generic);
+    dc->addOrReplaceAttributeMatrix(am);
+
+    std::vector<size_t> cDims = {3};
+    FloatArrayType::Pointer centers = FloatArrayType::CreateArray(tupleDims, cDims, k_CentersArrayName, true);
+    FloatArrayType::Pointer axisLengths = FloatArrayType::CreateArray(tupleDims, cDims, k_AxisLengthsArrayName, true);
+    FloatArrayType::Pointer boxDimensions = FloatArrayType::CreateArray(tupleDims, cDims, k_BoxDimensionsArrayName, true);
+    FloatArrayType::Pointer radii = FloatArrayType::CreateArray(k_Radii.size(), k_RadiiArrayName, true);
+    FloatArrayType::Pointer heights = FloatArrayType::CreateArray(k_Heights.size(), k_HeightsArrayName, true);
+    std::copy(k_Centers.begin(), k_Centers.end(), centers->getPointer(0));
+    std::copy(k_AxisLengths.begin(), k_AxisLengths.end(), axisLengths->getPointer(0));
+    std::copy(k_BoxDimensions.begin(), k_BoxDimensions.end(), boxDimensions->getPointer(0));
+    std::copy(k_Radii.begin(), k_Radii.end(), radii->getPointer(0));
+    std::copy(k_Heights.begin(), k_Heights.end(), heights->getPointer(0));
+    am->addOrReplaceAttributeArray(centers);
+    am->addOrReplaceAttributeArray(axisLengths);
+    am->addOrReplaceAttributeArray(boxDimensions);
+    am->addOrReplaceAttributeArray(radii);
+    am->addOrReplaceAttributeArray(heights);
+  }
 
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createImageDataStructure(AttributeMatrix::Type attrMatType)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
     dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(k_Dims);
+    image->setSpacing(k_Spacing);
+    image->setOrigin(k_Origin);
+    dc->setGeometry(image);
+
+    std::vector<size_t> tupleDims = {k_Dims[0], k_Dims[1], k_Dims[2]};
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tupleDims, k_ElementAttributeMatrixName, attrMatType);
     dc->addOrReplaceAttributeMatrix(am);
+    addShapes(dc);
+
     return dca;
   }
 
   // -----------------------------------------------------------------------------
-  int TestGenerateMaskFromSimpleShapesTest()
+  DataContainerArray::Pointer createVertexDataStructure()
   {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    VertexGeom::Pointer vertex = VertexGeom::CreateGeometry(static_cast<int64_t>(k_NumPoints), SIMPL::Geometry::VertexGeometry);
+    float* vertices = vertex->getVertexPointer(0);
+    for(size_t i = 0; i < k_NumPoints; i++)
+    {
+      std::array<float, 3> pos = pointPosition(i);
+      std::copy(pos.begin(), pos.end(), vertices + 3 * i);
+    }
+    dc->setGeometry(vertex);
+
+    std::vector<size_t> tupleDims = {k_NumPoints};
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tupleDims, k_ElementAttributeMatrixName, AttributeMatrix::Type::Vertex);
+    dc->addOrReplaceAttributeMatrix(am);
+    addShapes(dc);
+
+    return dca;
+  }
 
-    DataContainerArray::Pointer dca = createDataStructure();
+  // -----------------------------------------------------------------------------
+  GenerateMaskFromSimpleShapes::Pointer createFilter(const DataContainerArray::Pointer& dca, int shape)
+  {
     GenerateMaskFromSimpleShapes::Pointer filter = GenerateMaskFromSimpleShapes::New();
     filter->setDataContainerArray(dca);
+    filter->setMaskShape(shape);
+    filter->setMaskArrayPath({k_DataContainerName, k_ElementAttributeMatrixName, k_MaskArrayName});
+    filter->setCentersArrayPath({k_DataContainerName, k_ShapeAttributeMatrixName, k_CentersArrayName});
+    filter->setAxesLengthArrayPath({k_DataContainerName, k_ShapeAttributeMatrixName, k_AxisLengthsArrayName});
+    filter->setBoxDimensionsArrayPath({k_DataContainerName, k_ShapeAttributeMatrixName, k_BoxDimensionsArrayName});
+    filter->setCylinderRadiusArrayPath({k_DataContainerName, k_ShapeAttributeMatrixName, k_RadiiArrayName});
+    filter->setCylinderHeightArrayPath({k_DataContainerName, k_ShapeAttributeMatrixName, k_HeightsArrayName});
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  BoolArrayType::Pointer getMask(const DataContainerArray::Pointer& dca)
+  {
+    return dca->getAttributeMatrix({k_DataContainerName, k_ElementAttributeMatrixName, ""})->getAttributeArrayAs<BoolArrayType>(k_MaskArrayName);
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestPreflight()
+  {
+    GenerateMaskFromSimpleShapes::Pointer filter = createFilter(createImageDataStructure(AttributeMatrix::Type::Face), 1);
     filter->preflight();
     int32_t err = filter->getErrorCode();
-    DREAM3D_REQUIRE_EQUAL(err, -999)
+    DREAM3D_REQUIRED(err, ==, -5555)
+
+    for(int shape = 0; shape < 3; shape++)
+    {
+      filter = createFilter(createImageDataStructure(AttributeMatrix::Type::Cell), shape);
+      filter->preflight();
+      err = filter->getErrorCode();
+      DREAM3D_REQUIRED(err, >=, 0)
+
+      filter = createFilter(createVertexDataStructure(), shape);
+      filter->preflight();
+      err = filter->getErrorCode();
+      DREAM3D_REQUIRED(err, >=, 0)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestImageMask()
+  {
+    for(int shape = 0; shape < 3; shape++)
+    {
+      DataContainerArray::Pointer dca = createImageDataStructure(AttributeMatrix::Type::Cell);
+      GenerateMaskFromSimpleShapes::Pointer filter = createFilter(dca, shape);
+      filter->execute();
+      int32_t err = filter->getErrorCode();
+      DREAM3D_REQUIRED(err, >=, 0)
+
+      BoolArrayType& mask = *getMask(dca);
+      size_t numInside = 0;
+      for(size_t z = 0; z < k_Dims[2]; z++)
+      {
+        for(size_t y = 0; y < k_Dims[1]; y++)
+        {
+          for(size_t x = 0; x < k_Dims[0]; x++)
+          {
+            float px = k_Origin[0] + k_Spacing[0] * static_cast<float>(x);
+            float py = k_Origin[1] + k_Spacing[1] * static_cast<float>(y);
+            float pz = k_Origin[2] + k_Spacing[2] * static_cast<float>(z);
+            bool expected = isInsideAnyShape(shape, px, py, pz);
+            DREAM3D_REQUIRE_EQUAL(mask[(z * k_Dims[1] + y) * k_Dims[0] + x], expected)
+            numInside += expected ? 1 : 0;
+          }
+        }
+      }
+      DREAM3D_REQUIRE(numInside > 0)
+      DREAM3D_REQUIRE(numInside < mask.getNumberOfTuples())
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestVertexMask()
+  {
+    for(int shape = 0; shape < 3; shape++)
+    {
+      DataContainerArray::Pointer dca = createVertexDataStructure();
+      GenerateMaskFromSimpleShapes::Pointer filter = createFilter(dca, shape);
+      filter->execute();
+      int32_t err = filter->getErrorCode();
+      DREAM3D_REQUIRED(err, >=, 0)
+
+      BoolArrayType& mask = *getMask(dca);
+      size_t numInside = 0;
+      for(size_t i = 0; i < k_NumPoints; i++)
+      {
+        std::array<float, 3> pos = pointPosition(i);
+        bool expected = isInsideAnyShape(shape, pos[0], pos[1], pos[2]);
+        DREAM3D_REQUIRE_EQUAL(mask[i], expected)
+        numInside += expected ? 1 : 0;
+      }
+      DREAM3D_REQUIRE(numInside > 0)
+      DREAM3D_REQUIRE(numInside < k_NumPoints)
+    }
 
     return EXIT_SUCCESS;
   }
@@ -66,6 +301,8 @@ public:
   {
     int err = EXIT_SUCCESS;
 
-    DREAM3D_REGISTER_TEST(TestGenerateMaskFromSimpleShapesTest())
+    DREAM3D_REGISTER_TEST(TestPreflight())
+    DREAM3D_REGISTER_TEST(TestImageMask())
+    DREAM3D_REGISTER_TEST(TestVertexMask())
   }
 };
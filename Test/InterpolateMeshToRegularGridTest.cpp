@@ -0,0 +1,238 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/QuadGeom.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReviewTestFileLocations.h"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/InterpolateMeshToRegularGrid.h"
+
+class InterpolateMeshToRegularGridTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_FaceAttributeMatrixName = {"FaceData"};
+  const QString k_IdsArrayName = {"Ids"};
+  const QString k_InterpolatedDataContainerName = {"InterpolatedDataContainer"};
+  const QString k_InterpolatedAttributeMatrixName = {"InterpolatedData"};
+  const int32_t k_OutsideMeshIdentifier = {-1};
+  const int32_t k_GridDimension = {23};
+  const size_t k_MeshDimension = {10};
+
+public:
+  InterpolateMeshToRegularGridTest() = default;
+  ~InterpolateMeshToRegularGridTest() = default;
+  InterpolateMeshToRegularGridTest(const InterpolateMeshToRegularGridTest&) = delete;            // Copy Constructor
+  InterpolateMeshToRegularGridTest(InterpolateMeshToRegularGridTest&&) = delete;                 // Move Constructor
+  InterpolateMeshToRegularGridTest& operator=(const InterpolateMeshToRegularGridTest&) = delete; // Copy Assignment
+  InterpolateMeshToRegularGridTest& operator=(InterpolateMeshToRegularGridTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  // Unit squares of a 10 x 10 lattice that are part of the mesh: one outer loop over x in [0, 4) with a
+  // hole over [1, 3) x [4, 6), and a second, disjoint outer loop over [6, 10) x [2, 8)
+  // -----------------------------------------------------------------------------
+  bool isMeshSquare(size_t i, size_t j) const
+  {
+    bool leftLoop = i < 4 && !(i >= 1 && i < 3 && j >= 4 && j < 6);
+    bool rightLoop = i >= 6 && j >= 2 && j < 8;
+    return leftLoop || rightLoop;
+  }
+
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    size_t numQuads = 0;
+    for(size_t j = 0; j < k_MeshDimension; j++)
+    {
+      for(size_t i = 0; i < k_MeshDimension; i++)
+      {
+        numQuads += isMeshSquare(i, j) ? 1 : 0;
+      }
+    }
+
+    // The lattice vertices are shared between neighboring quads, so the unshared edges trace the loops
+    const size_t vertsPerRow = k_MeshDimension + 1;
+    SharedVertexList::Pointer vertices = QuadGeom::CreateSharedVertexList(vertsPerRow * vertsPerRow);
+    QuadGeom::Pointer quads = QuadGeom::CreateGeometry(numQuads, vertices, SIMPL::Geometry::QuadGeometry);
+    float* vertex = quads->getVertexPointer(0);
+    for(size_t j = 0; j < vertsPerRow; j++)
+    {
+      for(size_t i = 0; i < vertsPerRow; i++)
+      {
+        vertex[3 * (j * vertsPerRow + i) + 0] = static_cast<float>(i);
+        vertex[3 * (j * vertsPerRow + i) + 1] = static_cast<float>(j);
+        vertex[3 * (j * vertsPerRow + i) + 2] = 0.0f;
+      }
+    }
+
+    std::vector<size_t> tupleDims = {numQuads};
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tupleDims, k_FaceAttributeMatrixName, AttributeMatrix::Type::Face);
+    dc->addOrReplaceAttributeMatrix(am);
+    Int32ArrayType::Pointer ids = Int32ArrayType::CreateArray(numQuads, k_IdsArrayName, true);
+    am->addOrReplaceAttributeArray(ids);
+
+    size_t* quad = quads->getQuadPointer(0);
+    size_t q = 0;
+    for(size_t j = 0; j < k_MeshDimension; j++)
+    {
+      for(size_t i = 0; i < k_MeshDimension; i++)
+      {
+        if(isMeshSquare(i, j))
+        {
+          quad[4 * q + 0] = j * vertsPerRow + i;
+          quad[4 * q + 1] = j * vertsPerRow + i + 1;
+          quad[4 * q + 2] = (j + 1) * vertsPerRow + i + 1;
+          quad[4 * q + 3] = (j + 1) * vertsPerRow + i;
+          ids->setValue(q, static_cast<int32_t>(100 + q));
+          q++;
+        }
+      }
+    }
+    dc->setGeometry(quads);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  InterpolateMeshToRegularGrid::Pointer createFilter(const DataContainerArray::Pointer& dca)
+  {
+    InterpolateMeshToRegularGrid::Pointer filter = InterpolateMeshToRegularGrid::New();
+    filter->setDataContainerArray(dca);
+    filter->setSelectedDataContainerName(k_DataContainerName);
+    filter->setInterpolatedDataContainerName(k_InterpolatedDataContainerName);
+    filter->setInterpolatedAttributeMatrixName(k_InterpolatedAttributeMatrixName);
+    filter->setScaleOrSpecifyNumCells(0);
+    filter->setSetXDimension(k_GridDimension);
+    filter->setSetYDimension(k_GridDimension);
+    filter->setOutsideMeshIdentifier(k_OutsideMeshIdentifier);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestPreflight()
+  {
+    InterpolateMeshToRegularGrid::Pointer filter = createFilter(createDataStructure());
+    filter->setScaleFactorNumCells(0);
+    filter->preflight();
+    int32_t err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, ==, -11004)
+
+    filter = createFilter(createDataStructure());
+    filter->preflight();
+    err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestInsideMeshFill()
+  {
+    DataContainerArray::Pointer dca = createDataStructure();
+    InterpolateMeshToRegularGrid::Pointer filter = createFilter(dca);
+    filter->execute();
+    int32_t err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    DataContainer::Pointer dc = dca->getDataContainer(k_DataContainerName);
+    QuadGeom::Pointer quads = dc->getGeometryAs<QuadGeom>();
+    FloatArrayType::Pointer centroidsPtr = quads->getElementCentroids();
+    DREAM3D_REQUIRE(centroidsPtr.get() != nullptr)
+    FloatArrayType& centroids = *centroidsPtr;
+    Int32ArrayType& ids = *(dc->getAttributeMatrix(k_FaceAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(k_IdsArrayName));
+
+    DataContainer::Pointer interpolatedDC = dca->getDataContainer(k_InterpolatedDataContainerName);
+    ImageGeom::Pointer image = interpolatedDC->getGeometryAs<ImageGeom>();
+    SizeVec3Type dims = image->getDimensions();
+    DREAM3D_REQUIRE_EQUAL(dims[0], static_cast<size_t>(k_GridDimension))
+    DREAM3D_REQUIRE_EQUAL(dims[1], static_cast<size_t>(k_GridDimension))
+    DREAM3D_REQUIRE_EQUAL(dims[2], static_cast<size_t>(1))
+    FloatVec3Type spacing = image->getSpacing();
+    FloatVec3Type origin = image->getOrigin();
+    Int32ArrayType& interpolatedIds = *(interpolatedDC->getAttributeMatrix(k_InterpolatedAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(k_IdsArrayName));
+
+    // A grid point is inside the mesh when the lattice square containing it is a mesh quad; the grid
+    // spacing of 10 / 23 keeps every grid point off the lattice lines except along x = 0 and y = 0
+    size_t numInside = 0;
+    size_t numInHole = 0;
+    for(size_t y = 0; y < dims[1]; y++)
+    {
+      for(size_t x = 0; x < dims[0]; x++)
+      {
+        float pos[3] = {static_cast<float>(x) * spacing[0] + origin[0], static_cast<float>(y) * spacing[1] + origin[1], origin[2]};
+        size_t i = static_cast<size_t>(std::floor(pos[0]));
+        size_t j = static_cast<size_t>(std::floor(pos[1]));
+        size_t index = y * dims[0] + x;
+
+        if(!isMeshSquare(i, j))
+        {
+          numInHole += (i >= 1 && i < 3 && j >= 4 && j < 6) ? 1 : 0;
+          DREAM3D_REQUIRE_EQUAL(interpolatedIds[index], k_OutsideMeshIdentifier)
+          continue;
+        }
+        numInside++;
+
+        // Brute force nearest element centroid
+        size_t nearest = 0;
+        float minDist = std::numeric_limits<float>::max();
+        for(size_t e = 0; e < quads->getNumberOfQuads(); e++)
+        {
+          float dist = 0.0f;
+          for(size_t d = 0; d < 3; d++)
+          {
+            dist += (centroids[3 * e + d] - pos[d]) * (centroids[3 * e + d] - pos[d]);
+          }
+          if(dist < minDist)
+          {
+            minDist = dist;
+            nearest = e;
+          }
+        }
+        DREAM3D_REQUIRE_EQUAL(interpolatedIds[index], ids[nearest])
+      }
+    }
+    DREAM3D_REQUIRE(numInside > 0)
+    DREAM3D_REQUIRE(numInHole > 0)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestPreflight())
+    DREAM3D_REGISTER_TEST(TestInsideMeshFill())
+  }
+
+private:
+};
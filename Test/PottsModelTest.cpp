@@ -0,0 +1,189 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReviewTestFileLocations.h"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/util/CounterRng.hpp"
+#include "DREAM3DReview/DREAM3DReviewFilters/util/SpinLattice.hpp"
+
+class PottsModelTest
+{
+  const uint64_t k_Seed = {0x5EEDu};
+  const size_t k_Sweeps = {6};
+  // kT of half a bond, so that uphill flips are accepted part of the time
+  const double k_Temperature = {0.5 / SpinLattice::k_Boltzmann};
+
+public:
+  PottsModelTest() = default;
+  ~PottsModelTest() = default;
+  PottsModelTest(const PottsModelTest&) = delete;            // Copy Constructor
+  PottsModelTest(PottsModelTest&&) = delete;                 // Move Constructor
+  PottsModelTest& operator=(const PottsModelTest&) = delete; // Copy Assignment
+  PottsModelTest& operator=(PottsModelTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  // Random spins in [1, 4] with a few sites of Feature Id 0, and a mask that excludes a few other sites
+  // -----------------------------------------------------------------------------
+  void createSpins(size_t numSites, std::vector<int32_t>& fIds, BoolArrayType& mask) const
+  {
+    CounterRng rng(k_Seed);
+    fIds.resize(numSites);
+    for(size_t i = 0; i < numSites; i++)
+    {
+      fIds[i] = rng.uniformIndex(20) == 0 ? 0 : static_cast<int32_t>(1 + rng.uniformIndex(4));
+      mask[i] = rng.uniformIndex(10) != 0;
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Number of neighbors of an active site whose spin differs from its own, counted directly from the spins
+  // -----------------------------------------------------------------------------
+  size_t countUnlikeNeighbors(const SizeVec3Type& dims, bool periodic, const int32_t* fIds, const bool* mask, size_t x, size_t y, size_t z) const
+  {
+    int32_t spin = fIds[(z * dims[1] + y) * dims[0] + x];
+    int64_t zRange = dims[2] > 1 ? 1 : 0;
+    size_t unlike = 0;
+    for(int64_t dz = -zRange; dz <= zRange; dz++)
+    {
+      for(int64_t dy = -1; dy <= 1; dy++)
+      {
+        for(int64_t dx = -1; dx <= 1; dx++)
+        {
+          if(dx == 0 && dy == 0 && dz == 0)
+          {
+            continue;
+          }
+          int64_t coords[3] = {static_cast<int64_t>(x) + dx, static_cast<int64_t>(y) + dy, static_cast<int64_t>(z) + dz};
+          bool outside = false;
+          for(size_t d = 0; d < 3; d++)
+          {
+            int64_t dim = static_cast<int64_t>(dims[d]);
+            if(periodic)
+            {
+              coords[d] = (coords[d] + dim) % dim;
+            }
+            outside = outside || coords[d] < 0 || coords[d] >= dim;
+          }
+          if(outside)
+          {
+            continue;
+          }
+          size_t neigh = static_cast<size_t>((coords[2] * static_cast<int64_t>(dims[1]) + coords[1]) * static_cast<int64_t>(dims[0]) + coords[0]);
+          if(mask != nullptr && !mask[neigh])
+          {
+            continue;
+          }
+          unlike += fIds[neigh] != spin ? 1 : 0;
+        }
+      }
+    }
+    return unlike;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs the same seeded lattice with the full and the kinetic sweep, which must give identical spins, and checks
+  // the cached unlike neighbor counts of the kinetic lattice against a recount from its final spins
+  // -----------------------------------------------------------------------------
+  int runLattice(const SizeVec3Type& dims, bool periodic, bool useMask)
+  {
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(dims);
+    size_t numSites = dims[0] * dims[1] * dims[2];
+
+    std::vector<int32_t> initialSpins;
+    BoolArrayType::Pointer maskPtr = BoolArrayType::CreateArray(numSites, "Mask", true);
+    createSpins(numSites, initialSpins, *maskPtr);
+    bool* mask = useMask ? maskPtr->getPointer(0) : nullptr;
+
+    std::vector<int32_t> fullSpins = initialSpins;
+    SpinLattice fullLattice(image, k_Temperature, periodic, false, fullSpins.data(), mask, k_Seed);
+    std::vector<int32_t> kineticSpins = initialSpins;
+    SpinLattice kineticLattice(image, k_Temperature, periodic, true, kineticSpins.data(), mask, k_Seed);
+    for(size_t sweep = 0; sweep < k_Sweeps; sweep++)
+    {
+      size_t fullFlips = fullLattice.sweep();
+      size_t kineticFlips = kineticLattice.sweep();
+      DREAM3D_REQUIRE_EQUAL(fullFlips, kineticFlips)
+    }
+    DREAM3D_REQUIRE(fullLattice.total_flips() > 0)
+
+    for(size_t i = 0; i < numSites; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(fullSpins[i], kineticSpins[i])
+      if(initialSpins[i] == 0 || (mask != nullptr && !mask[i]))
+      {
+        DREAM3D_REQUIRE_EQUAL(fullSpins[i], initialSpins[i])
+      }
+    }
+
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          size_t index = (z * dims[1] + y) * dims[0] + x;
+          if(kineticSpins[index] == 0 || (mask != nullptr && !mask[index]))
+          {
+            continue;
+          }
+          size_t unlike = countUnlikeNeighbors(dims, periodic, kineticSpins.data(), mask, x, y, z);
+          DREAM3D_REQUIRE_EQUAL(kineticLattice.unlike_count(index), unlike)
+          if(unlike > 0)
+          {
+            DREAM3D_REQUIRE(kineticLattice.queued(index))
+          }
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestKineticMode3D()
+  {
+    int err = runLattice(SizeVec3Type(12, 10, 8), false, false);
+    DREAM3D_REQUIRED(err, ==, EXIT_SUCCESS)
+    // An odd periodic axis needs a third color class
+    err = runLattice(SizeVec3Type(9, 8, 7), true, true);
+    DREAM3D_REQUIRED(err, ==, EXIT_SUCCESS)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestKineticMode2D()
+  {
+    int err = runLattice(SizeVec3Type(16, 13, 1), false, true);
+    DREAM3D_REQUIRED(err, ==, EXIT_SUCCESS)
+    err = runLattice(SizeVec3Type(15, 11, 1), true, false);
+    DREAM3D_REQUIRED(err, ==, EXIT_SUCCESS)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestKineticMode3D())
+    DREAM3D_REGISTER_TEST(TestKineticMode2D())
+  }
+
+private:
+};
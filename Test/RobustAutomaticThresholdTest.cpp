@@ -0,0 +1,199 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "DREAM3DReview/DREAM3DReviewFilters/RobustAutomaticThreshold.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "DREAM3DReviewTestFileLocations.h"
+
+class RobustAutomaticThresholdTest
+{
+  const QString k_DataContainerName = {"DataContainer"};
+  const QString k_CellAttributeMatrixName = {"CellData"};
+  const QString k_FeatureAttributeMatrixName = {"FeatureData"};
+  const QString k_DataArrayName = {"Data"};
+  const QString k_GradientMagnitudeArrayName = {"GradientMagnitude"};
+  const QString k_MaskArrayName = {"Mask"};
+  const SizeVec3Type k_Dims = {4, 3, 1};
+  // Unequal spacings, so that a gradient which ignores or swaps them gives a different threshold
+  const FloatVec3Type k_Spacing = {0.5f, 2.0f, 1.0f};
+  const size_t k_NumFeatures = {5};
+
+  // High values in the first two rows above a low last row, with x running fastest
+  const std::vector<float> k_Values = {5.0f, 8.0f, 4.0f, 5.0f, 9.0f, 2.0f, 0.0f, 9.0f, 1.0f, 0.0f, 1.0f, 2.0f};
+  // Weights 1 on the 8 and 1 on the 0, so the weighted mean is (8 + 0) / 2 = 4
+  const std::vector<float> k_GradientMagnitudes = {0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  const float k_ArrayThreshold = {4.0f};
+  // Weighted means of the values by the central difference gradient magnitudes, which are
+  // sqrt(40), sqrt(10), sqrt(13), sqrt(8), sqrt(197), sqrt(85), sqrt(49.5625), sqrt(324.5625),
+  // sqrt(20), 1, sqrt(4.25) and sqrt(16.25), one sided at the border and divided by the spacing
+  const float k_CentralDifferencesThreshold = {5.369401f};
+  // The same weighted mean with the Sobel gradient magnitudes, divided by 16 * span * spacing
+  const float k_SobelThreshold = {4.479598f};
+
+public:
+  RobustAutomaticThresholdTest() = default;
+  ~RobustAutomaticThresholdTest() = default;
+  RobustAutomaticThresholdTest(const RobustAutomaticThresholdTest&) = delete;            // Copy Constructor
+  RobustAutomaticThresholdTest(RobustAutomaticThresholdTest&&) = delete;                 // Move Constructor
+  RobustAutomaticThresholdTest& operator=(const RobustAutomaticThresholdTest&) = delete; // Copy Assignment
+  RobustAutomaticThresholdTest& operator=(RobustAutomaticThresholdTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createDataStructure()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(k_Dims);
+    image->setSpacing(k_Spacing);
+    dc->setGeometry(image);
+
+    std::vector<size_t> tupleDims = {k_Dims[0], k_Dims[1], k_Dims[2]};
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tupleDims, k_CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAttrMat);
+
+    FloatArrayType::Pointer data = FloatArrayType::CreateArray(k_Values.size(), k_DataArrayName, true);
+    FloatArrayType::Pointer gradMag = FloatArrayType::CreateArray(k_GradientMagnitudes.size(), k_GradientMagnitudeArrayName, true);
+    std::copy(k_Values.begin(), k_Values.end(), data->getPointer(0));
+    std::copy(k_GradientMagnitudes.begin(), k_GradientMagnitudes.end(), gradMag->getPointer(0));
+    cellAttrMat->addOrReplaceAttributeArray(data);
+    cellAttrMat->addOrReplaceAttributeArray(gradMag);
+
+    // An array with one value per Feature rather than one per Cell
+    std::vector<size_t> featureDims = {k_NumFeatures};
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(featureDims, k_FeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAttrMat);
+    FloatArrayType::Pointer featureData = FloatArrayType::CreateArray(k_NumFeatures, k_DataArrayName, true);
+    std::copy(k_Values.begin(), k_Values.begin() + k_NumFeatures, featureData->getPointer(0));
+    featureAttrMat->addOrReplaceAttributeArray(featureData);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  RobustAutomaticThreshold::Pointer createFilter(const DataContainerArray::Pointer& dca, const QString& attrMatName, int32_t gradientMethod)
+  {
+    RobustAutomaticThreshold::Pointer filter = RobustAutomaticThreshold::New();
+    filter->setDataContainerArray(dca);
+    filter->setGradientMethod(gradientMethod);
+    filter->setInputArrayPath({k_DataContainerName, attrMatName, k_DataArrayName});
+    filter->setGradientMagnitudeArrayPath({k_DataContainerName, k_CellAttributeMatrixName, k_GradientMagnitudeArrayName});
+    filter->setFeatureIdsArrayPath({k_DataContainerName, attrMatName, k_MaskArrayName});
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Thresholds the Cell values with the given gradient source and checks the mask against the expected threshold
+  // -----------------------------------------------------------------------------
+  int runThreshold(int32_t gradientMethod, float threshold, size_t numAbove)
+  {
+    DataContainerArray::Pointer dca = createDataStructure();
+    RobustAutomaticThreshold::Pointer filter = createFilter(dca, k_CellAttributeMatrixName, gradientMethod);
+    filter->execute();
+    int32_t err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, >=, 0)
+
+    BoolArrayType::Pointer maskPtr = dca->getAttributeMatrix({k_DataContainerName, k_CellAttributeMatrixName, ""})->getAttributeArrayAs<BoolArrayType>(k_MaskArrayName);
+    DREAM3D_REQUIRE_VALID_POINTER(maskPtr.get())
+    BoolArrayType& mask = *maskPtr;
+    size_t count = 0;
+    for(size_t i = 0; i < k_Values.size(); i++)
+    {
+      bool expected = k_Values[i] >= threshold;
+      DREAM3D_REQUIRE_EQUAL(mask[i], expected)
+      count += expected ? 1 : 0;
+    }
+    DREAM3D_REQUIRE_EQUAL(count, numAbove)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestPreflight()
+  {
+    for(int32_t gradientMethod = 0; gradientMethod < 3; gradientMethod++)
+    {
+      RobustAutomaticThreshold::Pointer filter = createFilter(createDataStructure(), k_CellAttributeMatrixName, gradientMethod);
+      filter->preflight();
+      int32_t err = filter->getErrorCode();
+      DREAM3D_REQUIRED(err, >=, 0)
+    }
+
+    RobustAutomaticThreshold::Pointer filter = createFilter(createDataStructure(), k_CellAttributeMatrixName, 3);
+    filter->preflight();
+    int32_t err = filter->getErrorCode();
+    DREAM3D_REQUIRED(err, ==, -11002)
+
+    // The computed gradients need one value per Cell
+    for(int32_t gradientMethod = 1; gradientMethod < 3; gradientMethod++)
+    {
+      filter = createFilter(createDataStructure(), k_FeatureAttributeMatrixName, gradientMethod);
+      filter->preflight();
+      err = filter->getErrorCode();
+      DREAM3D_REQUIRED(err, ==, -11003)
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestGradientArray()
+  {
+    // The 4 is kept here, unlike with either computed gradient
+    int err = runThreshold(0, k_ArrayThreshold, 6);
+    DREAM3D_REQUIRED(err, ==, EXIT_SUCCESS)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestCentralDifferences()
+  {
+    // Without the border clamping the threshold drops to 4.553, without the spacing to 4.582 and with the x and y
+    // spacings swapped to 3.884, each of which also keeps the 5s
+    int err = runThreshold(1, k_CentralDifferencesThreshold, 3);
+    DREAM3D_REQUIRED(err, ==, EXIT_SUCCESS)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestSobel()
+  {
+    // Without the border clamping the threshold drops to 3.980, without the spacing to 3.876 and with the x and y
+    // spacings swapped to 3.367, each of which also keeps the 4
+    int err = runThreshold(2, k_SobelThreshold, 5);
+    DREAM3D_REQUIRED(err, ==, EXIT_SUCCESS)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestPreflight())
+    DREAM3D_REGISTER_TEST(TestGradientArray())
+    DREAM3D_REGISTER_TEST(TestCentralDifferences())
+    DREAM3D_REGISTER_TEST(TestSobel())
+  }
+};